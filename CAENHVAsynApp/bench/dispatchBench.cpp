@@ -0,0 +1,141 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : dispatchBench.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Microbenchmark of the asyn parameter dispatch. It compares the lookup of
+ * the object associated to an asyn parameter, done by searching the lists of
+ * each type of parameter in sequence, with the lookup done on the handler
+ * table indexed by asyn parameter index.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <random>
+#include <stdlib.h>
+
+#include "param_handler.h"
+
+// Dummy parameter object
+struct Param
+{
+    int value;
+};
+
+// Number of lists searched, in order, by the list based dispatch. It is the
+// number of parameter types handled by the driver.
+static const std::size_t numLists = 11;
+
+int main(int argc, char **argv)
+{
+    // Crate size: number of boards, channels per board, and parameters per channel
+    std::size_t numBoards   = ( argc > 1 ) ? strtoul(argv[1], NULL, 0) : 16;
+    std::size_t numChannels = ( argc > 2 ) ? strtoul(argv[2], NULL, 0) : 24;
+    std::size_t numParams   = ( argc > 3 ) ? strtoul(argv[3], NULL, 0) : 10;
+    std::size_t numLookups  = ( argc > 4 ) ? strtoul(argv[4], NULL, 0) : 10000000;
+
+    std::size_t numReasons( numBoards * numChannels * numParams );
+
+    std::cout << "Asyn parameter dispatch benchmark" << std::endl;
+    std::cout << "=================================" << std::endl;
+    std::cout << "Number of asyn parameters : " << numReasons << std::endl;
+    std::cout << "Number of lookups         : " << numLookups << std::endl;
+
+    // Parameter objects, and their names
+    std::vector<Param>       params(numReasons);
+    std::vector<std::string> names(numReasons);
+
+    // List based dispatch. Parameters are spread over the lists by type, as in the driver.
+    std::vector< std::map<int, Param*> > lists(numLists);
+
+    // Table based dispatch
+    ParamHandlerTable table;
+
+    for (std::size_t i(0); i < numReasons; ++i)
+    {
+        std::stringstream temp;
+        temp << "S" << std::setfill('0') << std::setw(2) << i / ( numChannels * numParams );
+        temp << "_C" << std::setfill('0') << std::setw(2) << ( i / numParams ) % numChannels;
+        temp << "_PARAM" << i % numParams;
+        names.at(i) = temp.str();
+
+        params.at(i).value = i;
+
+        lists.at(i % numLists).insert( std::make_pair(i, &params.at(i)) );
+
+        ParamHandler h;
+        h.kind    = static_cast<paramHandlerKind_t>( 1 + i % numLists );
+        h.slot    = i / ( numChannels * numParams );
+        h.channel = ( i / numParams ) % numChannels;
+        h.polled  = true;
+        h.object  = &params.at(i);
+        table.set(i, h);
+    }
+
+    // Random sequence of asyn parameter indexes
+    std::vector<int>                   reasons(numLookups);
+    std::mt19937                       gen(12345);
+    std::uniform_int_distribution<int> dist(0, numReasons - 1);
+    for (std::vector<int>::iterator it = reasons.begin(); it != reasons.end(); ++it)
+        *it = dist(gen);
+
+    // List based dispatch. The parameter name is copied on each call, as the
+    // name was looked up before dispatching.
+    long long sum(0);
+    std::chrono::steady_clock::time_point start( std::chrono::steady_clock::now() );
+    for (std::vector<int>::const_iterator it = reasons.begin(); it != reasons.end(); ++it)
+    {
+        std::string name( names[*it] );
+        for (std::size_t l(0); l < numLists; ++l)
+        {
+            std::map<int, Param*>::const_iterator pIt = lists[l].find(*it);
+            if ( pIt != lists[l].end() )
+            {
+                sum += pIt->second->value + name.size();
+                break;
+            }
+        }
+    }
+    double listTime( std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() );
+
+    // Table based dispatch. The name is not needed.
+    long long sum2(0);
+    start = std::chrono::steady_clock::now();
+    for (std::vector<int>::const_iterator it = reasons.begin(); it != reasons.end(); ++it)
+    {
+        const ParamHandler& h = table.get(*it);
+        if ( h.kind != HANDLER_NONE )
+            sum2 += static_cast<Param*>(h.object)->value + names[*it].size();
+    }
+    double tableTime( std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() );
+
+    if ( sum != sum2 )
+    {
+        std::cerr << "ERROR: The results of both methods don't match" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "List based dispatch       : " << 1e9 * listTime  / numLookups << " ns/call" << std::endl;
+    std::cout << "Table based dispatch      : " << 1e9 * tableTime / numLookups << " ns/call" << std::endl;
+
+    return 0;
+}
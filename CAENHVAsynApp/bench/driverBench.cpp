@@ -0,0 +1,505 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : driverBench.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Benchmark of the driver, running on the simulated CAEN HV Wrapper library.
+ * It measures the rate and the CPU cost of the read and write requests done
+ * through each asyn interface, and the startup time and memory used by the
+ * driver for several crate sizes. Each measurement is done on a separate
+ * process, so that the drivers created by one of them, and their threads,
+ * don't affect the others. The results are also written to a JSON file.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "drvCAENHVAsyn.h"
+
+// Port name used by the benchmarked driver
+static const char* benchPort = "BENCH";
+
+// Result of the startup measurement of a crate size
+struct StartupResult
+{
+    int    boards;
+    int    channels;
+    double startupTime;     // Seconds
+    long   rssBytes;        // Increase of the resident memory
+};
+
+// Result of the throughput measurement of an asyn interface method
+struct ThroughputResult
+{
+    char     method[32];
+    char     param[16];
+    uint64_t calls;
+    uint64_t errors;
+    double   wallTime;      // Seconds
+    double   cpuTime;       // Seconds, of all the threads of the process
+};
+
+// Benchmark options
+struct BenchOptions
+{
+    std::string      outFile;
+    double           duration;
+    double           latency;
+    double           pollPeriod;
+    std::vector<int> boards;
+    std::vector<int> channels;
+    int              tBoards;
+    int              tChannels;
+    bool             verbose;
+};
+
+static std::vector<int> parseList(const char* arg)
+{
+    std::vector<int>  list;
+    std::stringstream ss(arg);
+    std::string       item;
+
+    while ( std::getline(ss, item, ',') )
+        list.push_back( atoi(item.c_str()) );
+
+    return list;
+}
+
+// The requests are made by the I/O worker thread, so the CPU time of the
+// whole process is measured, and not only the one of the calling thread
+static double cpuTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static long residentMemory()
+{
+    long size(0), resident(0);
+
+    std::ifstream statm("/proc/self/statm");
+    statm >> size >> resident;
+
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+// Write the definition of a simulated crate, with the given number of boards and channels per board.
+// All the calls have the given latency, in milliseconds.
+static std::string writeCrateFile(int boards, int channels, double latency)
+{
+    std::stringstream name;
+    name << "/tmp/driverBench_" << getpid() << "_" << boards << "x" << channels << ".cfg";
+
+    std::ofstream file(name.str().c_str());
+    file << "NUMSLOTS " << ( ( boards > 16 ) ? boards : 16 ) << std::endl;
+    file << "SYSPROP  ModelName  STR   RDONLY SY4527" << std::endl;
+    file << "SYSPROP  HVClkConf  STR   RDWR   Internal" << std::endl;
+    file << "SYSPROP  GenSignCfg UINT2 RDWR   0" << std::endl;
+    file << "MODEL    BENCH " << channels << " Benchmark board" << std::endl;
+    file << "BDPARAM  BENCH BdStatus BDSTATUS RDONLY 0" << std::endl;
+    file << "BDPARAM  BENCH Temp     NUMERIC  RDONLY 35   0 100  CELSIUS" << std::endl;
+    file << "CHPARAM  BENCH V0Set    NUMERIC  RDWR   0    0 3500 VOLT" << std::endl;
+    file << "CHPARAM  BENCH I0Set    NUMERIC  RDWR   3000 0 3000 AMPERE -6" << std::endl;
+    file << "CHPARAM  BENCH VMon     NUMERIC  RDONLY 0    0 3500 VOLT" << std::endl;
+    file << "CHPARAM  BENCH IMon     NUMERIC  RDONLY 0    0 3000 AMPERE -6" << std::endl;
+    file << "CHPARAM  BENCH RUp      NUMERIC  RDWR   50   1 500  VPS" << std::endl;
+    file << "CHPARAM  BENCH RDWn     NUMERIC  RDWR   50   1 500  VPS" << std::endl;
+    file << "CHPARAM  BENCH Pw       ONOFF    RDWR   0    On Off" << std::endl;
+    file << "CHPARAM  BENCH Status   CHSTATUS RDONLY 0" << std::endl;
+    file << "RAMP     BENCH V0Set VMon Pw RUp RDWn Status IMon 0.5" << std::endl;
+    file << "NOISE    BENCH VMon 0.1" << std::endl;
+    for (int i(0); i < boards; ++i)
+        file << "SLOT " << i << " BENCH " << 1000 + i << " 1.0" << std::endl;
+    file << "LATENCY * " << latency << std::endl;
+
+    return name.str();
+}
+
+// Create the benchmarked driver. The simulated library reads the crate definition from the file
+// pointed by CAENHVSIM_CONFIG, as the driver only accepts IP addresses.
+static CAENHVAsyn* createDriver(const BenchOptions& opts, const std::string& crateFile)
+{
+    setenv("CAENHVSIM_CONFIG", crateFile.c_str(), 1);
+    CAENHVAsyn::pollPeriod = opts.pollPeriod;
+    return new CAENHVAsyn(benchPort, SY4527, "127.0.0.1", "admin", "admin");
+}
+
+// Create an asyn user for a parameter of the benchmarked driver, on the given asyn address
+static asynUser* createUser(CAENHVAsyn* drv, const std::string& param, int addr)
+{
+    asynUser* pasynUser( pasynManager->createAsynUser(NULL, NULL) );
+
+    if ( pasynManager->connectDevice(pasynUser, benchPort, addr) != asynSuccess )
+        throw std::runtime_error("Could not connect to port " + std::string(benchPort));
+
+    drv->lock();
+    asynStatus status( drv->drvUserCreate(pasynUser, param.c_str(), NULL, NULL) );
+    drv->unlock();
+
+    if ( status != asynSuccess )
+        throw std::runtime_error("Parameter '" + param + "' not found");
+
+    return pasynUser;
+}
+
+// Call a method of the driver, on randomly chosen parameters, during the given time.
+// The port is locked around each call, as done by the asyn interfaces.
+template<typename F>
+static ThroughputResult runMethod(CAENHVAsyn* drv, const char* method, const char* param, const std::vector<asynUser*>& users, double duration, F f)
+{
+    ThroughputResult r;
+    memset(&r, 0, sizeof(r));
+    strncpy(r.method, method, sizeof(r.method) - 1);
+    strncpy(r.param,  param,  sizeof(r.param) - 1);
+
+    std::mt19937                       gen(12345);
+    std::uniform_int_distribution<int> dist(0, users.size() - 1);
+    std::vector<int>                   sequence(4096);
+    for (std::vector<int>::iterator it = sequence.begin(); it != sequence.end(); ++it)
+        *it = dist(gen);
+
+    std::chrono::steady_clock::time_point start( std::chrono::steady_clock::now() );
+    std::chrono::steady_clock::time_point end( start + std::chrono::microseconds( static_cast<long>(duration * 1e6) ) );
+    double cpuStart( cpuTime() );
+
+    // The clock is checked every few calls, to keep its cost out of the measurement
+    while ( std::chrono::steady_clock::now() < end )
+    {
+        for (std::size_t i(0); i < 64; ++i, ++r.calls)
+        {
+            asynUser* pasynUser( users[ sequence[ r.calls % sequence.size() ] ] );
+
+            drv->lock();
+            asynStatus status( f(pasynUser, r.calls) );
+            drv->unlock();
+
+            if ( status != asynSuccess )
+                ++r.errors;
+        }
+    }
+
+    r.cpuTime  = cpuTime() - cpuStart;
+    r.wallTime = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    return r;
+}
+
+// Throughput of each asyn interface method. Run on a child process.
+static std::vector<ThroughputResult> benchThroughput(const BenchOptions& opts)
+{
+    std::vector<ThroughputResult> results;
+
+    std::string crateFile( writeCrateFile(opts.tBoards, opts.tChannels, opts.latency) );
+    CAENHVAsyn* drv( createDriver(opts, crateFile) );
+    remove(crateFile.c_str());
+
+    // Wait for the poller to read all the parameters
+    epicsThreadSleep( 2 * opts.pollPeriod + 0.5 );
+
+    // Parameters of all the channels
+    std::vector<asynUser*> vMon, v0Set, pw;
+    for (int s(0); s < opts.tBoards; ++s)
+    {
+        for (int c(0); c < opts.tChannels; ++c)
+        {
+            std::stringstream name;
+            name << "S" << std::setfill('0') << std::setw(2) << s << "_C" << std::setfill('0') << std::setw(2) << c << "_";
+            vMon.push_back(  createUser(drv, name.str() + "VMON",  s + 1) );
+            v0Set.push_back( createUser(drv, name.str() + "V0SET", s + 1) );
+            pw.push_back(    createUser(drv, name.str() + "PW",    s + 1) );
+        }
+    }
+
+    // System properties
+    std::vector<asynUser*> genSignCfg( 1, createUser(drv, "C_GENSIGNCFG", 0) );
+    std::vector<asynUser*> hvClkConf(  1, createUser(drv, "C_HVCLKCONF",  0) );
+
+    results.push_back( runMethod(drv, "readFloat64", "VMON", vMon, opts.duration, [&](asynUser* u, uint64_t) {
+        epicsFloat64 v;
+        return drv->readFloat64(u, &v);
+    }) );
+
+    results.push_back( runMethod(drv, "writeFloat64", "V0SET", v0Set, opts.duration, [&](asynUser* u, uint64_t n) {
+        return drv->writeFloat64(u, n % 1000);
+    }) );
+
+    results.push_back( runMethod(drv, "readUInt32Digital", "PW", pw, opts.duration, [&](asynUser* u, uint64_t) {
+        epicsUInt32 v;
+        return drv->readUInt32Digital(u, &v, 0x1);
+    }) );
+
+    results.push_back( runMethod(drv, "writeUInt32Digital", "PW", pw, opts.duration, [&](asynUser* u, uint64_t) {
+        return drv->writeUInt32Digital(u, 0, 0x1);
+    }) );
+
+    results.push_back( runMethod(drv, "readInt32", "GENSIGNCFG", genSignCfg, opts.duration, [&](asynUser* u, uint64_t) {
+        epicsInt32 v;
+        return drv->readInt32(u, &v);
+    }) );
+
+    results.push_back( runMethod(drv, "writeInt32", "GENSIGNCFG", genSignCfg, opts.duration, [&](asynUser* u, uint64_t n) {
+        return drv->writeInt32(u, n % 2);
+    }) );
+
+    results.push_back( runMethod(drv, "readOctet", "HVCLKCONF", hvClkConf, opts.duration, [&](asynUser* u, uint64_t) {
+        char   v[64];
+        size_t nActual;
+        int    eomReason;
+        return drv->readOctet(u, v, sizeof(v), &nActual, &eomReason);
+    }) );
+
+    results.push_back( runMethod(drv, "writeOctet", "HVCLKCONF", hvClkConf, opts.duration, [&](asynUser* u, uint64_t n) {
+        const char* v( ( n % 2 ) ? "Internal" : "External" );
+        size_t      nActual;
+        return drv->writeOctet(u, v, strlen(v), &nActual);
+    }) );
+
+    return results;
+}
+
+// Startup time and memory used with a crate size. Run on a child process.
+static StartupResult benchStartup(const BenchOptions& opts, int boards, int channels)
+{
+    StartupResult r;
+    r.boards   = boards;
+    r.channels = channels;
+
+    std::string crateFile( writeCrateFile(boards, channels, opts.latency) );
+
+    long rss( residentMemory() );
+    std::chrono::steady_clock::time_point start( std::chrono::steady_clock::now() );
+
+    createDriver(opts, crateFile);
+
+    r.startupTime = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    r.rssBytes    = residentMemory() - rss;
+
+    remove(crateFile.c_str());
+
+    return r;
+}
+
+// Run a function on a child process, and read its results through a pipe.
+// The output of the driver is discarded, unless verbose output was requested.
+template<typename T, typename F>
+static bool runChild(const BenchOptions& opts, std::vector<T>& results, F f)
+{
+    int fds[2];
+    if ( pipe(fds) )
+        return false;
+
+    pid_t pid( fork() );
+
+    if ( pid < 0 )
+        return false;
+
+    if ( pid == 0 )
+    {
+        close(fds[0]);
+
+        if ( ! opts.verbose )
+        {
+            int devNull( open("/dev/null", O_WRONLY) );
+            dup2(devNull, STDOUT_FILENO);
+            close(devNull);
+        }
+
+        std::vector<T> r;
+        try
+        {
+            r = f();
+        }
+        catch (std::exception& e)
+        {
+            std::cerr << "Error: " << e.what() << std::endl;
+            _exit(1);
+        }
+
+        std::size_t n( r.size() );
+        if ( ( write(fds[1], &n, sizeof(n)) != sizeof(n) ) || \
+             ( write(fds[1], r.data(), n * sizeof(T)) != static_cast<ssize_t>(n * sizeof(T)) ) )
+            _exit(1);
+
+        // The driver threads are not stopped
+        _exit(0);
+    }
+
+    close(fds[1]);
+
+    std::size_t n(0);
+    bool        ok( read(fds[0], &n, sizeof(n)) == sizeof(n) );
+    if ( ok )
+    {
+        std::vector<T> r(n);
+        std::size_t    got(0);
+        while ( got < n * sizeof(T) )
+        {
+            ssize_t c( read(fds[0], reinterpret_cast<char*>(r.data()) + got, n * sizeof(T) - got) );
+            if ( c <= 0 )
+                break;
+            got += c;
+        }
+
+        ok = ( got == n * sizeof(T) );
+        if ( ok )
+            results.insert(results.end(), r.begin(), r.end());
+    }
+    close(fds[0]);
+
+    int status;
+    waitpid(pid, &status, 0);
+
+    return ok && WIFEXITED(status) && ( WEXITSTATUS(status) == 0 );
+}
+
+static void usage(const char* name)
+{
+    std::cout << "Usage: " << name << " [-o FILE] [-d SECONDS] [-l LATENCY] [-p PERIOD] [-b BOARDS] [-c CHANNELS] [-t BOARDSxCHANNELS] [-v]" << std::endl;
+    std::cout << "    -o FILE            : JSON file where the results are written (default: driverBench.json)" << std::endl;
+    std::cout << "    -d SECONDS         : Duration of each throughput measurement (default: 1)" << std::endl;
+    std::cout << "    -l LATENCY         : Latency of each call to the simulated crate, in ms (default: 0)" << std::endl;
+    std::cout << "    -p PERIOD          : Period of the parameter poller, in seconds (default: 1)" << std::endl;
+    std::cout << "    -b BOARDS          : Comma separated list of number of boards, for the startup measurements (default: 1,2,4,8,16)" << std::endl;
+    std::cout << "    -c CHANNELS        : Comma separated list of number of channels, for the startup measurements (default: 12,24,48,128)" << std::endl;
+    std::cout << "    -t BOARDSxCHANNELS : Crate size used for the throughput measurements (default: 4x24)" << std::endl;
+    std::cout << "    -v                 : Show the output of the driver" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    BenchOptions opts;
+    opts.outFile    = "driverBench.json";
+    opts.duration   = 1.0;
+    opts.latency    = 0;
+    opts.pollPeriod = 1.0;
+    opts.boards     = parseList("1,2,4,8,16");
+    opts.channels   = parseList("12,24,48,128");
+    opts.tBoards    = 4;
+    opts.tChannels  = 24;
+    opts.verbose    = false;
+
+    int c;
+    while ( ( c = getopt(argc, argv, "o:d:l:p:b:c:t:vh") ) != -1 )
+    {
+        switch (c)
+        {
+            case 'o': opts.outFile    = optarg;                  break;
+            case 'd': opts.duration   = strtod(optarg, NULL);    break;
+            case 'l': opts.latency    = strtod(optarg, NULL);    break;
+            case 'p': opts.pollPeriod = strtod(optarg, NULL);    break;
+            case 'b': opts.boards     = parseList(optarg);       break;
+            case 'c': opts.channels   = parseList(optarg);       break;
+            case 't':
+                if ( sscanf(optarg, "%dx%d", &opts.tBoards, &opts.tChannels) != 2 )
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'v': opts.verbose    = true;                    break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    std::cout << "CAENHVAsyn driver benchmark" << std::endl;
+    std::cout << "===========================" << std::endl;
+
+    // Throughput of each asyn interface method
+    std::vector<ThroughputResult> throughput;
+    if ( ! runChild(opts, throughput, [&]() { return benchThroughput(opts); }) )
+        std::cerr << "ERROR: The throughput measurement failed" << std::endl;
+
+    std::cout << "Throughput (" << opts.tBoards << " boards, " << opts.tChannels << " channels per board, " << opts.latency << " ms call latency):" << std::endl;
+    std::cout << std::left  << std::setw(22) << "Method" << std::setw(12) << "Parameter" << std::right \
+              << std::setw(14) << "Calls/s" << std::setw(14) << "Wall ns/call" << std::setw(14) << "CPU ns/call" << std::setw(10) << "Errors" << std::endl;
+    std::cout << std::fixed << std::setprecision(0);
+    for (std::vector<ThroughputResult>::const_iterator it = throughput.begin(); it != throughput.end(); ++it)
+        std::cout << std::left  << std::setw(22) << it->method << std::setw(12) << it->param << std::right \
+                  << std::setw(14) << it->calls / it->wallTime \
+                  << std::setw(14) << 1e9 * it->wallTime / it->calls \
+                  << std::setw(14) << 1e9 * it->cpuTime / it->calls \
+                  << std::setw(10) << it->errors << std::endl;
+    std::cout << std::endl;
+
+    // Startup time and memory against crate size
+    std::vector<StartupResult> startup;
+    for (std::vector<int>::const_iterator bIt = opts.boards.begin(); bIt != opts.boards.end(); ++bIt)
+        for (std::vector<int>::const_iterator cIt = opts.channels.begin(); cIt != opts.channels.end(); ++cIt)
+            if ( ! runChild(opts, startup, [&]() { return std::vector<StartupResult>( 1, benchStartup(opts, *bIt, *cIt) ); }) )
+                std::cerr << "ERROR: The startup measurement failed for " << *bIt << " boards, " << *cIt << " channels" << std::endl;
+
+    std::cout << "Startup:" << std::endl;
+    std::cout << std::setw(8) << "Boards" << std::setw(10) << "Channels" << std::setw(14) << "Startup (ms)" << std::setw(14) << "Memory (kB)" << std::setw(18) << "Bytes/channel" << std::endl;
+    for (std::vector<StartupResult>::const_iterator it = startup.begin(); it != startup.end(); ++it)
+        std::cout << std::setw(8) << it->boards << std::setw(10) << it->channels \
+                  << std::setw(14) << std::setprecision(1) << 1e3 * it->startupTime \
+                  << std::setw(14) << std::setprecision(0) << it->rssBytes / 1024.0 \
+                  << std::setw(18) << static_cast<double>(it->rssBytes) / ( it->boards * it->channels ) << std::endl;
+
+    // Machine readable results
+    std::ofstream out(opts.outFile.c_str());
+    if ( ! out.is_open() )
+    {
+        std::cerr << "ERROR: Could not open file '" << opts.outFile << "'" << std::endl;
+        return 1;
+    }
+
+    out << std::setprecision(9);
+    out << "{" << std::endl;
+    out << "  \"benchmark\": \"driverBench\"," << std::endl;
+    out << "  \"timestamp\": " << time(NULL) << "," << std::endl;
+    out << "  \"options\": { \"duration\": " << opts.duration << ", \"latency_ms\": " << opts.latency \
+        << ", \"poll_period\": " << opts.pollPeriod << ", \"boards\": " << opts.tBoards << ", \"channels\": " << opts.tChannels << " }," << std::endl;
+
+    out << "  \"throughput\": [" << std::endl;
+    for (std::vector<ThroughputResult>::const_iterator it = throughput.begin(); it != throughput.end(); ++it)
+        out << "    { \"method\": \"" << it->method << "\", \"param\": \"" << it->param << "\"" \
+            << ", \"calls\": " << it->calls << ", \"errors\": " << it->errors \
+            << ", \"calls_per_second\": " << it->calls / it->wallTime \
+            << ", \"wall_ns_per_call\": " << 1e9 * it->wallTime / it->calls \
+            << ", \"cpu_ns_per_call\": " << 1e9 * it->cpuTime / it->calls << " }" \
+            << ( ( it + 1 != throughput.end() ) ? "," : "" ) << std::endl;
+    out << "  ]," << std::endl;
+
+    out << "  \"startup\": [" << std::endl;
+    for (std::vector<StartupResult>::const_iterator it = startup.begin(); it != startup.end(); ++it)
+        out << "    { \"boards\": " << it->boards << ", \"channels\": " << it->channels \
+            << ", \"startup_seconds\": " << it->startupTime << ", \"memory_bytes\": " << it->rssBytes \
+            << ", \"bytes_per_channel\": " << static_cast<double>(it->rssBytes) / ( it->boards * it->channels ) << " }" \
+            << ( ( it + 1 != startup.end() ) ? "," : "" ) << std::endl;
+    out << "  ]" << std::endl;
+    out << "}" << std::endl;
+
+    std::cout << std::endl << "Results written to " << opts.outFile << std::endl;
+
+    return ( throughput.empty() || startup.empty() ) ? 1 : 0;
+}
@@ -0,0 +1,582 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : caenhvwrapper_sim.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Simulated CAEN HV Wrapper library.
+ * It implements the functions of the CAEN HV Wrapper library used by this
+ * module on top of a simulated crate, so that it can be linked instead of the
+ * real library. The crate is defined by the file passed as the address of the
+ * crate to CAENHV_InitSystem, or by the environment variable CAENHVSIM_CONFIG,
+ * which points either to a file, or to a directory holding one file per crate
+ * address, called "<address>.cfg". If none of them exists, a default crate is
+ * used.
+ * All the connections to the same file share the same crate.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <tuple>
+#include <cmath>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "sim_crate.h"
+
+// Subscribed parameter: slot, channel (-1 for board parameters), and name
+typedef std::tuple<int, int, std::string> simEventKey_t;
+
+// Connection to a simulated crate
+struct SimHandle
+{
+    SimCrate                          crate;
+    std::mutex                        mutex;
+    char                              error[256];
+    std::map<simEventKey_t, double>   subscriptions;  // Last value sent on each subscribed parameter
+};
+
+static std::mutex                                   handlesMutex;
+static std::map< int, std::shared_ptr<SimHandle> >  handles;
+static std::map< std::string, SimCrate >            crates;
+static int                                          nextHandle(0);
+static char                                         initError[256] = "No error";
+
+static const char* getErrorString(CAENHVRESULT r)
+{
+    switch ( r )
+    {
+        case CAENHV_OK:                   return "Command wrapper correctly executed";
+        case CAENHV_SYSERR:               return "Error of operative system";
+        case CAENHV_WRITEERR:             return "Write error in communication channel";
+        case CAENHV_READERR:              return "Read error in communication channel";
+        case CAENHV_TIMEERR:              return "Time out in server communication";
+        case CAENHV_DOWN:                 return "Command Front End application is down";
+        case CAENHV_SLOTNOTPRES:          return "Slot not present";
+        case CAENHV_OUTOFRANGE:           return "Value out of range";
+        case CAENHV_NOTSYSPROP:           return "Not a system property";
+        case CAENHV_NOTGETPROP:           return "Get property not allowed";
+        case CAENHV_NOTSETPROP:           return "Set property not allowed";
+        case CAENHV_PARAMPROPNOTFOUND:    return "Parameter property not found";
+        case CAENHV_PARAMNOTFOUND:        return "Parameter not found";
+        case CAENHV_COMMUNICATIONERROR:   return "Communication error";
+        case CAENHV_NOTCONNECTED:         return "Device not connected";
+        default:                          return "Simulated error";
+    }
+}
+
+static std::shared_ptr<SimHandle> findHandle(int handle)
+{
+    std::shared_ptr<SimHandle> h;
+
+    handlesMutex.lock();
+    std::map< int, std::shared_ptr<SimHandle> >::iterator it( handles.find(handle) );
+    if ( it != handles.end() )
+        h = it->second;
+    handlesMutex.unlock();
+
+    return h;
+}
+
+// Run a call on the crate of a connection, injecting the configured latency and errors.
+// The function 'f' is called holding the crate lock, after advancing the channel dynamics.
+// The latency of the slow slots in 'slotList', if given, is added to the call.
+template<typename F>
+static CAENHVRESULT simCall(int handle, simCall_t call, F f, std::size_t slotNum = 0, const unsigned short* slotList = NULL)
+{
+    std::shared_ptr<SimHandle> h( findHandle(handle) );
+
+    if ( ! h )
+        return CAENHV_NOTCONNECTED;
+
+    ISimCrate& c( *h->crate );
+
+    // The latency is added outside the crate lock, so that concurrent calls overlap
+    double delay( c.getDelay(call) );
+    for (std::size_t i(0); i < slotNum; ++i)
+        delay += c.getSlotDelay(slotList[i]);
+
+    if ( delay > 0 )
+        std::this_thread::sleep_for( std::chrono::duration<double>(delay) );
+
+    CAENHVRESULT r;
+
+    if ( c.isDown() )
+        r = CAENHV_COMMUNICATIONERROR;
+    else if ( c.injectError(call) )
+        r = c.getFault(call).errorCode;
+    else
+    {
+        c.lock();
+        try
+        {
+            c.update();
+            r = f(c, *h);
+        }
+        catch (std::exception& e)
+        {
+            r = CAENHV_SYSERR;
+        }
+        c.unlock();
+    }
+
+    h->mutex.lock();
+    snprintf(h->error, sizeof(h->error), "%s", getErrorString(r));
+    h->mutex.unlock();
+
+    return r;
+}
+
+// Split a list of parameter names separated by colons
+static std::vector<std::string> splitParamList(const char* list, unsigned int num)
+{
+    std::vector<std::string> names;
+    std::stringstream        ss(list);
+    std::string              name;
+
+    while ( ( names.size() < num ) && std::getline(ss, name, ':') )
+        names.push_back(name);
+
+    names.resize(num);
+
+    return names;
+}
+
+static CAENHVRESULT subscribe(int handle, simCall_t call, int slot, int channel, const char *paramNameList, unsigned int paramNum, char *listOfResultCodes)
+{
+    return simCall(handle, call, [&](ISimCrate& c, SimHandle& h) {
+        std::vector<std::string> names( splitParamList(paramNameList, paramNum) );
+
+        h.mutex.lock();
+        for (std::size_t i(0); i < names.size(); ++i)
+        {
+            SimEventValue v;
+            v.slot    = slot;
+            v.channel = channel;
+            v.param   = names.at(i);
+
+            if ( c.getEventValue(v) )
+            {
+                // The first event carries the current value
+                h.subscriptions[ simEventKey_t(slot, channel, names.at(i)) ] = NAN;
+                listOfResultCodes[i] = CAENHV_OK;
+            }
+            else
+            {
+                listOfResultCodes[i] = CAENHV_PARAMNOTFOUND;
+            }
+        }
+        h.mutex.unlock();
+
+        return CAENHV_OK;
+    });
+}
+
+CAENHVRESULT CAENHV_InitSystem(CAENHV_SYSTEM_TYPE_t system, int LinkType, void *Arg, const char *UserName, const char *Passwd, int *handle)
+{
+    *handle = -1;
+
+    // The crate definition file is passed as the crate address. If it is not a readable file, the file
+    // defined in the environment is used. If it is a directory, the file named after the crate address
+    // in that directory is used. If none of them exists, the default crate is used.
+    std::string address( Arg ? static_cast<const char*>(Arg) : "" );
+    std::string fileName( address );
+    if ( fileName.empty() || ( access(fileName.c_str(), R_OK) != 0 ) )
+    {
+        fileName = getenv("CAENHVSIM_CONFIG") ? getenv("CAENHVSIM_CONFIG") : "";
+
+        struct stat st;
+        if ( ( !fileName.empty() ) && ( stat(fileName.c_str(), &st) == 0 ) && S_ISDIR(st.st_mode) )
+        {
+            fileName += "/" + address + ".cfg";
+            if ( access(fileName.c_str(), R_OK) != 0 )
+                fileName.clear();
+        }
+    }
+
+    SimCrate crate;
+
+    handlesMutex.lock();
+    try
+    {
+        std::map< std::string, SimCrate >::iterator it( crates.find(fileName) );
+        if ( it == crates.end() )
+        {
+            crate = ISimCrate::create(fileName);
+            crates.insert( std::make_pair(fileName, crate) );
+
+            std::cout << "CAEN HV Wrapper simulator: crate loaded from " << ( fileName.empty() ? "(default crate)" : fileName ) << std::endl;
+            crate->printInfo(std::cout);
+        }
+        else
+        {
+            crate = it->second;
+        }
+    }
+    catch (std::exception& e)
+    {
+        snprintf(initError, sizeof(initError), "%s", e.what());
+        handlesMutex.unlock();
+        std::cerr << "CAEN HV Wrapper simulator: " << e.what() << std::endl;
+        return CAENHV_SYSERR;
+    }
+    handlesMutex.unlock();
+
+    double delay( crate->getDelay(SIM_INIT_SYSTEM) );
+    if ( delay > 0 )
+        std::this_thread::sleep_for( std::chrono::duration<double>(delay) );
+
+    CAENHVRESULT r( CAENHV_OK );
+    if ( crate->isDown() )
+        r = CAENHV_COMMUNICATIONERROR;
+    else if ( crate->injectError(SIM_INIT_SYSTEM) )
+        r = crate->getFault(SIM_INIT_SYSTEM).errorCode;
+
+    handlesMutex.lock();
+    snprintf(initError, sizeof(initError), "%s", getErrorString(r));
+    if ( r == CAENHV_OK )
+    {
+        std::shared_ptr<SimHandle> h( std::make_shared<SimHandle>() );
+        h->crate = crate;
+        snprintf(h->error, sizeof(h->error), "%s", getErrorString(r));
+
+        *handle = nextHandle++;
+        handles.insert( std::make_pair(*handle, h) );
+    }
+    handlesMutex.unlock();
+
+    return r;
+}
+
+CAENHVRESULT CAENHV_DeinitSystem(int handle)
+{
+    handlesMutex.lock();
+    std::size_t n( handles.erase(handle) );
+    handlesMutex.unlock();
+
+    return n ? CAENHV_OK : CAENHV_NOTCONNECTED;
+}
+
+char *CAENHV_GetError(int handle)
+{
+    std::shared_ptr<SimHandle> h( findHandle(handle) );
+
+    // The error buffers of the connections are never released while the library is loaded
+    if ( ! h )
+        return initError;
+
+    return h->error;
+}
+
+CAENHVRESULT CAENHV_Free(void *arg)
+{
+    free(arg);
+    return CAENHV_OK;
+}
+
+CAENHVRESULT CAENHV_GetSysPropList(int handle, unsigned short *NumProp, char **PropNameList)
+{
+    return simCall(handle, SIM_GET_SYS_PROP_LIST, [&](ISimCrate& c, SimHandle& h) {
+        const std::vector<SimSysProp>& props( c.getSysProps() );
+
+        // The names are concatenated, separated by null characters
+        std::size_t size(1);
+        for (std::vector<SimSysProp>::const_iterator it = props.begin(); it != props.end(); ++it)
+            size += it->name.size() + 1;
+
+        char* p( static_cast<char*>( calloc(size, 1) ) );
+        *NumProp      = props.size();
+        *PropNameList = p;
+
+        for (std::vector<SimSysProp>::const_iterator it = props.begin(); it != props.end(); ++it, p += strlen(p) + 1)
+            strcpy(p, it->name.c_str());
+
+        return CAENHV_OK;
+    });
+}
+
+CAENHVRESULT CAENHV_GetSysPropInfo(int handle, const char *PropName, unsigned *PropMode, unsigned *PropType)
+{
+    return simCall(handle, SIM_GET_SYS_PROP_INFO, [&](ISimCrate& c, SimHandle& h) {
+        const std::vector<SimSysProp>& props( c.getSysProps() );
+
+        for (std::vector<SimSysProp>::const_iterator it = props.begin(); it != props.end(); ++it)
+        {
+            if ( it->name == PropName )
+            {
+                *PropMode = it->mode;
+                *PropType = it->type;
+                return CAENHV_OK;
+            }
+        }
+
+        return CAENHV_NOTSYSPROP;
+    });
+}
+
+CAENHVRESULT CAENHV_GetSysProp(int handle, const char *PropName, void *Result)
+{
+    return simCall(handle, SIM_GET_SYS_PROP, [&](ISimCrate& c, SimHandle& h) {
+        return c.getSysProp(PropName, Result);
+    });
+}
+
+CAENHVRESULT CAENHV_SetSysProp(int handle, const char *PropName, void *Set)
+{
+    return simCall(handle, SIM_SET_SYS_PROP, [&](ISimCrate& c, SimHandle& h) {
+        return c.setSysProp(PropName, Set);
+    });
+}
+
+CAENHVRESULT CAENHV_GetCrateMap(int handle, unsigned short *NrOfSlot, unsigned short **NrofChList, char **ModelList, char **DescriptionList, unsigned short **SerNumList, unsigned char **FmwRelMinList, unsigned char **FmwRelMaxList)
+{
+    return simCall(handle, SIM_GET_CRATE_MAP, [&](ISimCrate& c, SimHandle& h) {
+        std::size_t n( c.getNumSlots() );
+
+        // Models and descriptions are concatenated, separated by null characters.
+        // Empty slots have an empty model.
+        std::string models, descriptions;
+        for (std::size_t i(0); i < n; ++i)
+        {
+            const SimBoard* b( c.getBoard(i) );
+            if ( b )
+            {
+                models       += b->model->name;
+                descriptions += b->model->description;
+            }
+            models       += '\0';
+            descriptions += '\0';
+        }
+
+        *NrOfSlot        = n;
+        *NrofChList      = static_cast<unsigned short*>( calloc(n + 1, sizeof(unsigned short)) );
+        *SerNumList      = static_cast<unsigned short*>( calloc(n + 1, sizeof(unsigned short)) );
+        *FmwRelMinList   = static_cast<unsigned char*>( calloc(n + 1, sizeof(unsigned char)) );
+        *FmwRelMaxList   = static_cast<unsigned char*>( calloc(n + 1, sizeof(unsigned char)) );
+        *ModelList       = static_cast<char*>( calloc(models.size() + 1, 1) );
+        *DescriptionList = static_cast<char*>( calloc(descriptions.size() + 1, 1) );
+
+        memcpy(*ModelList,       models.data(),       models.size());
+        memcpy(*DescriptionList, descriptions.data(), descriptions.size());
+
+        for (std::size_t i(0); i < n; ++i)
+        {
+            const SimBoard* b( c.getBoard(i) );
+            if ( b )
+            {
+                (*NrofChList)[i]    = b->channels.size();
+                (*SerNumList)[i]    = b->serialNumber;
+                (*FmwRelMinList)[i] = b->fwMinor;
+                (*FmwRelMaxList)[i] = b->fwMajor;
+            }
+        }
+
+        return CAENHV_OK;
+    });
+}
+
+// Copy a list of parameter names into a block of MAX_PARAM_NAME characters per name,
+// terminated by an empty name.
+static char* makeParamNameList(const std::vector<SimParamDef>& params)
+{
+    char* list( static_cast<char*>( calloc(params.size() + 1, MAX_PARAM_NAME) ) );
+
+    for (std::size_t i(0); i < params.size(); ++i)
+        strncpy(list + i * MAX_PARAM_NAME, params.at(i).name.c_str(), MAX_PARAM_NAME - 1);
+
+    return list;
+}
+
+CAENHVRESULT CAENHV_GetBdParamInfo(int handle, unsigned short slot, char **ParNameList)
+{
+    return simCall(handle, SIM_GET_BD_PARAM_INFO, [&](ISimCrate& c, SimHandle& h) {
+        const SimBoard* b( c.getBoard(slot) );
+        if ( ! b )
+            return CAENHV_SLOTNOTPRES;
+
+        *ParNameList = makeParamNameList(b->model->bdParams);
+        return CAENHV_OK;
+    });
+}
+
+CAENHVRESULT CAENHV_GetBdParamProp(int handle, unsigned short slot, const char *ParName, const char *PropName, void *retval)
+{
+    return simCall(handle, SIM_GET_BD_PARAM_PROP, [&](ISimCrate& c, SimHandle& h) {
+        return c.getBdParamProp(slot, ParName, PropName, retval);
+    });
+}
+
+// All the parameter values are 32-bit long: floats, or signed or unsigned integers
+static const std::size_t simValueSize(4);
+
+CAENHVRESULT CAENHV_GetBdParam(int handle, unsigned short slotNum, const unsigned short *slotList, const char *ParName, void *ParValList)
+{
+    return simCall(handle, SIM_GET_BD_PARAM, [&](ISimCrate& c, SimHandle& h) {
+        for (std::size_t i(0); i < slotNum; ++i)
+        {
+            CAENHVRESULT r( c.getBdParam(slotList[i], ParName, static_cast<char*>(ParValList) + i * simValueSize) );
+            if ( r != CAENHV_OK )
+                return r;
+        }
+
+        return CAENHV_OK;
+    }, slotNum, slotList);
+}
+
+CAENHVRESULT CAENHV_SetBdParam(int handle, unsigned short slotNum, const unsigned short *slotList, const char *ParName, void *ParValue)
+{
+    return simCall(handle, SIM_SET_BD_PARAM, [&](ISimCrate& c, SimHandle& h) {
+        for (std::size_t i(0); i < slotNum; ++i)
+        {
+            CAENHVRESULT r( c.setBdParam(slotList[i], ParName, ParValue) );
+            if ( r != CAENHV_OK )
+                return r;
+        }
+
+        return CAENHV_OK;
+    }, slotNum, slotList);
+}
+
+CAENHVRESULT CAENHV_GetChParamInfo(int handle, unsigned short slot, unsigned short Ch, char **ParNameList, int *ParNumber)
+{
+    return simCall(handle, SIM_GET_CH_PARAM_INFO, [&](ISimCrate& c, SimHandle& h) {
+        const SimBoard* b( c.getBoard(slot) );
+        if ( ! b )
+            return CAENHV_SLOTNOTPRES;
+
+        if ( Ch >= b->channels.size() )
+            return CAENHV_OUTOFRANGE;
+
+        *ParNameList = makeParamNameList(b->model->chParams);
+        *ParNumber   = b->model->chParams.size();
+        return CAENHV_OK;
+    });
+}
+
+CAENHVRESULT CAENHV_GetChParamProp(int handle, unsigned short slot, unsigned short Ch, const char *ParName, const char *PropName, void *retval)
+{
+    return simCall(handle, SIM_GET_CH_PARAM_PROP, [&](ISimCrate& c, SimHandle& h) {
+        return c.getChParamProp(slot, Ch, ParName, PropName, retval);
+    });
+}
+
+CAENHVRESULT CAENHV_GetChParam(int handle, unsigned short slot, const char *ParName, unsigned short ChNum, const unsigned short *ChList, void *ParValList)
+{
+    return simCall(handle, SIM_GET_CH_PARAM, [&](ISimCrate& c, SimHandle& h) {
+        for (std::size_t i(0); i < ChNum; ++i)
+        {
+            CAENHVRESULT r( c.getChParam(slot, ChList[i], ParName, static_cast<char*>(ParValList) + i * simValueSize) );
+            if ( r != CAENHV_OK )
+                return r;
+        }
+
+        return CAENHV_OK;
+    }, 1, &slot);
+}
+
+CAENHVRESULT CAENHV_SetChParam(int handle, unsigned short slot, const char *ParName, unsigned short ChNum, const unsigned short *ChList, void *ParValue)
+{
+    return simCall(handle, SIM_SET_CH_PARAM, [&](ISimCrate& c, SimHandle& h) {
+        for (std::size_t i(0); i < ChNum; ++i)
+        {
+            CAENHVRESULT r( c.setChParam(slot, ChList[i], ParName, ParValue) );
+            if ( r != CAENHV_OK )
+                return r;
+        }
+
+        return CAENHV_OK;
+    }, 1, &slot);
+}
+
+CAENHVRESULT CAENHV_SubscribeChannelParams(int handle, unsigned short Port, const unsigned short slotIndex, const unsigned short chanIndex, const char *paramNameList, unsigned int paramNum, char *listOfResultCodes)
+{
+    return subscribe(handle, SIM_SUBSCRIBE_CH_PARAMS, slotIndex, chanIndex, paramNameList, paramNum, listOfResultCodes);
+}
+
+CAENHVRESULT CAENHV_SubscribeBoardParams(int handle, unsigned short Port, const unsigned short slotIndex, const char *paramNameList, unsigned int paramNum, char *listOfResultCodes)
+{
+    return subscribe(handle, SIM_SUBSCRIBE_BD_PARAMS, slotIndex, -1, paramNameList, paramNum, listOfResultCodes);
+}
+
+CAENHVRESULT CAENHV_GetEventData(int handle, CAENHV_SYSTEMSTATUS_t *SysStatus, CAENHVEVENT_TYPE_t **EventData, unsigned int *DataNumber)
+{
+    *EventData  = NULL;
+    *DataNumber = 0;
+
+    return simCall(handle, SIM_GET_EVENT_DATA, [&](ISimCrate& c, SimHandle& h) {
+        SysStatus->System = SYNC;
+        for (std::size_t i(0); i < sizeof(SysStatus->Board) / sizeof(SysStatus->Board[0]); ++i)
+            SysStatus->Board[i] = c.getBoard(i) ? SYNC : NOTAVAIL;
+
+        // An event is sent for each subscribed parameter whose value has changed since the last event
+        std::vector<SimEventValue> changed;
+
+        h.mutex.lock();
+        for (std::map<simEventKey_t, double>::iterator it = h.subscriptions.begin(); it != h.subscriptions.end(); ++it)
+        {
+            SimEventValue v;
+            v.slot    = std::get<0>(it->first);
+            v.channel = std::get<1>(it->first);
+            v.param   = std::get<2>(it->first);
+
+            if ( ( ! c.getEventValue(v) ) || ( v.value == it->second ) )
+                continue;
+
+            it->second = v.value;
+            changed.push_back(v);
+        }
+        h.mutex.unlock();
+
+        if ( changed.empty() )
+            return CAENHV_OK;
+
+        CAENHVEVENT_TYPE_t* data( static_cast<CAENHVEVENT_TYPE_t*>( calloc(changed.size(), sizeof(CAENHVEVENT_TYPE_t)) ) );
+        for (std::size_t i(0); i < changed.size(); ++i)
+        {
+            data[i].Type         = PARAMETER;
+            data[i].SystemHandle = handle;
+            data[i].BoardIndex   = changed.at(i).slot;
+            data[i].ChannelIndex = changed.at(i).channel;
+            strncpy(data[i].ItemID, changed.at(i).param.c_str(), sizeof(data[i].ItemID) - 1);
+
+            if ( changed.at(i).isFloat )
+                data[i].Value.FloatValue = changed.at(i).value;
+            else
+                data[i].Value.IntValue = static_cast<int>(changed.at(i).value);
+        }
+
+        *EventData  = data;
+        *DataNumber = changed.size();
+
+        return CAENHV_OK;
+    });
+}
+
+CAENHVRESULT CAENHV_FreeEventData(CAENHVEVENT_TYPE_t **ListOfItemsData)
+{
+    free(*ListOfItemsData);
+    *ListOfItemsData = NULL;
+
+    return CAENHV_OK;
+}
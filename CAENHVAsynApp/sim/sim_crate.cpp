@@ -0,0 +1,994 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : sim_crate.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Simulated CAEN HV Power supply crate.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <fstream>
+#include <cmath>
+#include <string.h>
+#include <stdlib.h>
+#include "sim_crate.h"
+
+static const char* simCallNames[NUM_SIM_CALLS] =
+{
+    "InitSystem",
+    "GetSysPropList",
+    "GetSysPropInfo",
+    "GetCrateMap",
+    "GetBdParamInfo",
+    "GetBdParamProp",
+    "GetChParamInfo",
+    "GetChParamProp",
+    "GetSysProp",
+    "SetSysProp",
+    "GetBdParam",
+    "SetBdParam",
+    "GetChParam",
+    "SetChParam",
+    "SubscribeChannelParams",
+    "SubscribeBoardParams",
+    "GetEventData"
+};
+
+// Crate used when no configuration file is given: a SY4527 crate with
+// four 24-channel boards, in slots 0 to 3.
+static const char* defaultCrate =
+    "NUMSLOTS 16\n"
+    "SYSPROP  ModelName  STR   RDONLY SY4527\n"
+    "SYSPROP  SwRelease  STR   RDONLY 1.0.0-sim\n"
+    "SYSPROP  CPULoad    STR   RDONLY 5%\n"
+    "SYSPROP  HVClkConf  STR   RDWR   Internal\n"
+    "SYSPROP  FrontPanIn UINT2 RDONLY 0\n"
+    "SYSPROP  GenSignCfg UINT2 RDWR   0\n"
+    "MODEL    A1535 24 24 Ch Neg. 3.5KV 3mA\n"
+    "BDPARAM  A1535 BdStatus BDSTATUS RDONLY 0\n"
+    "BDPARAM  A1535 HVMax    NUMERIC  RDONLY 3500 0 3500 VOLT\n"
+    "BDPARAM  A1535 Temp     NUMERIC  RDONLY 35   0 100  CELSIUS\n"
+    "CHPARAM  A1535 V0Set    NUMERIC  RDWR   0    0 3500 VOLT\n"
+    "CHPARAM  A1535 I0Set    NUMERIC  RDWR   3000 0 3000 AMPERE -6\n"
+    "CHPARAM  A1535 VMon     NUMERIC  RDONLY 0    0 3500 VOLT\n"
+    "CHPARAM  A1535 IMon     NUMERIC  RDONLY 0    0 3000 AMPERE -6\n"
+    "CHPARAM  A1535 RUp      NUMERIC  RDWR   50   1 500  VPS\n"
+    "CHPARAM  A1535 RDWn     NUMERIC  RDWR   50   1 500  VPS\n"
+    "CHPARAM  A1535 Trip     NUMERIC  RDWR   10   0 1000 SECOND\n"
+    "CHPARAM  A1535 Pw       ONOFF    RDWR   0    On Off\n"
+    "CHPARAM  A1535 PDwn     ONOFF    RDWR   0    Ramp Kill\n"
+    "CHPARAM  A1535 Status   CHSTATUS RDONLY 0\n"
+    "RAMP     A1535 V0Set VMon Pw RUp RDWn Status IMon 0.5\n"
+    "NOISE    A1535 VMon 0.1\n"
+    "NOISE    A1535 IMon 0.05\n"
+    "SLOT     0 A1535 1001 1.2\n"
+    "SLOT     1 A1535 1002 1.2\n"
+    "SLOT     2 A1535 1003 1.2\n"
+    "SLOT     3 A1535 1004 1.2\n";
+
+const char* getSimCallName(simCall_t call)
+{
+    return simCallNames[call];
+}
+
+// Look up a keyword on a table. It throws if not found.
+template<typename T, std::size_t N>
+static T lookUp(const std::pair<const char*, T> (&table)[N], const std::string& key, const std::string& what)
+{
+    for (std::size_t i(0); i < N; ++i)
+        if ( key == table[i].first )
+            return table[i].second;
+
+    throw std::runtime_error("invalid " + what + " '" + key + "'");
+}
+
+static const std::pair<const char*, uint32_t> paramTypes[] =
+{
+    std::make_pair("NUMERIC",  PARAM_TYPE_NUMERIC),
+    std::make_pair("ONOFF",    PARAM_TYPE_ONOFF),
+    std::make_pair("CHSTATUS", PARAM_TYPE_CHSTATUS),
+    std::make_pair("BDSTATUS", PARAM_TYPE_BDSTATUS),
+    std::make_pair("BINARY",   PARAM_TYPE_BINARY)
+};
+
+static const std::pair<const char*, uint32_t> paramModes[] =
+{
+    std::make_pair("RDONLY", PARAM_MODE_RDONLY),
+    std::make_pair("WRONLY", PARAM_MODE_WRONLY),
+    std::make_pair("RDWR",   PARAM_MODE_RDWR)
+};
+
+static const std::pair<const char*, uint16_t> paramUnits[] =
+{
+    std::make_pair("NONE",    PARAM_UN_NONE),
+    std::make_pair("AMPERE",  PARAM_UN_AMPERE),
+    std::make_pair("VOLT",    PARAM_UN_VOLT),
+    std::make_pair("WATT",    PARAM_UN_WATT),
+    std::make_pair("CELSIUS", PARAM_UN_CELSIUS),
+    std::make_pair("HERTZ",   PARAM_UN_HERTZ),
+    std::make_pair("BAR",     PARAM_UN_BAR),
+    std::make_pair("VPS",     PARAM_UN_VPS),
+    std::make_pair("SECOND",  PARAM_UN_SECOND),
+    std::make_pair("RPM",     PARAM_UN_RPM),
+    std::make_pair("COUNT",   PARAM_UN_COUNT),
+    std::make_pair("BIT",     PARAM_UN_BIT)
+};
+
+static const std::pair<const char*, unsigned> sysPropTypes[] =
+{
+    std::make_pair("STR",     SYSPROP_TYPE_STR),
+    std::make_pair("REAL",    SYSPROP_TYPE_REAL),
+    std::make_pair("UINT2",   SYSPROP_TYPE_UINT2),
+    std::make_pair("UINT4",   SYSPROP_TYPE_UINT4),
+    std::make_pair("INT2",    SYSPROP_TYPE_INT2),
+    std::make_pair("INT4",    SYSPROP_TYPE_INT4),
+    std::make_pair("BOOLEAN", SYSPROP_TYPE_BOOLEAN)
+};
+
+static const std::pair<const char*, unsigned> sysPropModes[] =
+{
+    std::make_pair("RDONLY", SYSPROP_MODE_RDONLY),
+    std::make_pair("WRONLY", SYSPROP_MODE_WRONLY),
+    std::make_pair("RDWR",   SYSPROP_MODE_RDWR)
+};
+
+ISimCrate::ISimCrate(const std::string& fileName)
+:
+  created( std::chrono::steady_clock::now() ),
+  lastUpdate( created ),
+  gen(12345),
+  faultGen(54321),
+  numSlots(0)
+{
+    for (std::size_t i(0); i < NUM_SIM_CALLS; ++i)
+    {
+        faults[i].latency   = 0;
+        faults[i].jitter    = 0;
+        faults[i].errorRate = 0;
+        faults[i].errorCode = CAENHV_TIMEERR;
+    }
+
+    if ( fileName.empty() )
+    {
+        std::istringstream stream(defaultCrate);
+        parse(stream, "(default crate)");
+    }
+    else
+    {
+        std::ifstream file(fileName.c_str());
+
+        if ( ! file.is_open() )
+            throw std::runtime_error("Could not open file '" + fileName + "'");
+
+        parse(file, fileName);
+    }
+
+    // The crate has at least as many slots as the highest occupied slot
+    if ( ( ! boards.empty() ) && ( boards.rbegin()->first >= numSlots ) )
+        numSlots = boards.rbegin()->first + 1;
+
+    for (std::vector<SimSwap>::const_iterator it = swaps.begin(); it != swaps.end(); ++it)
+        if ( it->slot >= numSlots )
+            numSlots = it->slot + 1;
+}
+
+SimCrate ISimCrate::create(const std::string& fileName)
+{
+    return std::make_shared<ISimCrate>(fileName);
+}
+
+void ISimCrate::parse(std::istream& stream, const std::string& fileName)
+{
+    // Each line starts with a keyword, followed by its arguments.
+    // Empty lines and comments are skipped.
+    std::string line;
+    std::size_t lineNumber(0);
+    while ( std::getline(stream, line) )
+    {
+        ++lineNumber;
+
+        std::size_t comment( line.find('#') );
+        if ( comment != std::string::npos )
+            line.erase(comment);
+
+        std::istringstream iss(line);
+        std::string        key;
+
+        if ( ! ( iss >> key ) )
+            continue;
+
+        try
+        {
+            parseLine(iss, key);
+        }
+        catch (std::runtime_error& e)
+        {
+            std::stringstream error;
+            error << "File '" << fileName << "', line " << lineNumber << ": " << e.what();
+            throw std::runtime_error(error.str());
+        }
+    }
+}
+
+// Read the rest of the line, without leading spaces
+static std::string readRest(std::istringstream& iss)
+{
+    std::string rest;
+    std::getline(iss >> std::ws, rest);
+
+    std::size_t end( rest.find_last_not_of(" \t\r") );
+    if ( end == std::string::npos )
+        return "";
+
+    return rest.substr(0, end + 1);
+}
+
+template<typename T>
+static T readArg(std::istringstream& iss, const std::string& what)
+{
+    T value;
+    if ( ! ( iss >> value ) )
+        throw std::runtime_error("missing or invalid " + what);
+
+    return value;
+}
+
+void ISimCrate::parseLine(std::istringstream& iss, const std::string& key)
+{
+    if ( key == "NUMSLOTS" )
+    {
+        numSlots = readArg<std::size_t>(iss, "number of slots");
+    }
+    else if ( key == "SYSPROP" )
+    {
+        SimSysProp p;
+        p.name  = readArg<std::string>(iss, "property name");
+        p.type  = lookUp(sysPropTypes, readArg<std::string>(iss, "property type"), "property type");
+        p.mode  = lookUp(sysPropModes, readArg<std::string>(iss, "property mode"), "property mode");
+        p.strValue = readRest(iss);
+        p.value = strtod(p.strValue.c_str(), NULL);
+        sysProps.push_back(p);
+    }
+    else if ( key == "MODEL" )
+    {
+        std::shared_ptr<SimModel> m( std::make_shared<SimModel>() );
+        m->name        = readArg<std::string>(iss, "model name");
+        m->numChannels = readArg<std::size_t>(iss, "number of channels");
+        m->description = readRest(iss);
+        m->hasRamp     = false;
+
+        if ( findModel(m->name) )
+            throw std::runtime_error("model '" + m->name + "' already defined");
+
+        models.push_back(m);
+    }
+    else if ( ( key == "BDPARAM" ) || ( key == "CHPARAM" ) )
+    {
+        SimModel* m( findModel( readArg<std::string>(iss, "model name") ) );
+        if ( ! m )
+            throw std::runtime_error("undefined model");
+
+        std::vector<SimParamDef>& params( ( key == "BDPARAM" ) ? m->bdParams : m->chParams );
+        SimParamDef               p( parseParam(iss) );
+
+        if ( findParam(params, p.name) >= 0 )
+            throw std::runtime_error("parameter '" + p.name + "' already defined");
+
+        params.push_back(p);
+    }
+    else if ( key == "RAMP" )
+    {
+        SimModel* m( findModel( readArg<std::string>(iss, "model name") ) );
+        if ( ! m )
+            throw std::runtime_error("undefined model");
+
+        int* idx[] = { &m->ramp.vSet, &m->ramp.vMon, &m->ramp.pw, &m->ramp.rUp, &m->ramp.rDwn, &m->ramp.status };
+        for (std::size_t i(0); i < sizeof(idx) / sizeof(idx[0]); ++i)
+        {
+            std::string name( readArg<std::string>(iss, "parameter name") );
+            if ( ( *idx[i] = findParam(m->chParams, name) ) < 0 )
+                throw std::runtime_error("undefined channel parameter '" + name + "'");
+        }
+
+        m->ramp.iMon        = -1;
+        m->ramp.conductance = 0;
+
+        std::string name;
+        if ( iss >> name )
+        {
+            if ( ( m->ramp.iMon = findParam(m->chParams, name) ) < 0 )
+                throw std::runtime_error("undefined channel parameter '" + name + "'");
+
+            m->ramp.conductance = readArg<double>(iss, "conductance");
+        }
+
+        m->hasRamp = true;
+    }
+    else if ( key == "NOISE" )
+    {
+        SimModel* m( findModel( readArg<std::string>(iss, "model name") ) );
+        if ( ! m )
+            throw std::runtime_error("undefined model");
+
+        std::string name( readArg<std::string>(iss, "parameter name") );
+        int         i( findParam(m->chParams, name) );
+        if ( ( i < 0 ) || ( m->chParams.at(i).type != PARAM_TYPE_NUMERIC ) )
+            throw std::runtime_error("undefined numeric channel parameter '" + name + "'");
+
+        m->chParams.at(i).noise = readArg<double>(iss, "noise amplitude");
+    }
+    else if ( key == "SLOT" )
+    {
+        std::size_t slot( readArg<std::size_t>(iss, "slot number") );
+
+        if ( boards.find(slot) != boards.end() )
+            throw std::runtime_error("slot already occupied");
+
+        boards.insert( std::make_pair(slot, newBoard(iss)) );
+    }
+    else if ( key == "SWAP" )
+    {
+        SimSwap w;
+        w.time = readArg<double>(iss, "swap time");
+        w.slot = readArg<std::size_t>(iss, "slot number");
+        w.done = false;
+
+        // A '-' instead of the board removes the board from the slot
+        iss >> std::ws;
+        w.empty = ( iss.peek() == '-' );
+        if ( ! w.empty )
+            w.board = newBoard(iss);
+
+        swaps.push_back(w);
+    }
+    else if ( ( key == "STATUS" ) || ( key == "TRIP" ) )
+    {
+        std::string slot( readArg<std::string>(iss, "slot number") );
+        std::string channel( readArg<std::string>(iss, "channel number") );
+
+        // Status bits can be given in decimal, octal, or hexadecimal
+        std::string value( readArg<std::string>(iss, ( key == "STATUS" ) ? "status bits" : "trip time") );
+
+        std::vector<SimChannel*> channels( selectChannels(slot, channel) );
+        for (std::vector<SimChannel*>::iterator it = channels.begin(); it != channels.end(); ++it)
+        {
+            if ( key == "STATUS" )
+                (*it)->forcedStatus = strtoul(value.c_str(), NULL, 0);
+            else
+                (*it)->tripTime = strtod(value.c_str(), NULL);
+        }
+    }
+    else if ( ( key == "LATENCY" ) || ( key == "ERROR" ) )
+    {
+        std::string call( readArg<std::string>(iss, "call name") );
+        double      value( readArg<double>(iss, ( key == "LATENCY" ) ? "latency" : "error rate") );
+        double      extra;
+        bool        hasExtra( iss >> extra );
+
+        bool found(false);
+        for (std::size_t i(0); i < NUM_SIM_CALLS; ++i)
+        {
+            if ( ( call != "*" ) && ( call != simCallNames[i] ) )
+                continue;
+
+            found = true;
+            if ( key == "LATENCY" )
+            {
+                // Latencies are given in milliseconds
+                faults[i].latency = value / 1000.0;
+                faults[i].jitter  = hasExtra ? ( extra / 1000.0 ) : 0;
+            }
+            else
+            {
+                faults[i].errorRate = value;
+                if ( hasExtra )
+                    faults[i].errorCode = static_cast<int>(extra);
+            }
+        }
+
+        if ( ! found )
+            throw std::runtime_error("invalid call name '" + call + "'");
+    }
+    else if ( key == "OUTAGE" )
+    {
+        SimOutage o;
+        o.start    = readArg<double>(iss, "outage start time");
+        o.duration = readArg<double>(iss, "outage duration");
+        if ( ! ( iss >> o.period ) )
+            o.period = 0;
+
+        if ( ( o.period > 0 ) && ( o.period <= o.duration ) )
+            throw std::runtime_error("the outage period must be longer than its duration");
+
+        outages.push_back(o);
+    }
+    else if ( key == "SLOWSLOT" )
+    {
+        SimSlowSlot s;
+        s.slot     = readArg<std::size_t>(iss, "slot number");
+        // Latencies are given in milliseconds
+        s.latency  = readArg<double>(iss, "latency") / 1000.0;
+        if ( iss >> s.start )
+            s.duration = readArg<double>(iss, "slow slot duration");
+        else
+        {
+            s.start    = 0;
+            s.duration = 0;
+        }
+
+        slowSlots.push_back(s);
+    }
+    else
+    {
+        throw std::runtime_error("invalid keyword '" + key + "'");
+    }
+}
+
+SimParamDef ISimCrate::parseParam(std::istringstream& iss)
+{
+    // <NAME> <TYPE> <MODE> <VALUE> [<MIN> <MAX> <UNIT> [<EXP>] | <ONSTATE> <OFFSTATE>]
+    SimParamDef p;
+    p.name   = readArg<std::string>(iss, "parameter name");
+    p.type   = lookUp(paramTypes, readArg<std::string>(iss, "parameter type"), "parameter type");
+    p.mode   = lookUp(paramModes, readArg<std::string>(iss, "parameter mode"), "parameter mode");
+    p.value  = readArg<double>(iss, "parameter value");
+    p.minVal = 0;
+    p.maxVal = 0;
+    p.unit   = PARAM_UN_NONE;
+    p.exp    = 0;
+    p.noise  = 0;
+
+    if ( p.name.size() >= MAX_PARAM_NAME )
+        throw std::runtime_error("parameter name '" + p.name + "' too long");
+
+    if ( p.type == PARAM_TYPE_NUMERIC )
+    {
+        p.minVal = readArg<float>(iss, "minimum value");
+        p.maxVal = readArg<float>(iss, "maximum value");
+
+        std::string unit;
+        if ( iss >> unit )
+            p.unit = lookUp(paramUnits, unit, "unit");
+
+        int exp;
+        if ( iss >> exp )
+            p.exp = exp;
+    }
+    else if ( p.type == PARAM_TYPE_ONOFF )
+    {
+        p.onState  = readArg<std::string>(iss, "on state label");
+        p.offState = readArg<std::string>(iss, "off state label");
+    }
+
+    return p;
+}
+
+SimModel* ISimCrate::findModel(const std::string& name)
+{
+    for (std::vector< std::shared_ptr<SimModel> >::iterator it = models.begin(); it != models.end(); ++it)
+        if ( (*it)->name == name )
+            return it->get();
+
+    return NULL;
+}
+
+SimBoard ISimCrate::newBoard(std::istringstream& iss)
+{
+    // <MODEL> <SERIAL_NUMBER> <FIRMWARE_RELEASE>
+    SimModel* m( findModel( readArg<std::string>(iss, "model name") ) );
+    if ( ! m )
+        throw std::runtime_error("undefined model");
+
+    SimBoard b;
+    b.model        = m;
+    b.serialNumber = readArg<uint16_t>(iss, "serial number");
+
+    // Firmware release, as <major>.<minor>
+    std::string fw( readArg<std::string>(iss, "firmware release") );
+    b.fwMajor = strtoul(fw.c_str(), NULL, 10);
+    b.fwMinor = ( fw.find('.') != std::string::npos ) ? strtoul(fw.c_str() + fw.find('.') + 1, NULL, 10) : 0;
+
+    for (std::vector<SimParamDef>::const_iterator it = m->bdParams.begin(); it != m->bdParams.end(); ++it)
+        b.values.push_back(it->value);
+
+    SimChannel c;
+    c.forcedStatus = 0;
+    c.tripTime     = -1;
+    c.tripped      = false;
+    for (std::vector<SimParamDef>::const_iterator it = m->chParams.begin(); it != m->chParams.end(); ++it)
+        c.values.push_back(it->value);
+
+    b.channels.assign(m->numChannels, c);
+
+    return b;
+}
+
+int ISimCrate::findParam(const std::vector<SimParamDef>& params, const std::string& name)
+{
+    for (std::size_t i(0); i < params.size(); ++i)
+        if ( params.at(i).name == name )
+            return i;
+
+    return -1;
+}
+
+std::vector<SimChannel*> ISimCrate::selectChannels(const std::string& slotStr, const std::string& channelStr)
+{
+    // A '*' selects all the slots, or all the channels
+    std::vector<SimChannel*> channels;
+
+    for (std::map<std::size_t, SimBoard>::iterator it = boards.begin(); it != boards.end(); ++it)
+    {
+        if ( ( slotStr != "*" ) && ( it->first != strtoul(slotStr.c_str(), NULL, 10) ) )
+            continue;
+
+        for (std::size_t c(0); c < it->second.channels.size(); ++c)
+            if ( ( channelStr == "*" ) || ( c == strtoul(channelStr.c_str(), NULL, 10) ) )
+                channels.push_back( &it->second.channels.at(c) );
+    }
+
+    if ( channels.empty() )
+        throw std::runtime_error("no channel found in slot '" + slotStr + "', channel '" + channelStr + "'");
+
+    return channels;
+}
+
+double ISimCrate::elapsed() const
+{
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() - created ).count();
+}
+
+double ISimCrate::noise(double amplitude)
+{
+    if ( amplitude <= 0 )
+        return 0;
+
+    return std::uniform_real_distribution<double>(-amplitude, amplitude)(gen);
+}
+
+bool ISimCrate::isDown() const
+{
+    if ( outages.empty() )
+        return false;
+
+    double t( elapsed() );
+
+    for (std::vector<SimOutage>::const_iterator it = outages.begin(); it != outages.end(); ++it)
+    {
+        if ( t < it->start )
+            continue;
+
+        double s( t - it->start );
+        if ( it->period > 0 )
+            s = fmod(s, it->period);
+
+        if ( s < it->duration )
+            return true;
+    }
+
+    return false;
+}
+
+double ISimCrate::getDelay(simCall_t call)
+{
+    double delay( faults[call].latency );
+
+    if ( faults[call].jitter > 0 )
+    {
+        faultMutex.lock();
+        delay += std::uniform_real_distribution<double>(0, faults[call].jitter)(faultGen);
+        faultMutex.unlock();
+    }
+
+    return delay;
+}
+
+double ISimCrate::getSlotDelay(std::size_t slot) const
+{
+    if ( slowSlots.empty() )
+        return 0;
+
+    double t( elapsed() );
+    double delay(0);
+
+    for (std::vector<SimSlowSlot>::const_iterator it = slowSlots.begin(); it != slowSlots.end(); ++it)
+    {
+        if ( ( it->slot != slot ) || ( t < it->start ) )
+            continue;
+
+        if ( ( it->duration > 0 ) && ( t >= it->start + it->duration ) )
+            continue;
+
+        delay += it->latency;
+    }
+
+    return delay;
+}
+
+bool ISimCrate::injectError(simCall_t call)
+{
+    if ( faults[call].errorRate <= 0 )
+        return false;
+
+    faultMutex.lock();
+    bool error( std::uniform_real_distribution<double>(0, 1)(faultGen) < faults[call].errorRate );
+    faultMutex.unlock();
+
+    return error;
+}
+
+void ISimCrate::update()
+{
+    std::chrono::steady_clock::time_point now( std::chrono::steady_clock::now() );
+    double dt( std::chrono::duration<double>( now - lastUpdate ).count() );
+    double t( std::chrono::duration<double>( now - created ).count() );
+    lastUpdate = now;
+
+    // Boards swapped since the last update
+    for (std::vector<SimSwap>::iterator it = swaps.begin(); it != swaps.end(); ++it)
+    {
+        if ( it->done || ( t < it->time ) )
+            continue;
+
+        boards.erase(it->slot);
+        if ( ! it->empty )
+            boards.insert( std::make_pair(it->slot, it->board) );
+
+        it->done = true;
+    }
+
+    for (std::map<std::size_t, SimBoard>::iterator bIt = boards.begin(); bIt != boards.end(); ++bIt)
+    {
+        const SimModel* m( bIt->second.model );
+
+        if ( ! m->hasRamp )
+            continue;
+
+        const SimRampDef& r( m->ramp );
+
+        for (std::vector<SimChannel>::iterator cIt = bIt->second.channels.begin(); cIt != bIt->second.channels.end(); ++cIt)
+        {
+            std::vector<double>& v( cIt->values );
+
+            // The channel trips once, at the configured time, turning off its output
+            if ( ( cIt->tripTime >= 0 ) && ( t >= cIt->tripTime ) && ( ! cIt->tripped ) )
+            {
+                cIt->tripped  = true;
+                cIt->tripTime = -1;
+                v.at(r.pw)    = 0;
+            }
+
+            bool   on( v.at(r.pw) != 0 );
+            double target( on ? v.at(r.vSet) : 0 );
+            double vMon( v.at(r.vMon) );
+            bool   up( vMon < target );
+            bool   down( vMon > target );
+
+            // The voltage changes at the configured ramp rates. A rate of zero
+            // means that the voltage changes immediately.
+            double rate( up ? v.at(r.rUp) : v.at(r.rDwn) );
+            if ( up )
+                vMon = ( rate > 0 ) ? std::min(target, vMon + rate * dt) : target;
+            else if ( down )
+                vMon = ( rate > 0 ) ? std::max(target, vMon - rate * dt) : target;
+
+            v.at(r.vMon) = vMon;
+
+            if ( r.iMon >= 0 )
+                v.at(r.iMon) = r.conductance * vMon;
+
+            uint32_t status( cIt->forcedStatus );
+            if ( on )
+                status |= SIM_STATUS_ON;
+            if ( vMon < target )
+                status |= SIM_STATUS_RUP;
+            else if ( vMon > target )
+                status |= SIM_STATUS_RDW;
+            if ( cIt->tripped )
+                status |= SIM_STATUS_TRIP;
+
+            v.at(r.status) = status;
+        }
+    }
+}
+
+const SimBoard* ISimCrate::getBoard(std::size_t slot) const
+{
+    std::map<std::size_t, SimBoard>::const_iterator it( boards.find(slot) );
+
+    if ( it == boards.end() )
+        return NULL;
+
+    return &it->second;
+}
+
+int ISimCrate::readValue(const SimParamDef& def, double value, void* dest)
+{
+    if ( def.mode == PARAM_MODE_WRONLY )
+        return CAENHV_READERR;
+
+    // Numeric parameters are floats, the rest of them are 32-bit integers
+    if ( def.type == PARAM_TYPE_NUMERIC )
+        *static_cast<float*>(dest) = value + noise(def.noise);
+    else if ( def.type == PARAM_TYPE_BINARY )
+        *static_cast<int32_t*>(dest) = static_cast<int32_t>(value);
+    else
+        *static_cast<uint32_t*>(dest) = static_cast<uint32_t>(value);
+
+    return CAENHV_OK;
+}
+
+int ISimCrate::writeValue(const SimParamDef& def, double& value, const void* src)
+{
+    if ( def.mode == PARAM_MODE_RDONLY )
+        return CAENHV_WRITEERR;
+
+    if ( def.type == PARAM_TYPE_NUMERIC )
+    {
+        float v( *static_cast<const float*>(src) );
+
+        if ( ( v < def.minVal ) || ( v > def.maxVal ) )
+            return CAENHV_OUTOFRANGE;
+
+        value = v;
+    }
+    else if ( def.type == PARAM_TYPE_BINARY )
+        value = *static_cast<const int32_t*>(src);
+    else
+        value = *static_cast<const uint32_t*>(src);
+
+    return CAENHV_OK;
+}
+
+int ISimCrate::getParamProp(const SimParamDef& def, const std::string& prop, void* value)
+{
+    if ( prop == "Type" )
+        *static_cast<uint32_t*>(value) = def.type;
+    else if ( prop == "Mode" )
+        *static_cast<uint32_t*>(value) = def.mode;
+    else if ( ( def.type == PARAM_TYPE_NUMERIC ) && ( prop == "Minval" ) )
+        *static_cast<float*>(value) = def.minVal;
+    else if ( ( def.type == PARAM_TYPE_NUMERIC ) && ( prop == "Maxval" ) )
+        *static_cast<float*>(value) = def.maxVal;
+    else if ( ( def.type == PARAM_TYPE_NUMERIC ) && ( prop == "Unit" ) )
+        *static_cast<uint16_t*>(value) = def.unit;
+    else if ( ( def.type == PARAM_TYPE_NUMERIC ) && ( prop == "Exp" ) )
+        *static_cast<int8_t*>(value) = def.exp;
+    else if ( ( def.type == PARAM_TYPE_ONOFF ) && ( prop == "Onstate" ) )
+        strcpy(static_cast<char*>(value), def.onState.c_str());
+    else if ( ( def.type == PARAM_TYPE_ONOFF ) && ( prop == "Offstate" ) )
+        strcpy(static_cast<char*>(value), def.offState.c_str());
+    else
+        return CAENHV_PARAMPROPNOTFOUND;
+
+    return CAENHV_OK;
+}
+
+int ISimCrate::getSysProp(const std::string& name, void* value) const
+{
+    for (std::vector<SimSysProp>::const_iterator it = sysProps.begin(); it != sysProps.end(); ++it)
+    {
+        if ( it->name != name )
+            continue;
+
+        if ( it->mode == SYSPROP_MODE_WRONLY )
+            return CAENHV_NOTGETPROP;
+
+        switch ( it->type )
+        {
+            case SYSPROP_TYPE_STR:     strcpy(static_cast<char*>(value), it->strValue.c_str()); break;
+            case SYSPROP_TYPE_REAL:    *static_cast<float*>(value)    = it->value; break;
+            case SYSPROP_TYPE_UINT2:   *static_cast<uint16_t*>(value) = it->value; break;
+            case SYSPROP_TYPE_UINT4:   *static_cast<uint32_t*>(value) = it->value; break;
+            case SYSPROP_TYPE_INT2:    *static_cast<int16_t*>(value)  = it->value; break;
+            case SYSPROP_TYPE_INT4:    *static_cast<int32_t*>(value)  = it->value; break;
+            case SYSPROP_TYPE_BOOLEAN: *static_cast<uint8_t*>(value)  = it->value; break;
+        }
+
+        return CAENHV_OK;
+    }
+
+    return CAENHV_NOTSYSPROP;
+}
+
+int ISimCrate::setSysProp(const std::string& name, const void* value)
+{
+    for (std::vector<SimSysProp>::iterator it = sysProps.begin(); it != sysProps.end(); ++it)
+    {
+        if ( it->name != name )
+            continue;
+
+        if ( it->mode == SYSPROP_MODE_RDONLY )
+            return CAENHV_NOTSETPROP;
+
+        switch ( it->type )
+        {
+            case SYSPROP_TYPE_STR:     it->strValue = static_cast<const char*>(value); break;
+            case SYSPROP_TYPE_REAL:    it->value = *static_cast<const float*>(value); break;
+            case SYSPROP_TYPE_UINT2:   it->value = *static_cast<const uint16_t*>(value); break;
+            case SYSPROP_TYPE_UINT4:   it->value = *static_cast<const uint32_t*>(value); break;
+            case SYSPROP_TYPE_INT2:    it->value = *static_cast<const int16_t*>(value); break;
+            case SYSPROP_TYPE_INT4:    it->value = *static_cast<const int32_t*>(value); break;
+            case SYSPROP_TYPE_BOOLEAN: it->value = *static_cast<const uint8_t*>(value); break;
+        }
+
+        return CAENHV_OK;
+    }
+
+    return CAENHV_NOTSYSPROP;
+}
+
+int ISimCrate::getBdParam(std::size_t slot, const std::string& name, void* value)
+{
+    std::map<std::size_t, SimBoard>::iterator it( boards.find(slot) );
+    if ( it == boards.end() )
+        return CAENHV_SLOTNOTPRES;
+
+    int i( findParam(it->second.model->bdParams, name) );
+    if ( i < 0 )
+        return CAENHV_PARAMNOTFOUND;
+
+    return readValue(it->second.model->bdParams.at(i), it->second.values.at(i), value);
+}
+
+int ISimCrate::setBdParam(std::size_t slot, const std::string& name, const void* value)
+{
+    std::map<std::size_t, SimBoard>::iterator it( boards.find(slot) );
+    if ( it == boards.end() )
+        return CAENHV_SLOTNOTPRES;
+
+    int i( findParam(it->second.model->bdParams, name) );
+    if ( i < 0 )
+        return CAENHV_PARAMNOTFOUND;
+
+    return writeValue(it->second.model->bdParams.at(i), it->second.values.at(i), value);
+}
+
+int ISimCrate::getBdParamProp(std::size_t slot, const std::string& name, const std::string& prop, void* value) const
+{
+    const SimBoard* b( getBoard(slot) );
+    if ( ! b )
+        return CAENHV_SLOTNOTPRES;
+
+    int i( findParam(b->model->bdParams, name) );
+    if ( i < 0 )
+        return CAENHV_PARAMNOTFOUND;
+
+    return getParamProp(b->model->bdParams.at(i), prop, value);
+}
+
+int ISimCrate::getChParam(std::size_t slot, std::size_t channel, const std::string& name, void* value)
+{
+    std::map<std::size_t, SimBoard>::iterator it( boards.find(slot) );
+    if ( it == boards.end() )
+        return CAENHV_SLOTNOTPRES;
+
+    if ( channel >= it->second.channels.size() )
+        return CAENHV_OUTOFRANGE;
+
+    int i( findParam(it->second.model->chParams, name) );
+    if ( i < 0 )
+        return CAENHV_PARAMNOTFOUND;
+
+    return readValue(it->second.model->chParams.at(i), it->second.channels.at(channel).values.at(i), value);
+}
+
+int ISimCrate::setChParam(std::size_t slot, std::size_t channel, const std::string& name, const void* value)
+{
+    std::map<std::size_t, SimBoard>::iterator it( boards.find(slot) );
+    if ( it == boards.end() )
+        return CAENHV_SLOTNOTPRES;
+
+    if ( channel >= it->second.channels.size() )
+        return CAENHV_OUTOFRANGE;
+
+    int i( findParam(it->second.model->chParams, name) );
+    if ( i < 0 )
+        return CAENHV_PARAMNOTFOUND;
+
+    SimChannel& c( it->second.channels.at(channel) );
+    int         r( writeValue(it->second.model->chParams.at(i), c.values.at(i), value) );
+
+    // Turning on a tripped channel clears the trip
+    if ( ( r == CAENHV_OK ) && it->second.model->hasRamp && ( i == it->second.model->ramp.pw ) && ( c.values.at(i) != 0 ) )
+        c.tripped = false;
+
+    return r;
+}
+
+int ISimCrate::getChParamProp(std::size_t slot, std::size_t channel, const std::string& name, const std::string& prop, void* value) const
+{
+    const SimBoard* b( getBoard(slot) );
+    if ( ! b )
+        return CAENHV_SLOTNOTPRES;
+
+    if ( channel >= b->channels.size() )
+        return CAENHV_OUTOFRANGE;
+
+    int i( findParam(b->model->chParams, name) );
+    if ( i < 0 )
+        return CAENHV_PARAMNOTFOUND;
+
+    return getParamProp(b->model->chParams.at(i), prop, value);
+}
+
+bool ISimCrate::getEventValue(SimEventValue& v)
+{
+    std::map<std::size_t, SimBoard>::iterator it( boards.find(v.slot) );
+    if ( it == boards.end() )
+        return false;
+
+    const std::vector<SimParamDef>& params( ( v.channel < 0 ) ? it->second.model->bdParams : it->second.model->chParams );
+
+    int i( findParam(params, v.param) );
+    if ( i < 0 )
+        return false;
+
+    if ( ( v.channel >= 0 ) && ( static_cast<std::size_t>(v.channel) >= it->second.channels.size() ) )
+        return false;
+
+    const SimParamDef& def( params.at(i) );
+    v.isFloat = ( def.type == PARAM_TYPE_NUMERIC );
+
+    if ( v.channel < 0 )
+        v.value = it->second.values.at(i);
+    else
+        v.value = it->second.channels.at(v.channel).values.at(i) + noise(def.noise);
+
+    return true;
+}
+
+void ISimCrate::printInfo(std::ostream& stream) const
+{
+    stream << "Simulated crate: " << numSlots << " slots, " << boards.size() << " boards, " << sysProps.size() << " system properties" << std::endl;
+
+    for (std::map<std::size_t, SimBoard>::const_iterator it = boards.begin(); it != boards.end(); ++it)
+        stream << "    Slot " << it->first << ": " << it->second.model->name \
+               << ", " << it->second.channels.size() << " channels" \
+               << ", " << it->second.model->bdParams.size() << " board parameters" \
+               << ", " << it->second.model->chParams.size() << " channel parameters" << std::endl;
+
+    for (std::size_t i(0); i < NUM_SIM_CALLS; ++i)
+        if ( ( faults[i].latency > 0 ) || ( faults[i].errorRate > 0 ) )
+            stream << "    " << simCallNames[i] << ": latency = " << 1000 * faults[i].latency \
+                   << " ms (+ up to " << 1000 * faults[i].jitter << " ms), error rate = " << faults[i].errorRate \
+                   << " (code " << faults[i].errorCode << ")" << std::endl;
+
+    for (std::vector<SimOutage>::const_iterator it = outages.begin(); it != outages.end(); ++it)
+    {
+        stream << "    Outage: start = " << it->start << " s, duration = " << it->duration << " s";
+        if ( it->period > 0 )
+            stream << ", period = " << it->period << " s";
+        stream << std::endl;
+    }
+
+    for (std::vector<SimSlowSlot>::const_iterator it = slowSlots.begin(); it != slowSlots.end(); ++it)
+    {
+        stream << "    Slow slot " << it->slot << ": latency = " << 1000 * it->latency << " ms";
+        if ( it->duration > 0 )
+            stream << ", start = " << it->start << " s, duration = " << it->duration << " s";
+        stream << std::endl;
+    }
+
+    for (std::vector<SimSwap>::const_iterator it = swaps.begin(); it != swaps.end(); ++it)
+    {
+        stream << "    Swap: time = " << it->time << " s, slot " << it->slot << ": ";
+        if ( it->empty )
+            stream << "removed";
+        else
+            stream << it->board.model->name << ", serial number " << it->board.serialNumber;
+        stream << std::endl;
+    }
+}
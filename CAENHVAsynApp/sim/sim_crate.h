@@ -0,0 +1,272 @@
+#ifndef SIM_CRATE_H
+#define SIM_CRATE_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : sim_crate.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Simulated CAEN HV Power supply crate.
+ * The crate content (system properties, board models, their board and channel
+ * parameters, and the occupied slots), the channel dynamics, and the faults
+ * injected on each call (latency, errors, and link outages) are defined in a
+ * configuration file, as well as the boards swapped while the crate is running. It is used by the simulated CAEN HV Wrapper library.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <chrono>
+#include <iostream>
+#include <stdint.h>
+#include "CAENHVWrapper.h"
+
+class ISimCrate;
+
+typedef std::shared_ptr<ISimCrate> SimCrate;
+
+// Calls to the library. Latency and errors can be injected on each of them.
+enum simCall_t
+{
+    SIM_INIT_SYSTEM,
+    SIM_GET_SYS_PROP_LIST,
+    SIM_GET_SYS_PROP_INFO,
+    SIM_GET_CRATE_MAP,
+    SIM_GET_BD_PARAM_INFO,
+    SIM_GET_BD_PARAM_PROP,
+    SIM_GET_CH_PARAM_INFO,
+    SIM_GET_CH_PARAM_PROP,
+    SIM_GET_SYS_PROP,
+    SIM_SET_SYS_PROP,
+    SIM_GET_BD_PARAM,
+    SIM_SET_BD_PARAM,
+    SIM_GET_CH_PARAM,
+    SIM_SET_CH_PARAM,
+    SIM_SUBSCRIBE_CH_PARAMS,
+    SIM_SUBSCRIBE_BD_PARAMS,
+    SIM_GET_EVENT_DATA,
+    NUM_SIM_CALLS
+};
+
+// Name of a call, as used in the configuration file
+const char* getSimCallName(simCall_t call);
+
+// Channel status bits set by the simulated channel dynamics
+enum
+{
+    SIM_STATUS_ON   = 0x001,
+    SIM_STATUS_RUP  = 0x002,
+    SIM_STATUS_RDW  = 0x004,
+    SIM_STATUS_TRIP = 0x200
+};
+
+// Definition of a board or channel parameter
+struct SimParamDef
+{
+    std::string name;
+    uint32_t    type;
+    uint32_t    mode;
+    double      value;      // Initial value
+    float       minVal;
+    float       maxVal;
+    uint16_t    unit;
+    int8_t      exp;
+    std::string onState;
+    std::string offState;
+    double      noise;      // Amplitude of the noise added on each read
+};
+
+// Channel parameters driven by the channel dynamics, given by their
+// index on the list of channel parameters of the model
+struct SimRampDef
+{
+    int    vSet;
+    int    vMon;
+    int    pw;
+    int    rUp;
+    int    rDwn;
+    int    status;
+    int    iMon;            // -1 if the current is not simulated
+    double conductance;     // iMon = conductance * vMon
+};
+
+// Board model
+struct SimModel
+{
+    std::string              name;
+    std::string              description;
+    std::size_t              numChannels;
+    std::vector<SimParamDef> bdParams;
+    std::vector<SimParamDef> chParams;
+    bool                     hasRamp;
+    SimRampDef               ramp;
+};
+
+// Simulated channel
+struct SimChannel
+{
+    std::vector<double> values;         // One value per channel parameter of the model
+    uint32_t            forcedStatus;   // Status bits always set
+    double              tripTime;       // Time, since the crate was created, at which the channel trips. Negative if never.
+    bool                tripped;
+};
+
+// Simulated board
+struct SimBoard
+{
+    const SimModel*         model;
+    uint16_t                serialNumber;
+    uint8_t                 fwMajor;
+    uint8_t                 fwMinor;
+    std::vector<double>     values;     // One value per board parameter of the model
+    std::vector<SimChannel> channels;
+};
+
+// System property
+struct SimSysProp
+{
+    std::string name;
+    unsigned    type;
+    unsigned    mode;
+    double      value;
+    std::string strValue;
+};
+
+// Faults injected on a call
+struct SimCallFault
+{
+    double latency;     // Seconds
+    double jitter;      // Seconds, uniformly distributed
+    double errorRate;   // Probability of failing a call
+    int    errorCode;
+};
+
+// Period of time during which the link to the crate is down
+struct SimOutage
+{
+    double start;       // Seconds since the crate was created
+    double duration;    // Seconds
+    double period;      // Repetition period, in seconds. Zero if it happens only once.
+};
+
+// Latency added to the board and channel calls on a slot
+struct SimSlowSlot
+{
+    std::size_t slot;
+    double      latency;    // Seconds
+    double      start;      // Seconds since the crate was created
+    double      duration;   // Seconds. Zero if it lasts forever.
+};
+
+// Board swapped in a slot while the crate is running
+struct SimSwap
+{
+    double      time;       // Seconds since the crate was created
+    std::size_t slot;
+    bool        empty;      // The board is removed, and the slot left empty
+    SimBoard    board;
+    bool        done;
+};
+
+// Value sent on a parameter event
+struct SimEventValue
+{
+    int         slot;
+    int         channel;    // -1 for board parameters
+    std::string param;
+    bool        isFloat;
+    double      value;
+};
+
+class ISimCrate
+{
+public:
+    ISimCrate(const std::string& fileName);
+    ~ISimCrate() {};
+
+    // Factory method. An empty file name creates the default crate.
+    static SimCrate create(const std::string& fileName);
+
+    // Faults injected on a call. These methods can be called without holding the lock.
+    const SimCallFault& getFault(simCall_t call) const { return faults[call]; };
+    double              getDelay(simCall_t call);
+    double              getSlotDelay(std::size_t slot) const;
+    bool                isDown() const;
+    bool                injectError(simCall_t call);
+
+    // All the following methods must be called holding the lock
+    void lock()   { mutex.lock();   };
+    void unlock() { mutex.unlock(); };
+
+    // Advance the channel dynamics up to the current time
+    void update();
+
+    std::size_t                    getNumSlots()  const { return numSlots; };
+    const std::vector<SimSysProp>& getSysProps()  const { return sysProps; };
+    const SimBoard*                getBoard(std::size_t slot) const;
+
+    // Return a CAENHV error code
+    int getSysProp(const std::string& name, void* value) const;
+    int setSysProp(const std::string& name, const void* value);
+    int getBdParam(std::size_t slot, const std::string& name, void* value);
+    int setBdParam(std::size_t slot, const std::string& name, const void* value);
+    int getBdParamProp(std::size_t slot, const std::string& name, const std::string& prop, void* value) const;
+    int getChParam(std::size_t slot, std::size_t channel, const std::string& name, void* value);
+    int setChParam(std::size_t slot, std::size_t channel, const std::string& name, const void* value);
+    int getChParamProp(std::size_t slot, std::size_t channel, const std::string& name, const std::string& prop, void* value) const;
+
+    // Current value of a board (channel = -1) or channel parameter, for the events
+    bool getEventValue(SimEventValue& v);
+
+    // Print the crate definition
+    void printInfo(std::ostream& stream) const;
+
+private:
+    void parse(std::istream& stream, const std::string& fileName);
+    void parseLine(std::istringstream& iss, const std::string& key);
+    SimModel*          findModel(const std::string& name);
+    SimBoard           newBoard(std::istringstream& iss);
+    static int         findParam(const std::vector<SimParamDef>& params, const std::string& name);
+    static SimParamDef parseParam(std::istringstream& iss);
+    int                readValue(const SimParamDef& def, double value, void* dest);
+    static int         writeValue(const SimParamDef& def, double& value, const void* src);
+    static int         getParamProp(const SimParamDef& def, const std::string& prop, void* value);
+    std::vector<SimChannel*> selectChannels(const std::string& slotStr, const std::string& channelStr);
+    double             elapsed() const;
+    double             noise(double amplitude);
+
+    std::mutex                                     mutex;
+    std::mutex                                     faultMutex;
+    std::chrono::steady_clock::time_point          created;
+    std::chrono::steady_clock::time_point          lastUpdate;
+    std::mt19937                                   gen;
+    std::mt19937                                   faultGen;
+    std::size_t                                    numSlots;
+    std::vector<SimSysProp>                        sysProps;
+    std::vector< std::shared_ptr<SimModel> >       models;
+    std::map<std::size_t, SimBoard>                boards;
+    SimCallFault                                   faults[NUM_SIM_CALLS];
+    std::vector<SimOutage>                         outages;
+    std::vector<SimSlowSlot>                       slowSlots;
+    std::vector<SimSwap>                           swaps;
+};
+
+#endif
@@ -21,7 +21,7 @@
 
 #include "board.h"
 
-IBoard::IBoard(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw)
+IBoard::IBoard(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw, std::size_t cw, ParamDescriptorRegistry r)
 :
     handle(h),
     slot(s),
@@ -29,19 +29,76 @@ IBoard::IBoard(int h, std::size_t s, std::string m, std::string d, std::size_t n
     description(d),
     numChannels(n),
     serialNumber(sn),
-    firmwareRelease(fw)
+    firmwareRelease(fw),
+    channelWorkers(cw),
+    registry(r)
 {
     GetBoardParams();
     GetBoardChannels();
 }
 
+IBoard::IBoard(int h, const BoardInfo& info, ParamDescriptorRegistry r)
+:
+    handle(h),
+    slot(info.slot),
+    model(info.model),
+    description(info.description),
+    numChannels(info.numChannels),
+    serialNumber(info.serialNumber),
+    firmwareRelease(info.firmwareRelease),
+    channelWorkers(1),
+    registry(r)
+{
+    for (std::vector<ParamInfo>::const_iterator it = info.params.begin(); it != info.params.end(); ++it)
+        AddBoardParam(*it);
+
+    // Consecutive channels with the same parameters share the same table of descriptors
+    ParamDescriptorTable table;
+    for (std::size_t i(0); i < numChannels; ++i)
+    {
+        const std::vector<ParamInfo>& channelInfo( info.channelParams.at(i) );
+
+        if ( ( ! table ) || ( *table != channelInfo ) )
+        {
+            if ( registry )
+                table = registry->add(model, firmwareRelease, channelInfo);
+            else
+                table = std::make_shared< const std::vector<ParamInfo> >(channelInfo);
+        }
+
+        channels.push_back( IChannel::create(handle, slot, i, table) );
+    }
+}
+
 IBoard::~IBoard()
 {
 }
 
-Board IBoard::create(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw)
+Board IBoard::create(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw, std::size_t cw, ParamDescriptorRegistry r)
 {
-    return std::make_shared<IBoard>(h, s, m, d, n, sn, fw);
+    return std::make_shared<IBoard>(h, s, m, d, n, sn, fw, cw, r);
+}
+
+Board IBoard::create(int h, const BoardInfo& info, ParamDescriptorRegistry r)
+{
+    return std::make_shared<IBoard>(h, info, r);
+}
+
+BoardInfo IBoard::getInfo() const
+{
+    BoardInfo info;
+    info.slot            = slot;
+    info.model           = model;
+    info.description     = description;
+    info.numChannels     = numChannels;
+    info.serialNumber    = serialNumber;
+    info.firmwareRelease = firmwareRelease;
+    info.params          = paramInfo;
+
+    for (std::vector<Channel>::const_iterator it = channels.begin(); it != channels.end(); ++it)
+        info.channelParams.push_back( (*it)->getParamInfo() );
+
+    return info;
 }
 
 void IBoard::printInfo(std::ostream& stream) const
@@ -90,10 +147,10 @@ void IBoard::GetBoardParams()
     std::string functionName("GetBoardParams");
 
     char *ParNameList = (char *)NULL;
-    CAENHVRESULT r = CAENHV_GetBdParamInfo(handle, slot, &ParNameList);
+    CAENHVRESULT r = linkCall(WIRE_GET_BD_PARAM_INFO, handle, [&](int libHandle) { return CAENHV_GetBdParamInfo(libHandle, slot, &ParNameList); });
 
     std::stringstream retMessage;
-    retMessage << "CAENHV_GetBdParamInfo (slot = " << slot << ") : " << CAENHV_GetError(handle) << " (num. " << r << ")";
+    retMessage << "CAENHV_GetBdParamInfo (slot = " << slot << ") : " << linkError(handle) << " (num. " << r << ")";
 
     printMessage(functionName, retMessage.str().c_str());
 
@@ -110,32 +167,111 @@ void IBoard::GetBoardParams()
     {
         uint32_t type, mode;
 
-        if ( CAENHV_GetBdParamProp(handle, slot, p[i], "Type", &type) != CAENHV_OK )
-            throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+        if ( linkCall(WIRE_GET_BD_PARAM_PROP, handle, [&](int libHandle) { return CAENHV_GetBdParamProp(libHandle, slot, p[i], "Type", &type); }) != CAENHV_OK )
+            throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(handle)));
+
+        if (linkCall(WIRE_GET_BD_PARAM_PROP, handle, [&](int libHandle) { return CAENHV_GetBdParamProp(libHandle, slot, p[i], "Mode", &mode); }) != CAENHV_OK )
+            throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(handle)));
 
-        if (CAENHV_GetBdParamProp(handle, slot, p[i], "Mode", &mode) != CAENHV_OK )
-            throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
 
+        ParamInfo info;
+        info.name   = p[i];
+        info.type   = type;
+        info.mode   = mode;
+        info.minVal = 0;
+        info.maxVal = 0;
 
         if (type == PARAM_TYPE_NUMERIC)
-            boardParameterNumerics.push_back( IBoardParameterNumeric::create(handle, slot, p[i], mode));
+        {
+            BoardParameterNumeric param( IBoardParameterNumeric::create(handle, slot, p[i], mode) );
+            info.minVal = param->getMinVal();
+            info.maxVal = param->getMaxVal();
+            info.units  = param->getUnits();
+            boardParameterNumerics.push_back(param);
+        }
         else if (type == PARAM_TYPE_ONOFF)
-            boardParameterOnOffs.push_back( IBoardParameterOnOff::create(handle, slot, p[i], mode));
+        {
+            BoardParameterOnOff param( IBoardParameterOnOff::create(handle, slot, p[i], mode) );
+            info.onState  = param->getOnState();
+            info.offState = param->getOffState();
+            boardParameterOnOffs.push_back(param);
+        }
         else if (type == PARAM_TYPE_CHSTATUS)
             boardParameterChStatuses.push_back( IBoardParameterChStatus::create(handle, slot, p[i], mode));
         else if (type == PARAM_TYPE_BDSTATUS)
             boardParameterBdStatuses.push_back( IBoardParameterBdStatus::create(handle, slot, p[i], mode));
         else
+        {
             //throw std::runtime_error("Parameter type not  supported!");
             std::cerr << "Error found when creating a Board Parameter object for pamater '" << p[i] << "'. Unsupported type = " << type << std::endl;
+            continue;
+        }
+
+        paramInfo.push_back(info);
     }
 
     // Deallocate memory (Use RAII in the future for this)
     free(ParNameList);
 }
 
+void IBoard::AddBoardParam(const ParamInfo& info)
+{
+    if (info.type == PARAM_TYPE_NUMERIC)
+        boardParameterNumerics.push_back( IBoardParameterNumeric::create(handle, slot, info.name, info.mode, info.minVal, info.maxVal, info.units) );
+    else if (info.type == PARAM_TYPE_ONOFF)
+        boardParameterOnOffs.push_back( IBoardParameterOnOff::create(handle, slot, info.name, info.mode, info.onState, info.offState) );
+    else if (info.type == PARAM_TYPE_CHSTATUS)
+        boardParameterChStatuses.push_back( IBoardParameterChStatus::create(handle, slot, info.name, info.mode) );
+    else if (info.type == PARAM_TYPE_BDSTATUS)
+        boardParameterBdStatuses.push_back( IBoardParameterBdStatus::create(handle, slot, info.name, info.mode) );
+    else
+        return;
+
+    paramInfo.push_back(info);
+}
+
 void IBoard::GetBoardChannels()
 {
-    for (std::size_t i(0); i < numChannels; ++i)
-        channels.push_back( IChannel::create(handle, slot, i) );
+    // Each channel is stored at its own position, so the
+    // order does not depend on which worker discovered it
+    channels.assign(numChannels, Channel());
+
+    if ( ! registry )
+    {
+        std::stringstream poolName;
+        poolName << "CAENHVAsynCh" << slot << "_";
+
+        WorkPool pool( IWorkPool::create(poolName.str(), channelWorkers) );
+        pool->run( numChannels, [this](std::size_t i) { channels.at(i) = IChannel::create(handle, slot, i); } );
+
+        return;
+    }
+
+    if ( numChannels == 0 )
+        return;
+
+    // The first channel is done first, so that the table of descriptors of this model is in
+    // the registry before the other channels are checked. For the other channels, only
+    // the list of parameter names is read, unless it is different from the first channel.
+    channels.at(0) = IChannel::create( handle, slot, 0, GetChannelDescriptors(0) );
+
+    std::stringstream poolName;
+    poolName << "CAENHVAsynCh" << slot << "_";
+
+    WorkPool pool( IWorkPool::create(poolName.str(), channelWorkers) );
+    pool->run( numChannels - 1, [this](std::size_t i) { channels.at(i + 1) = IChannel::create( handle, slot, i + 1, GetChannelDescriptors(i + 1) ); } );
+}
+
+ParamDescriptorTable IBoard::GetChannelDescriptors(std::size_t c)
+{
+    std::vector<std::string> names( IChannel::GetChannelParamNames(handle, slot, c) );
+
+    ParamDescriptorTable table( registry->find(model, firmwareRelease, names) );
+
+    // If the channel has a different list of parameters, or this model is not in the
+    // registry yet, read the properties of all the parameters from the crate
+    if ( ! table )
+        table = registry->add( model, firmwareRelease, names, IChannel::DiscoverChannelParams(handle, slot, c, names) );
+
+    return table;
 }
@@ -39,8 +39,11 @@
 
 #include "CAENHVWrapper.h"
 #include "common.h"
+#include "crate_link.h"
 #include "board_parameter.h"
 #include "channel.h"
+#include "work_pool.h"
+#include "param_descriptor.h"
 
 class IBoard;
 
@@ -49,25 +52,40 @@ typedef std::shared_ptr<IBoard> Board;
 class IBoard
 {
 public:
-    IBoard(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw);
+    // The channels are discovered in parallel using up to 'cw' worker threads. If a registry
+    // 'r' is given, channels with the same parameters share their parameter descriptors with
+    // other channels of boards of the same model and firmware release.
+    IBoard(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw, std::size_t cw = 1, ParamDescriptorRegistry r = ParamDescriptorRegistry());
+    IBoard(int h, const BoardInfo& info, ParamDescriptorRegistry r = ParamDescriptorRegistry());
     ~IBoard();
 
-    // Factory method
-    static Board create(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw);
+    // Factory methods. The second one creates the board parameters and channels from
+    // known metadata, without reading their properties from the crate.
+    static Board create(int h, std::size_t s, std::string m, std::string d, std::size_t n, std::string sn, std::string fw, std::size_t cw = 1, ParamDescriptorRegistry r = ParamDescriptorRegistry());
+    static Board create(int h, const BoardInfo& info, ParamDescriptorRegistry r = ParamDescriptorRegistry());
 
     void printInfo(std::ostream& stream) const;
     void printBoardInfo(std::ostream& stream) const;
 
+    std::size_t getSlot() const { return slot; };
+
     std::vector<BoardParameterNumeric>  getBoardParameterNumerics()   { return boardParameterNumerics;   };
     std::vector<BoardParameterOnOff>    getBoardParameterOnOffs()     { return boardParameterOnOffs;     };
     std::vector<BoardParameterChStatus> getBoardParameterChStatuses() { return boardParameterChStatuses; };
     std::vector<BoardParameterBdStatus> getBoardParameterBdStatuses() { return boardParameterBdStatuses; };
     std::vector<Channel>                getChannels()                 { return channels;                 };
 
+    // Metadata of the board, and of all its parameters and channels
+    BoardInfo getInfo() const;
+
 private:
 
     void GetBoardParams();
     void GetBoardChannels();
+    void AddBoardParam(const ParamInfo& info);
+
+    // Get the table of descriptors for a channel, from the registry if possible
+    ParamDescriptorTable GetChannelDescriptors(std::size_t c);
 
     int                         handle;
     std::size_t                 slot;
@@ -76,6 +94,8 @@ private:
     std::size_t                 numChannels;
     std::string                 serialNumber;
     std::string                 firmwareRelease;
+    std::size_t                 channelWorkers;
+    ParamDescriptorRegistry     registry;
 
     std::vector<BoardParameterNumeric>  boardParameterNumerics;
     std::vector<BoardParameterOnOff>    boardParameterOnOffs;
@@ -83,6 +103,8 @@ private:
     std::vector<BoardParameterBdStatus> boardParameterBdStatuses;
 
     std::vector<Channel> channels;
+
+    std::vector<ParamInfo> paramInfo;
 };
 
 #endif
@@ -64,8 +64,8 @@ T BoardParameterBase<T>::getVal() const
     T temp;
 
     uint16_t tempSlot = slot;
-    if ( CAENHV_GetBdParam(handle, 1, &tempSlot, param.c_str(), &temp) != CAENHV_OK )
-           throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+    if ( linkCall(WIRE_GET_BD_PARAM, handle, [&](int libHandle) { return CAENHV_GetBdParam(libHandle, 1, &tempSlot, param.c_str(), &temp); }) != CAENHV_OK )
+           throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(handle)));
 
     return temp;
 }
@@ -77,8 +77,8 @@ void BoardParameterBase<T>::setVal(T value) const
         return;
 
     uint16_t tempSlot = slot;
-    if ( CAENHV_SetBdParam(handle, 1, &tempSlot, param.c_str(), &value) != CAENHV_OK )
-           throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+    if ( linkCall(WIRE_SET_BD_PARAM, handle, [&](int libHandle) { return CAENHV_SetBdParam(libHandle, 1, &tempSlot, param.c_str(), &value); }) != CAENHV_OK )
+           throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(handle)));
 }
 template<typename T>
 void BoardParameterBase<T>::printInfo(std::ostream& stream) const
@@ -103,28 +103,42 @@ IBoardParameterNumeric::IBoardParameterNumeric(int h, std::size_t s, const std::
 {
    float temp;
 
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Minval", &temp ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_BD_PARAM_PROP, handle, [&](int libHandle) { return CAENHV_GetBdParamProp(libHandle, slot, param.c_str(), "Minval", &temp ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(handle)));
 
    minVal = temp;
 
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Maxval", &temp ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_BD_PARAM_PROP, handle, [&](int libHandle) { return CAENHV_GetBdParamProp(libHandle, slot, param.c_str(), "Maxval", &temp ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(handle)));
 
    maxVal = temp;
 
    // Extract uints
    uint16_t u;
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Unit", &u ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_BD_PARAM_PROP, handle, [&](int libHandle) { return CAENHV_GetBdParamProp(libHandle, slot, param.c_str(), "Unit", &u ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(handle)));
 
    int8_t e;
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Exp", &e ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_BD_PARAM_PROP, handle, [&](int libHandle) { return CAENHV_GetBdParamProp(libHandle, slot, param.c_str(), "Exp", &e ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(handle)));
 
    units = processUnits(u, e);
 }
 
+BoardParameterNumeric IBoardParameterNumeric::create(int h, std::size_t s, const std::string&  p, uint32_t m, float min, float max, const std::string& u)
+{
+    return std::make_shared<IBoardParameterNumeric>(h, s, p, m, min, max, u);
+}
+
+IBoardParameterNumeric::IBoardParameterNumeric(int h, std::size_t s, const std::string&  p, uint32_t m, float min, float max, const std::string& u)
+:
+    BoardParameterBase<float>(h, s, p, m),
+    minVal(min),
+    maxVal(max),
+    units(u)
+{
+}
+
 void IBoardParameterNumeric::printInfo(std::ostream& stream) const
 {
     stream << "        Param = "     << param \
@@ -149,17 +163,30 @@ IBoardParameterOnOff::IBoardParameterOnOff(int h, std::size_t s, const std::stri
 {
    char temp[30];
 
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Onstate", temp ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_BD_PARAM_PROP, handle, [&](int libHandle) { return CAENHV_GetBdParamProp(libHandle, slot, param.c_str(), "Onstate", temp ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(handle)));
 
    onState = temp;
 
-   if ( CAENHV_GetBdParamProp(handle, slot, param.c_str(), "Offstate", temp ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_BD_PARAM_PROP, handle, [&](int libHandle) { return CAENHV_GetBdParamProp(libHandle, slot, param.c_str(), "Offstate", temp ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(handle)));
 
     offState = temp;
 }
 
+BoardParameterOnOff IBoardParameterOnOff::create(int h, std::size_t s, const std::string&  p, uint32_t m, const std::string& on, const std::string& off)
+{
+    return std::make_shared<IBoardParameterOnOff>(h, s, p, m, on, off);
+}
+
+IBoardParameterOnOff::IBoardParameterOnOff(int h, std::size_t s, const std::string&  p, uint32_t m, const std::string& on, const std::string& off)
+:
+    BoardParameterBase<uint32_t>(h, s, p, m),
+    onState(on),
+    offState(off)
+{
+}
+
 void IBoardParameterOnOff::printInfo(std::ostream& stream) const
 {
     stream << "        Param = "     << param \
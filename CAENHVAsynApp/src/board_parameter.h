@@ -40,6 +40,7 @@
 
 #include "CAENHVWrapper.h"
 #include "common.h"
+#include "crate_link.h"
 
 template<typename T>
 class BoardParameterBase;
@@ -64,6 +65,9 @@ public:
     virtual ~BoardParameterBase() {};
 
     std::string getMode()            { return modeStr;         };
+    int         getHandle()          { return handle;          };
+    std::size_t getSlot()            { return slot;            };
+    std::string getParam()           { return param;           };
     std::string getEpicsParamName()  { return epicsParamName;  };
     std::string getEpicsRecordName() { return epicsRecordName; };
     std::string getEpicsDesc()       { return epicsDesc;       };
@@ -89,10 +93,12 @@ class IBoardParameterNumeric : public BoardParameterBase<float>
 {
 public:
     IBoardParameterNumeric(int h, std::size_t s, const std::string&  p, uint32_t m);
+    IBoardParameterNumeric(int h, std::size_t s, const std::string&  p, uint32_t m, float min, float max, const std::string& u);
     ~IBoardParameterNumeric() {};
 
-    // Factory method
+    // Factory methods. The second one uses known properties, without reading them from the crate.
     static BoardParameterNumeric create(int h, std::size_t s, const std::string&  p, uint32_t m);
+    static BoardParameterNumeric create(int h, std::size_t s, const std::string&  p, uint32_t m, float min, float max, const std::string& u);
 
     float       getMinVal() const { return minVal; };
     float       getMaxVal() const { return maxVal; };
@@ -111,10 +117,12 @@ class  IBoardParameterOnOff : public BoardParameterBase<uint32_t>
 {
 public:
     IBoardParameterOnOff(int h, std::size_t s, const std::string&  p, uint32_t m);
+    IBoardParameterOnOff(int h, std::size_t s, const std::string&  p, uint32_t m, const std::string& on, const std::string& off);
     ~IBoardParameterOnOff() {};
 
-    // Factory method
+    // Factory methods. The second one uses known properties, without reading them from the crate.
     static BoardParameterOnOff create(int h, std::size_t s, const std::string&  p, uint32_t m);
+    static BoardParameterOnOff create(int h, std::size_t s, const std::string&  p, uint32_t m, const std::string& on, const std::string& off);
 
     const std::string& getOnState()  const { return onState;  };
     const std::string& getOffState() const { return offState; };
@@ -27,7 +27,18 @@ IChannel::IChannel(int h, std::size_t s, std::size_t c)
     slot(s),
     channel(c)
 {
-    GetChannelParams();
+    descriptors = std::make_shared< const std::vector<ParamInfo> >( DiscoverChannelParams( handle, slot, channel, GetChannelParamNames(handle, slot, channel) ) );
+    AddChannelParams();
+}
+
+IChannel::IChannel(int h, std::size_t s, std::size_t c, ParamDescriptorTable t)
+:
+    handle(h),
+    slot(s),
+    channel(c),
+    descriptors(t)
+{
+    AddChannelParams();
 }
 
 Channel IChannel::create(int h, std::size_t s, std::size_t c)
@@ -35,6 +46,11 @@ Channel IChannel::create(int h, std::size_t s, std::size_t c)
     return std::make_shared<IChannel>(h, s, c);
 }
 
+Channel IChannel::create(int h, std::size_t s, std::size_t c, ParamDescriptorTable t)
+{
+    return std::make_shared<IChannel>(h, s, c, t);
+}
+
 void IChannel::printInfo(std::ostream& stream) const
 {
     stream << "      Slot = " << slot \
@@ -59,59 +75,96 @@ void IChannel::printInfo(std::ostream& stream) const
 
 }
 
-void IChannel::GetChannelParams()
+std::vector<std::string> IChannel::GetChannelParamNames(int h, std::size_t s, std::size_t c)
 {
     // Get Channel Parameter Info
     std::string functionName("GetChannelParams");
 
+    std::vector<std::string> names;
+
     char *ParNameList = (char *)NULL;
     int ParNumber(0);
-    CAENHVRESULT r = CAENHV_GetChParamInfo(handle, slot, channel, &ParNameList, &ParNumber);
+    CAENHVRESULT r = linkCall(WIRE_GET_CH_PARAM_INFO, h, [&](int libHandle) { return CAENHV_GetChParamInfo(libHandle, s, c, &ParNameList, &ParNumber); });
 
     std::stringstream retMessage;
-    retMessage << "CAENHV_GetChParamInfo (slot = " << slot << ") : " << CAENHV_GetError(handle) << " (num. " << r << ")";
+    retMessage << "CAENHV_GetChParamInfo (slot = " << s << ") : " << linkError(h) << " (num. " << r << ")";
 
     printMessage(functionName, retMessage.str().c_str());
 
     if ( r != CAENHV_OK )
-        return;
+        return names;
 
     // Check if we the number of parameter is > 0
-    if (ParNumber <= 0)
-        return;
+    if (ParNumber > 0)
+    {
+        // Create an unsigned version of the number of parameters
+        std::size_t numParams(ParNumber);
 
-    // Create an unsigned version of the number of parameters
-    std::size_t numParams(ParNumber);
+        char (*p)[MAX_PARAM_NAME];
+        p = (char (*)[MAX_PARAM_NAME])ParNameList;
 
-    char (*p)[MAX_PARAM_NAME];
-    p = (char (*)[MAX_PARAM_NAME])ParNameList;
+        names.reserve(numParams);
+        for( std::size_t i(0) ; p[i][0] && i < numParams; i++ )
+            names.push_back(p[i]);
+    }
 
-    channelParameterNumerics.reserve(numParams);
-    channelParameterOnOffs.reserve(numParams);
-    for( std::size_t i(0) ; p[i][0] && i < numParams; i++ )
-    {
+    // Deallocate memory (Use RAII in the future for this)
+    free(ParNameList);
 
+    return names;
+}
+
+std::vector<ParamInfo> IChannel::DiscoverChannelParams(int h, std::size_t s, std::size_t c, const std::vector<std::string>& names)
+{
+    std::vector<ParamInfo> info;
+    info.reserve(names.size());
+
+    for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+    {
         uint32_t type, mode;
 
-        if ( CAENHV_GetChParamProp(handle, slot, channel, p[i], "Type", &type) != CAENHV_OK )
-            throw std::runtime_error("CAENHV_GetChParamProp failed: " + std::string(CAENHV_GetError(handle)));
+        if ( linkCall(WIRE_GET_CH_PARAM_PROP, h, [&](int libHandle) { return CAENHV_GetChParamProp(libHandle, s, c, it->c_str(), "Type", &type); }) != CAENHV_OK )
+            throw std::runtime_error("CAENHV_GetChParamProp failed: " + std::string(linkError(h)));
 
-        if (CAENHV_GetChParamProp(handle, slot, channel, p[i], "Mode", &mode) != CAENHV_OK )
-            throw std::runtime_error("CAENHV_GetChParamProp failed: " + std::string(CAENHV_GetError(handle)));
+        if (linkCall(WIRE_GET_CH_PARAM_PROP, h, [&](int libHandle) { return CAENHV_GetChParamProp(libHandle, s, c, it->c_str(), "Mode", &mode); }) != CAENHV_OK )
+            throw std::runtime_error("CAENHV_GetChParamProp failed: " + std::string(linkError(h)));
 
+        // The parameter objects read the rest of their properties from the crate
         if (type == PARAM_TYPE_NUMERIC)
-            channelParameterNumerics.push_back( IChannelParameterNumeric::create(handle, slot, channel, p[i], mode) );
+            info.push_back( *IChannelParameterNumeric::create(h, s, c, *it, mode)->getDescriptor() );
         else if (type == PARAM_TYPE_ONOFF)
-            channelParameterOnOffs.push_back( IChannelParameterOnOff::create(handle, slot, channel, p[i], mode) );
+            info.push_back( *IChannelParameterOnOff::create(h, s, c, *it, mode)->getDescriptor() );
         else if (type == PARAM_TYPE_CHSTATUS)
-            channelParameterChStatuses.push_back( IChannelParameterChStatus::create(handle, slot, channel, p[i], mode) );
+            info.push_back( *IChannelParameterChStatus::create(h, s, c, *it, mode)->getDescriptor() );
         else if (type == PARAM_TYPE_BINARY)
-            channelParameterBinaries.push_back( IChannelParameterBinary::create(handle, slot, channel, p[i], mode) );
+            info.push_back( *IChannelParameterBinary::create(h, s, c, *it, mode)->getDescriptor() );
         else
             //throw std::runtime_error("Parameter type not  supported!");
-            std::cerr << "Error found when creating a Board Parameter object for pamater '" << p[i] << "'. Unsupported type = " << type << std::endl;
+            std::cerr << "Error found when creating a Board Parameter object for pamater '" << *it << "'. Unsupported type = " << type << std::endl;
     }
 
-    // Deallocate memory (Use RAII in the future for this)
-    free(ParNameList);
+    return info;
+}
+
+void IChannel::AddChannelParams()
+{
+    std::size_t numParams( descriptors->size() );
+
+    channelParameterNumerics.reserve(numParams);
+    channelParameterOnOffs.reserve(numParams);
+
+    // All the parameter objects point to the shared descriptors
+    for (std::size_t i(0); i < numParams; ++i)
+    {
+        ParamDescriptor d( createParamDescriptor(descriptors, i) );
+
+        if (d->type == PARAM_TYPE_NUMERIC)
+            channelParameterNumerics.push_back( IChannelParameterNumeric::create(handle, slot, channel, d) );
+        else if (d->type == PARAM_TYPE_ONOFF)
+            channelParameterOnOffs.push_back( IChannelParameterOnOff::create(handle, slot, channel, d) );
+        else if (d->type == PARAM_TYPE_CHSTATUS)
+            channelParameterChStatuses.push_back( IChannelParameterChStatus::create(handle, slot, channel, d) );
+        else if (d->type == PARAM_TYPE_BINARY)
+            channelParameterBinaries.push_back( IChannelParameterBinary::create(handle, slot, channel, d) );
+    }
 }
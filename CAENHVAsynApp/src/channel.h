@@ -39,6 +39,7 @@
 
 #include "CAENHVWrapper.h"
 #include "common.h"
+#include "crate_link.h"
 #include "channel_parameter.h"
 
 class IChannel;
@@ -50,10 +51,20 @@ class IChannel
 {
 public:
     IChannel(int h, std::size_t s, std::size_t c);
+    IChannel(int h, std::size_t s, std::size_t c, ParamDescriptorTable t);
     ~IChannel() {};
 
-    // Factory method
+    // Factory methods. The second one creates the parameters from a table of descriptors,
+    // which can be shared with other channels, without reading their properties from the crate.
     static Channel create(int h, std::size_t s, std::size_t c);
+    static Channel create(int h, std::size_t s, std::size_t c, ParamDescriptorTable t);
+
+    // Read the list of parameter names of a channel from the crate
+    static std::vector<std::string> GetChannelParamNames(int h, std::size_t s, std::size_t c);
+
+    // Read the properties of a list of parameters of a channel from the crate.
+    // Parameters of unsupported types are not included.
+    static std::vector<ParamInfo> DiscoverChannelParams(int h, std::size_t s, std::size_t c, const std::vector<std::string>& names);
 
     void printInfo(std::ostream& stream) const;
 
@@ -62,9 +73,13 @@ public:
     std::vector<ChannelParameterChStatus> getChannelParameterChStatuses() { return channelParameterChStatuses; };
     std::vector<ChannelParameterBinary>   getChannelParameterBinaries()   { return channelParameterBinaries;   };
 
+    // Metadata of all the parameters of the channel
+    const std::vector<ParamInfo>&         getParamInfo() const            { return *descriptors;               };
+    const ParamDescriptorTable&           getDescriptors() const          { return descriptors;                };
+
 private:
 
-    void GetChannelParams();
+    void AddChannelParams();
 
     int                         handle;
     std::size_t                 slot;
@@ -74,6 +89,9 @@ private:
     std::vector<ChannelParameterOnOff>    channelParameterOnOffs;
     std::vector<ChannelParameterChStatus> channelParameterChStatuses;
     std::vector<ChannelParameterBinary>   channelParameterBinaries;
+
+    // Table of parameter descriptors
+    ParamDescriptorTable                  descriptors;
 };
 
 #endif
@@ -23,53 +23,72 @@
 
 // Base class for all parameter types
 template<typename T>
-ChannelParameterBase<T>::ChannelParameterBase(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
+ChannelParameterBase<T>::ChannelParameterBase(int h, std::size_t s, std::size_t c, ParamDescriptor d)
 :
     handle(h),
     slot(s),
     channel(c),
-    param(p),
-    mode(m)
+    desc(d)
 {
-    // Generate mode string representation
-    modeStr = processMode(mode);
+}
 
-    std::stringstream temp;
+template<typename T>
+ParamDescriptor ChannelParameterBase<T>::createDescriptor(const std::string& p, uint32_t t, uint32_t m)
+{
+    ParamInfo info;
+    info.name   = p;
+    info.type   = t;
+    info.mode   = m;
+    info.minVal = 0;
+    info.maxVal = 0;
+
+    return createParamDescriptor(info);
+}
 
-    // Generate the EPICS parameter name
-    temp.str("");
-    temp << "S" << std::setfill('0') << std::setw(2) << s << "_" \
+// The EPICS names are generated when they are requested, so that
+// they don't need to be stored for every channel
+template<typename T>
+std::string ChannelParameterBase<T>::getEpicsParamName() const
+{
+    std::stringstream temp;
+    temp << "S" << std::setfill('0') << std::setw(2) << slot << "_" \
          << "C" << std::setfill('0') << std::setw(2) << channel << "_" \
-         << processParamName(param);
-    epicsParamName = temp.str();
+         << processParamName(desc->name);
+    return temp.str();
+}
 
-    // Generate the EPICS record name
-    temp.str("");
-    temp << "S" << std::setfill('0') << std::setw(2) << s << ":" \
+template<typename T>
+std::string ChannelParameterBase<T>::getEpicsRecordName() const
+{
+    std::stringstream temp;
+    temp << "S" << std::setfill('0') << std::setw(2) << slot << ":" \
          << "C" << std::setfill('0') << std::setw(2) << channel << ":" \
-         << processParamName(param);
-    epicsRecordName = temp.str();
+         << processParamName(desc->name);
+    return temp.str();
+}
 
-    // Generate the EPICS description
-    temp.str("");
-    temp << "'Slot " << s \
+template<typename T>
+std::string ChannelParameterBase<T>::getEpicsDesc() const
+{
+    std::stringstream temp;
+    temp << "'Slot " << slot \
          << ", Ch " << channel \
-         <<  ", " << param \
-         << " (" << modeStr << ")'";
-    epicsDesc = temp.str();
+         <<  ", " << desc->name \
+         << " (" << processMode(desc->mode) << ")'";
+    return temp.str();
 }
 
 template<typename T>
 T ChannelParameterBase<T>::getVal() const
 {
-    if (mode == PARAM_MODE_WRONLY)
+    if (desc->mode == PARAM_MODE_WRONLY)
         return T();
 
     T temp;
 
     uint16_t temp_chs = channel;
-    if ( CAENHV_GetChParam(handle, slot, param.c_str(), 1, &temp_chs, &temp) != CAENHV_OK )
-           throw std::runtime_error("CAENHV_GetChParam failed: " + std::string(CAENHV_GetError(handle)));
+    if ( linkCall(WIRE_GET_CH_PARAM, handle, [&](int libHandle) { return CAENHV_GetChParam(libHandle, slot, desc->name.c_str(), 1, &temp_chs, &temp); }) != CAENHV_OK )
+           throw std::runtime_error("CAENHV_GetChParam failed: " + std::string(linkError(handle)));
 
     return temp;
 }
@@ -77,22 +96,22 @@ T ChannelParameterBase<T>::getVal() const
 template<typename T>
 void ChannelParameterBase<T>::setVal(T value) const
 {
-    if (mode == PARAM_MODE_RDONLY)
+    if (desc->mode == PARAM_MODE_RDONLY)
         return;
 
     uint16_t temp_chs = channel;
-    if ( CAENHV_SetChParam(handle, slot, param.c_str(), 1, &temp_chs, &value) != CAENHV_OK )
-           throw std::runtime_error("CAENHV_SetChParam failed: " + std::string(CAENHV_GetError(handle)));
+    if ( linkCall(WIRE_SET_CH_PARAM, handle, [&](int libHandle) { return CAENHV_SetChParam(libHandle, slot, desc->name.c_str(), 1, &temp_chs, &value); }) != CAENHV_OK )
+           throw std::runtime_error("CAENHV_SetChParam failed: " + std::string(linkError(handle)));
 }
 
 template<typename T>
 void ChannelParameterBase<T>::printInfo(std::ostream& stream) const
 {
-    stream << "          Param = "   << param \
-           << ", Mode  = "           << modeStr \
+    stream << "          Param = "   << desc->name \
+           << ", Mode  = "           << getMode() \
            << ", Value = "           << getVal() \
-           << ", epicsParamName = "  << epicsParamName \
-           << ", epicsRecordName = " << epicsRecordName \
+           << ", epicsParamName = "  << getEpicsParamName() \
+           << ", epicsRecordName = " << getEpicsRecordName() \
            << std::endl;
 }
 
@@ -102,44 +121,85 @@ ChannelParameterNumeric IChannelParameterNumeric::create(int h, std::size_t s, s
     return std::make_shared<IChannelParameterNumeric>(h, s, c, p, m);
 }
 
+ChannelParameterNumeric IChannelParameterNumeric::create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m, float min, float max, const std::string& u)
+{
+    return std::make_shared<IChannelParameterNumeric>(h, s, c, p, m, min, max, u);
+}
+
+ChannelParameterNumeric IChannelParameterNumeric::create(int h, std::size_t s, std::size_t c, ParamDescriptor d)
+{
+    return std::make_shared<IChannelParameterNumeric>(h, s, c, d);
+}
+
 IChannelParameterNumeric::IChannelParameterNumeric(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 :
-    ChannelParameterBase<float>(h, s, c, p, m)
+    ChannelParameterBase<float>(h, s, c, discover(h, s, c, p, m))
+{
+}
+
+IChannelParameterNumeric::IChannelParameterNumeric(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m, float min, float max, const std::string& u)
+:
+    ChannelParameterBase<float>(h, s, c, ParamDescriptor())
 {
+    ParamInfo info;
+    info.name   = p;
+    info.type   = PARAM_TYPE_NUMERIC;
+    info.mode   = m;
+    info.minVal = min;
+    info.maxVal = max;
+    info.units  = u;
+    desc = createParamDescriptor(info);
+}
+
+IChannelParameterNumeric::IChannelParameterNumeric(int h, std::size_t s, std::size_t c, ParamDescriptor d)
+:
+    ChannelParameterBase<float>(h, s, c, d)
+{
+}
+
+ParamDescriptor IChannelParameterNumeric::discover(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
+{
+   ParamInfo info;
+   info.name = p;
+   info.type = PARAM_TYPE_NUMERIC;
+   info.mode = m;
+
    float temp;
 
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Minval", &temp ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_CH_PARAM_PROP, h, [&](int libHandle) { return CAENHV_GetChParamProp(libHandle, s, c, p.c_str(), "Minval", &temp ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(h)));
 
-   minVal = temp;
+   info.minVal = temp;
 
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Maxval", &temp ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_CH_PARAM_PROP, h, [&](int libHandle) { return CAENHV_GetChParamProp(libHandle, s, c, p.c_str(), "Maxval", &temp ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(h)));
 
-   maxVal = temp;
+   info.maxVal = temp;
 
    // Extract uints
    uint16_t u;
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Unit", &u ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_CH_PARAM_PROP, h, [&](int libHandle) { return CAENHV_GetChParamProp(libHandle, s, c, p.c_str(), "Unit", &u ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(h)));
 
    int8_t e;
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Exp", &e ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_CH_PARAM_PROP, h, [&](int libHandle) { return CAENHV_GetChParamProp(libHandle, s, c, p.c_str(), "Exp", &e ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(h)));
 
-     units = processUnits(u, e);
+   info.units = processUnits(u, e);
+
+   return createParamDescriptor(info);
 }
 
 void IChannelParameterNumeric::printInfo(std::ostream& stream) const
 {
-    stream << "          Param = "   << param \
-           << ", Mode  = "           << modeStr \
+    stream << "          Param = "   << desc->name \
+           << ", Mode  = "           << getMode() \
            << ", Minval = "          << getMinVal() \
            << ", Maxval = "          <<  getMaxVal() \
-           << ", Units = "           << units.c_str() \
+           << ", Units = "           << desc->units.c_str() \
            << ", Value = "           << getVal() \
-           << ", epicsParamName = "  << epicsParamName \
-           << ", epicsRecordName = " << epicsRecordName \
+           << ", epicsParamName = "  << getEpicsParamName() \
+           << ", epicsRecordName = " << getEpicsRecordName() \
            << std::endl;
 }
 
@@ -149,40 +209,89 @@ ChannelParameterOnOff IChannelParameterOnOff::create(int h, std::size_t s, std::
     return std::make_shared<IChannelParameterOnOff>(h, s, c, p, m);
 }
 
+ChannelParameterOnOff IChannelParameterOnOff::create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m, const std::string& on, const std::string& off)
+{
+    return std::make_shared<IChannelParameterOnOff>(h, s, c, p, m, on, off);
+}
+
+ChannelParameterOnOff IChannelParameterOnOff::create(int h, std::size_t s, std::size_t c, ParamDescriptor d)
+{
+    return std::make_shared<IChannelParameterOnOff>(h, s, c, d);
+}
+
 IChannelParameterOnOff::IChannelParameterOnOff(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 :
-    ChannelParameterBase<uint32_t>(h, s, c, p, m)
+    ChannelParameterBase<uint32_t>(h, s, c, discover(h, s, c, p, m))
+{
+}
+
+IChannelParameterOnOff::IChannelParameterOnOff(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m, const std::string& on, const std::string& off)
+:
+    ChannelParameterBase<uint32_t>(h, s, c, ParamDescriptor())
+{
+    ParamInfo info;
+    info.name     = p;
+    info.type     = PARAM_TYPE_ONOFF;
+    info.mode     = m;
+    info.minVal   = 0;
+    info.maxVal   = 0;
+    info.onState  = on;
+    info.offState = off;
+    desc = createParamDescriptor(info);
+}
+
+IChannelParameterOnOff::IChannelParameterOnOff(int h, std::size_t s, std::size_t c, ParamDescriptor d)
+:
+    ChannelParameterBase<uint32_t>(h, s, c, d)
+{
+}
+
+ParamDescriptor IChannelParameterOnOff::discover(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 {
+   ParamInfo info;
+   info.name   = p;
+   info.type   = PARAM_TYPE_ONOFF;
+   info.mode   = m;
+   info.minVal = 0;
+   info.maxVal = 0;
+
    char temp[30];
 
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Onstate", temp ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_CH_PARAM_PROP, h, [&](int libHandle) { return CAENHV_GetChParamProp(libHandle, s, c, p.c_str(), "Onstate", temp ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(h)));
 
-   onState = temp;
+   info.onState = temp;
 
-   if ( CAENHV_GetChParamProp(handle, slot, channel, param.c_str(), "Offstate", temp ) != CAENHV_OK )
-       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(CAENHV_GetError(handle)));
+   if ( linkCall(WIRE_GET_CH_PARAM_PROP, h, [&](int libHandle) { return CAENHV_GetChParamProp(libHandle, s, c, p.c_str(), "Offstate", temp ); }) != CAENHV_OK )
+       throw std::runtime_error("CAENHV_GetBdParamProp failed: " + std::string(linkError(h)));
 
-    offState = temp;
+   info.offState = temp;
 
+   return createParamDescriptor(info);
 }
 
 void IChannelParameterOnOff::printInfo(std::ostream& stream) const
 {
-    stream << "          Param = "   << param \
-           << ", Mode = "            << modeStr \
+    stream << "          Param = "   << desc->name \
+           << ", Mode = "            << getMode() \
            << ", On state = "        << getOnState() \
            << ", Off state = "       << getOffState() \
            << ", Value = "           << getVal() \
-           << ", epicsParamName = "  << epicsParamName \
-           << ", epicsRecordName = " << epicsRecordName \
+           << ", epicsParamName = "  << getEpicsParamName() \
+           << ", epicsRecordName = " << getEpicsRecordName() \
            << std::endl;
 }
 
 // Class for ChStatus parameters
 IChannelParameterChStatus::IChannelParameterChStatus(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 :
-    ChannelParameterBase<uint32_t>(h, s, c, p, m)
+    ChannelParameterBase<uint32_t>(h, s, c, createDescriptor(p, PARAM_TYPE_CHSTATUS, m))
+{
+}
+
+IChannelParameterChStatus::IChannelParameterChStatus(int h, std::size_t s, std::size_t c, ParamDescriptor d)
+:
+    ChannelParameterBase<uint32_t>(h, s, c, d)
 {
 }
 
@@ -191,20 +300,31 @@ ChannelParameterChStatus IChannelParameterChStatus::create(int h, std::size_t s,
     return std::make_shared<IChannelParameterChStatus>(h, s, c, p, m);
 }
 
+ChannelParameterChStatus IChannelParameterChStatus::create(int h, std::size_t s, std::size_t c, ParamDescriptor d)
+{
+    return std::make_shared<IChannelParameterChStatus>(h, s, c, d);
+}
+
 void IChannelParameterChStatus::printInfo(std::ostream& stream) const
 {
-    stream << "          Param = "   << param \
-           << ", Mode  = "           << modeStr \
+    stream << "          Param = "   << desc->name \
+           << ", Mode  = "           << getMode() \
            << ", Value = "           << getVal() \
-           << ", epicsParamName = "  << epicsParamName \
-           << ", epicsRecordName = " << epicsRecordName \
+           << ", epicsParamName = "  << getEpicsParamName() \
+           << ", epicsRecordName = " << getEpicsRecordName() \
            << std::endl;
 }
 
 // Class for Binary parameters
 IChannelParameterBinary::IChannelParameterBinary(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m)
 :
-    ChannelParameterBase<int32_t>(h, s, c, p, m)
+    ChannelParameterBase<int32_t>(h, s, c, createDescriptor(p, PARAM_TYPE_BINARY, m))
+{
+}
+
+IChannelParameterBinary::IChannelParameterBinary(int h, std::size_t s, std::size_t c, ParamDescriptor d)
+:
+    ChannelParameterBase<int32_t>(h, s, c, d)
 {
 }
 
@@ -213,12 +333,21 @@ ChannelParameterBinary IChannelParameterBinary::create(int h, std::size_t s, std
     return std::make_shared<IChannelParameterBinary>(h, s, c, p, m);
 }
 
+ChannelParameterBinary IChannelParameterBinary::create(int h, std::size_t s, std::size_t c, ParamDescriptor d)
+{
+    return std::make_shared<IChannelParameterBinary>(h, s, c, d);
+}
+
 void IChannelParameterBinary::printInfo(std::ostream& stream) const
 {
-    stream << "          Param = "   << param \
-           << ", Mode  = "           << modeStr \
+    stream << "          Param = "   << desc->name \
+           << ", Mode  = "           << getMode() \
            << ", Value = "           << getVal() \
-           << ", epicsParamName = "  << epicsParamName \
-           << ", epicsRecordName = " << epicsRecordName \
+           << ", epicsParamName = "  << getEpicsParamName() \
+           << ", epicsRecordName = " << getEpicsRecordName() \
            << std::endl;
 }
+
+template class ChannelParameterBase<float>;
+template class ChannelParameterBase<uint32_t>;
+template class ChannelParameterBase<int32_t>;
@@ -39,8 +39,10 @@
 
 #include "CAENHVWrapper.h"
 #include "common.h"
+#include "crate_link.h"
 
 #include "board_parameter.h"
+#include "param_descriptor.h"
 
 class IChannelParameterNumeric;
 class IChannelParameterOnOff;
@@ -53,17 +55,25 @@ typedef std::shared_ptr< IChannelParameterOnOff    > ChannelParameterOnOff;
 typedef std::shared_ptr< IChannelParameterChStatus > ChannelParameterChStatus;
 typedef std::shared_ptr< IChannelParameterBinary   > ChannelParameterBinary;
 
+// Base class for all parameter types. The parameter properties are held in a descriptor,
+// which is shared by the same parameter on all the channels with the same properties.
 template<typename T>
 class ChannelParameterBase
 {
 public:
-    ChannelParameterBase(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    ChannelParameterBase(int h, std::size_t s, std::size_t c, ParamDescriptor d);
     virtual ~ChannelParameterBase() {};
 
-    std::string getMode()            { return modeStr;    };
-    std::string getEpicsParamName()  { return epicsParamName;  };
-    std::string getEpicsRecordName() { return epicsRecordName; };
-    std::string getEpicsDesc()       { return epicsDesc;       };
+    std::string getMode()            const { return processMode(desc->mode); };
+    int         getHandle()          const { return handle;                  };
+    std::size_t getSlot()            const { return slot;                    };
+    std::size_t getChannel()         const { return channel;                 };
+    std::string getParam()           const { return desc->name;              };
+    std::string getEpicsParamName()  const;
+    std::string getEpicsRecordName() const;
+    std::string getEpicsDesc()       const;
+
+    const ParamDescriptor& getDescriptor() const { return desc; };
 
     virtual void printInfo(std::ostream& stream) const;
 
@@ -71,16 +81,13 @@ public:
     virtual void setVal(T value) const;
 
 protected:
-    int         handle;
-    std::size_t slot;
-    std::size_t channel;
-    std::string param;
-    uint32_t    mode;
-    std::string type;
-    std::string modeStr;
-    std::string epicsParamName;
-    std::string epicsRecordName;
-    std::string epicsDesc;
+    // Create a standalone descriptor for a parameter
+    static ParamDescriptor createDescriptor(const std::string& p, uint32_t t, uint32_t m);
+
+    int             handle;
+    std::size_t     slot;
+    std::size_t     channel;
+    ParamDescriptor desc;
 };
 
 // Class for Numeric parameters
@@ -88,21 +95,24 @@ class IChannelParameterNumeric : public ChannelParameterBase<float>
 {
 public:
     IChannelParameterNumeric(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    IChannelParameterNumeric(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m, float min, float max, const std::string& u);
+    IChannelParameterNumeric(int h, std::size_t s, std::size_t c, ParamDescriptor d);
     ~IChannelParameterNumeric() {};
 
-    // Factory method
+    // Factory methods. The second and third ones use known properties, without reading them from the crate.
     static ChannelParameterNumeric create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    static ChannelParameterNumeric create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m, float min, float max, const std::string& u);
+    static ChannelParameterNumeric create(int h, std::size_t s, std::size_t c, ParamDescriptor d);
 
-    float       getMinVal() const { return minVal; };
-    float       getMaxVal() const { return maxVal; };
-    std::string getUnits()  const { return units;  };
+    float       getMinVal() const { return desc->minVal; };
+    float       getMaxVal() const { return desc->maxVal; };
+    std::string getUnits()  const { return desc->units;  };
 
     virtual void printInfo(std::ostream& stream) const;
 
 private:
-    float       minVal;
-    float       maxVal;
-    std::string units;
+    // Read the parameter properties from the crate
+    static ParamDescriptor discover(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
 };
 
 // Class for OnOff parameters
@@ -110,19 +120,23 @@ class IChannelParameterOnOff : public ChannelParameterBase<uint32_t>
 {
 public:
     IChannelParameterOnOff(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    IChannelParameterOnOff(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m, const std::string& on, const std::string& off);
+    IChannelParameterOnOff(int h, std::size_t s, std::size_t c, ParamDescriptor d);
     ~IChannelParameterOnOff() {};
 
-    // Factory method
+    // Factory methods. The second and third ones use known properties, without reading them from the crate.
     static ChannelParameterOnOff create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    static ChannelParameterOnOff create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m, const std::string& on, const std::string& off);
+    static ChannelParameterOnOff create(int h, std::size_t s, std::size_t c, ParamDescriptor d);
 
-    std::string getOnState()  const { return onState;  };
-    std::string getOffState() const { return offState; };
+    std::string getOnState()  const { return desc->onState;  };
+    std::string getOffState() const { return desc->offState; };
 
     virtual void printInfo(std::ostream& stream) const;
 
 private:
-    std::string onState;
-    std::string offState;
+    // Read the parameter properties from the crate
+    static ParamDescriptor discover(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
 };
 
 // Class for ChStatus parameters
@@ -130,10 +144,12 @@ class IChannelParameterChStatus : public ChannelParameterBase<uint32_t>
 {
 public:
     IChannelParameterChStatus(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    IChannelParameterChStatus(int h, std::size_t s, std::size_t c, ParamDescriptor d);
     ~IChannelParameterChStatus() {};
 
-    // Factory method
+    // Factory methods
     static ChannelParameterChStatus create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    static ChannelParameterChStatus create(int h, std::size_t s, std::size_t c, ParamDescriptor d);
 
     virtual void printInfo(std::ostream& stream) const;
 };
@@ -143,10 +159,12 @@ class IChannelParameterBinary : public ChannelParameterBase<int32_t>
 {
 public:
     IChannelParameterBinary(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    IChannelParameterBinary(int h, std::size_t s, std::size_t c, ParamDescriptor d);
     ~IChannelParameterBinary() {};
 
-    // Factory method
+    // Factory methods
     static ChannelParameterBinary create(int h, std::size_t s, std::size_t c, const std::string&  p, uint32_t m);
+    static ChannelParameterBinary create(int h, std::size_t s, std::size_t c, ParamDescriptor d);
 
     virtual void printInfo(std::ostream& stream) const;
 };
@@ -28,6 +28,15 @@ void printMessage(const std::string& f, const std::string& s)
     printf("function '%s' : %s\n", f.c_str(), s.c_str());
 }
 
+bool isSameBoard(const BoardInfo& a, const BoardInfo& b)
+{
+    return ( a.slot            == b.slot            ) &&
+           ( a.model           == b.model           ) &&
+           ( a.serialNumber    == b.serialNumber    ) &&
+           ( a.firmwareRelease == b.firmwareRelease ) &&
+           ( a.numChannels     == b.numChannels     );
+}
+
 std::string processParamName(std::string name)
 {
     // Make a copy
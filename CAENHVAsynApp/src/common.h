@@ -38,9 +38,49 @@
 #include <arpa/inet.h>
 #include <iostream>
 #include "CAENHVWrapper.h"
+#include "wire_stats.h"
 
+// Metadata of a board or channel parameter, as discovered from the crate:
+// - name     : parameter name,
+// - type     : parameter type (PARAM_TYPE_*),
+// - mode     : parameter access mode (PARAM_MODE_*),
+// - minVal   : minimum value, for numeric parameters,
+// - maxVal   : maximum value, for numeric parameters,
+// - units    : processed units string, for numeric parameters,
+// - onState  : on state label, for on/off parameters,
+// - offState : off state label, for on/off parameters.
+struct ParamInfo
+{
+    std::string name;
+    uint32_t    type;
+    uint32_t    mode;
+    float       minVal;
+    float       maxVal;
+    std::string units;
+    std::string onState;
+    std::string offState;
+};
+
+// Metadata of a board, and of all its parameters and channels.
+// The channel parameters are indexed by channel number.
+struct BoardInfo
+{
+    std::size_t                           slot;
+    std::string                           model;
+    std::string                           description;
+    std::size_t                           numChannels;
+    std::string                           serialNumber;
+    std::string                           firmwareRelease;
+    std::vector<ParamInfo>                params;
+    std::vector< std::vector<ParamInfo> > channelParams;
+};
 
 void printMessage(const std::string& f, const std::string& s);
+
+// Whether two boards have the same fingerprint: slot, model, serial number,
+// firmware release, and number of channels. Their parameters are not compared.
+bool isSameBoard(const BoardInfo& a, const BoardInfo& b);
+
 std::string processParamName(std::string name);
 std::string processMode(uint32_t mode);
 std::string processUnits(uint16_t units, int8_t exp);
@@ -21,16 +21,26 @@
 
 #include "crate.h"
 
+// Find the board of a slot in a crate map. It returns NULL if the slot is empty.
+static const BoardInfo* findSlot(const std::vector<BoardInfo>& slots, std::size_t slot)
+{
+    for (std::vector<BoardInfo>::const_iterator it = slots.begin(); it != slots.end(); ++it)
+        if ( it->slot == slot )
+            return &(*it);
+
+    return NULL;
+}
+
 void ICrate::GetPropList()
 {
     std::string functionName("GetPropList");
 
     unsigned short NumProp;
     char *PropNameList;
-    CAENHVRESULT r =  CAENHV_GetSysPropList(handle, &NumProp, &PropNameList);
+    CAENHVRESULT r =  linkCall(WIRE_GET_SYS_PROP_LIST, handle, [&](int libHandle) { return CAENHV_GetSysPropList(libHandle, &NumProp, &PropNameList); });
 
     std::stringstream retMessage;
-    retMessage << "CAENHV_GetSysPropList: " << CAENHV_GetError(handle) << " (num. " << r << ")";
+    retMessage << "CAENHV_GetSysPropList: " << linkError(handle) << " (num. " << r << ")";
 
     printMessage(functionName, retMessage.str().c_str());
 
@@ -45,7 +55,7 @@ void ICrate::GetPropList()
         // Get Property info
         unsigned PropMode;
         unsigned PropType;
-        if ( CAENHV_GetSysPropInfo(handle, p, &PropMode, &PropType) == CAENHV_OK )
+        if ( linkCall(WIRE_GET_SYS_PROP_INFO, handle, [&](int libHandle) { return CAENHV_GetSysPropInfo(libHandle, p, &PropMode, &PropType); }) == CAENHV_OK )
         {
             switch( PropType )
             {
@@ -88,98 +98,293 @@ void ICrate::GetCrateMap()
 {
     // Get Crate Map
     std::string functionName("GetCrateMap");
+    epicsTime   start( epicsTime::getCurrent() );
 
-    unsigned short NrOfSlot;
-    unsigned short *NrOfChList;
-    char *ModelList;
-    char *DescriptionList;
-    unsigned short *SerNumList;
-    unsigned char *FmwRelMinList;
-    unsigned char *FmwRelMaxList;
+    // Occupied slots
+    std::vector<BoardInfo> slots;
 
-    CAENHVRESULT r = CAENHV_GetCrateMap(handle, &NrOfSlot, &NrOfChList, &ModelList, &DescriptionList, &SerNumList, &FmwRelMinList, &FmwRelMaxList);
+    CAENHVRESULT r = linkCall(WIRE_GET_CRATE_MAP, handle, [&](int libHandle) { return ICrateLink::readCrateMap(libHandle, numSlots, slots); });
 
     std::stringstream retMessage;
-    retMessage << "CAENHV_GetCrateMap: " << CAENHV_GetError(handle) << " (num. " << r << ")";
+    retMessage << "CAENHV_GetCrateMap: " << linkError(handle) << " (num. " << r << ")";
 
     printMessage(functionName, retMessage.str().c_str());
 
     if ( r != CAENHV_OK )
         return;
 
+    crateMap = slots;
+
+    addDiscoveryTime("GetCrateMap", start);
+    start = epicsTime::getCurrent();
 
-    numSlots = NrOfSlot;
-    char *m = ModelList, *d = ModelList;
+    // Look for the boards in the discovery cache. Only the boards which are not
+    // in the cache, or which have changed, are discovered from the crate.
+    DiscoveryCache cache;
+    std::vector<const BoardInfo*> cached(slots.size(), NULL);
+    std::size_t numCached(0);
 
-    for (std::size_t i(0); i < NrOfSlot; ++i, m += strlen(m) + 1, d += strlen(d) + 1)
+    if ( ! cacheFile.empty() )
     {
-        if ( *m != '\0' )
+        cache = IDiscoveryCache::create(cacheFile);
+
+        std::stringstream cacheMessage;
+        if ( cache->load() )
+        {
+            for (std::size_t i(0); i < slots.size(); ++i)
+            {
+                if ( ( cached.at(i) = cache->find(slots.at(i)) ) )
+                    ++numCached;
+            }
+
+            cacheMessage << "Discovery cache '" << cacheFile << "' loaded. " << numCached << " of " << slots.size() << " boards have not changed";
+        }
+        else
         {
-            std::stringstream sn, fw;
+            cacheMessage << "Discovery cache '" << cacheFile << "' not found or not valid. All boards will be discovered";
+        }
+
+        printMessage(functionName, cacheMessage.str());
+        addDiscoveryTime("Cache load", start);
+        start = epicsTime::getCurrent();
+    }
+
+    // Create the Board objects. Each board is stored at the position of its slot
+    // in the list of occupied slots, so the order does not depend on the workers.
+    boards.assign(slots.size(), Board());
+
+    WorkPool pool( IWorkPool::create("CAENHVAsynBd", slotWorkers) );
+    pool->run( slots.size(), [this, &slots, &cached](std::size_t i)
+    {
+        const BoardInfo& info( slots.at(i) );
 
-            // Process the serial number
-            sn.str("");
-            sn << SerNumList[i];
+        if ( cached.at(i) )
+            boards.at(i) = IBoard::create(handle, *cached.at(i), registry);
+        else
+            boards.at(i) = IBoard::create(handle, info.slot, info.model, info.description, info.numChannels, info.serialNumber, info.firmwareRelease, channelWorkers, registry);
+    });
 
-            // Process the firmware release number
-            fw.str("");
-            fw << unsigned(FmwRelMaxList[i]) << "." << unsigned(FmwRelMinList[i]);
+    addDiscoveryTime("Boards", start);
 
-            // Create a new Slot object and add it to the vector
-            boards.push_back( IBoard::create(handle, i, m, d, NrOfChList[i], sn.str(), fw.str()) );
+    // Update the cache, if any board was discovered or was removed
+    if ( cache && ( ( numCached != slots.size() ) || ( cache->getSize() != slots.size() ) ) )
+    {
+        start = epicsTime::getCurrent();
+
+        std::vector<BoardInfo> info;
+        for (std::vector<Board>::const_iterator it = boards.begin(); it != boards.end(); ++it)
+            info.push_back( (*it)->getInfo() );
+
+        // A failure to write the cache is not fatal. The crate will be fully discovered on the next start.
+        try
+        {
+            cache->save(info);
+        }
+        catch(std::runtime_error& e)
+        {
+            printMessage(functionName, e.what());
         }
-    }
 
-    // Deallocate memory (Use RAII in the future for this)
-    free(NrOfChList);
-    free(ModelList);
-    free(DescriptionList);
-    free(SerNumList);
-    free(FmwRelMinList);
-    free(FmwRelMaxList);
+        addDiscoveryTime("Cache save", start);
+    }
 }
 
-ICrate::ICrate(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password)
+ICrate::ICrate(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password,
+               std::size_t slotWorkers, std::size_t channelWorkers, const std::string& cacheFile, const LinkConfig& linkConfig)
 :
-  handle(-1)
+  handle(-1),
+  slotWorkers(slotWorkers),
+  channelWorkers(channelWorkers),
+  cacheFile(cacheFile),
+  registry( IParamDescriptorRegistry::create() ),
+  numSlots(0)
 {
-    handle = InitSystem(systemType, ipAddr, userName, password);
+    epicsTime start( epicsTime::getCurrent() );
+    link   = ICrateLink::create(systemType, ipAddr, userName, password, linkConfig);
+    handle = link->getId();
+    addDiscoveryTime("InitSystem", start);
+
+    start = epicsTime::getCurrent();
     GetPropList();
+    addDiscoveryTime("GetPropList", start);
+
     GetCrateMap();
+
+    // From now on, the link is considered down after consecutive communication errors,
+    // and it is reconnected only if the same boards are found in the crate
+    link->start(numSlots, crateMap);
 }
 
-Crate ICrate::create(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password)
+Crate ICrate::create(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password,
+                     std::size_t slotWorkers, std::size_t channelWorkers, const std::string& cacheFile, const LinkConfig& linkConfig)
 {
-    return std::make_shared<ICrate>(systemType, ipAddr, userName, password);
+    return std::make_shared<ICrate>(systemType, ipAddr, userName, password, slotWorkers, channelWorkers, cacheFile, linkConfig);
 }
 
-ICrate::~ICrate()
+std::vector<Board> ICrate::getBoards() const
 {
+    boardsMutex.lock();
+    std::vector<Board> b(boards);
+    boardsMutex.unlock();
+
+    return b;
 }
 
-int ICrate::InitSystem(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password) const
+Board ICrate::getBoard(std::size_t slot) const
 {
-    int h;
-    std::string functionName("initSystem");
+    Board b;
 
-    CAENHVRESULT r = CAENHV_InitSystem( static_cast<CAENHV_SYSTEM_TYPE_t>(systemType),
-                                        LINKTYPE_TCPIP,
-                                        const_cast<void*>( static_cast<const void*>( ipAddr.c_str() ) ),
-                                        userName.c_str(),
-                                        password.c_str(),
-                                        &h );
+    boardsMutex.lock();
+    for (std::vector<Board>::const_iterator it = boards.begin(); it != boards.end(); ++it)
+        if ( (*it)->getSlot() == slot )
+            b = *it;
+    boardsMutex.unlock();
 
-    std::stringstream retMessage;
-    retMessage << "CAENHV_InitSystem: " << CAENHV_GetError(h) << " (num. " << r << ")";
+    return b;
+}
+
+std::vector<std::size_t> ICrate::checkCrateMap()
+{
+    std::size_t            n(0);
+    std::vector<BoardInfo> slots;
+
+    CAENHVRESULT r = linkCall(WIRE_GET_CRATE_MAP, handle, [&](int libHandle) { return ICrateLink::readCrateMap(libHandle, n, slots); });
+
+    if ( r != CAENHV_OK )
+    {
+        std::stringstream errMessage;
+        errMessage << "CAENHV_GetCrateMap: " << linkError(handle) << " (num. " << r << ")";
+        throw std::runtime_error(errMessage.str());
+    }
+
+    // Only the slots found during discovery are checked
+    std::vector<std::size_t> changed;
+
+    boardsMutex.lock();
+    lastCrateMap = slots;
+    for (std::size_t slot(0); slot < numSlots; ++slot)
+    {
+        const BoardInfo* before( findSlot(crateMap, slot) );
+        const BoardInfo* after( findSlot(slots, slot) );
+
+        if ( ( before == NULL ) && ( after == NULL ) )
+            continue;
 
+        if ( ( before == NULL ) || ( after == NULL ) || ( ! isSameBoard(*before, *after) ) )
+            changed.push_back(slot);
+    }
+    boardsMutex.unlock();
+
+    return changed;
+}
+
+Board ICrate::rediscoverSlot(std::size_t slot)
+{
+    std::string functionName("rediscoverSlot");
+    epicsTime   start( epicsTime::getCurrent() );
+
+    boardsMutex.lock();
+    const BoardInfo* found( findSlot(lastCrateMap, slot) );
+    bool             present( found != NULL );
+    BoardInfo        info;
+    if ( present )
+        info = *found;
+    boardsMutex.unlock();
+
+    // The board is discovered as during the start, using the discovery cache if possible.
+    // If it fails, nothing is changed, and the slot is discovered again on the next check.
+    Board          b;
+    DiscoveryCache cache;
+    bool           cached(false);
+
+    if ( present )
+    {
+        const BoardInfo* cachedInfo(NULL);
+
+        if ( ! cacheFile.empty() )
+        {
+            cache = IDiscoveryCache::create(cacheFile);
+            if ( cache->load() )
+                cachedInfo = cache->find(info);
+        }
+
+        cached = ( cachedInfo != NULL );
+
+        if ( cached )
+            b = IBoard::create(handle, *cachedInfo, registry);
+        else
+            b = IBoard::create(handle, info.slot, info.model, info.description, info.numChannels, info.serialNumber, info.firmwareRelease, channelWorkers, registry);
+    }
+
+    // Replace the board of the slot, keeping the boards ordered by slot number
+    std::vector<BoardInfo> boardsInfo;
+
+    boardsMutex.lock();
+
+    std::vector<Board>::iterator it = boards.begin();
+    while ( ( it != boards.end() ) && ( (*it)->getSlot() < slot ) )
+        ++it;
+    if ( ( it != boards.end() ) && ( (*it)->getSlot() == slot ) )
+        it = boards.erase(it);
+    if ( b )
+        boards.insert(it, b);
+
+    std::vector<BoardInfo>::iterator mapIt = crateMap.begin();
+    while ( ( mapIt != crateMap.end() ) && ( mapIt->slot < slot ) )
+        ++mapIt;
+    if ( ( mapIt != crateMap.end() ) && ( mapIt->slot == slot ) )
+        mapIt = crateMap.erase(mapIt);
+    if ( present )
+        crateMap.insert(mapIt, info);
+
+    std::vector<BoardInfo> slots(crateMap);
+
+    if ( ! cacheFile.empty() )
+        for (std::vector<Board>::const_iterator bIt = boards.begin(); bIt != boards.end(); ++bIt)
+            boardsInfo.push_back( (*bIt)->getInfo() );
+
+    boardsMutex.unlock();
+
+    // The link is reconnected with the new boards from now on
+    link->setCrateMap(slots);
+
+    // Update the cache, so the new board is not discovered again on the next start.
+    // A failure to write the cache is not fatal.
+    if ( ( ! cacheFile.empty() ) && ( ! cached ) )
+    {
+        if ( ! cache )
+            cache = IDiscoveryCache::create(cacheFile);
+
+        try
+        {
+            cache->save(boardsInfo);
+        }
+        catch(std::runtime_error& e)
+        {
+            printMessage(functionName, e.what());
+        }
+    }
+
+    std::stringstream retMessage;
+    retMessage << "Slot " << slot << ": ";
+    if ( present )
+        retMessage << "board " << info.model << " (serial number " << info.serialNumber << ", firmware " << info.firmwareRelease << ") discovered";
+    else
+        retMessage << "the slot is now empty";
+    retMessage << " in " << std::fixed << std::setprecision(3) << ( epicsTime::getCurrent() - start ) << " s";
     printMessage(functionName, retMessage.str());
 
-    if( r != CAENHV_OK )
-        throw std::runtime_error(retMessage.str().c_str());
+    return b;
+}
 
-    return h;
+void ICrate::addDiscoveryTime(const std::string& phase, const epicsTime& start)
+{
+    discoveryTimes.push_back( std::make_pair( phase, epicsTime::getCurrent() - start ) );
 }
 
+ICrate::~ICrate()
+{
+}
 
 void ICrate::printInfo(std::ostream& stream) const
 {
@@ -187,8 +392,10 @@ void ICrate::printInfo(std::ostream& stream) const
     stream << "Crate object information:" << std::endl;;
     stream << "=========================" << std::endl;;
     stream << "  handle = " << handle << std::endl;
+    stream << "  Link state : " << getLinkStateName( link->getState() ) << std::endl;
     stream << "  Number of slots  : " << numSlots << std::endl;
-    stream << "  Number of boards : " << boards.size() << std::endl;
+    std::vector<Board> b( getBoards() );
+    stream << "  Number of boards : " << b.size() << std::endl;
     stream << "  Properties:" << std::endl;;
     stream << "  ---------------------------" << std::endl;
     printProperties( stream, "integer", systemPropertyIntegers );
@@ -196,7 +403,7 @@ void ICrate::printInfo(std::ostream& stream) const
     printProperties( stream, "string",  systemPropertyStrings  );
     stream << "  Board information: " << std::endl;
     stream << "  ---------------------------" << std::endl;
-    for (std::vector<Board>::const_iterator it = boards.begin(); it != boards.end(); ++it)
+    for (std::vector<Board>::const_iterator it = b.begin(); it != b.end(); ++it)
         (*it)->printInfo(stream);
     stream << "=========================" << std::endl;;
     stream << std::endl;
@@ -207,16 +414,35 @@ void ICrate::printCrateMap(std::ostream& stream) const
     stream << "=============================" << std::endl;;
     stream << "Crate information:" << std::endl;;
     stream << "=============================" << std::endl;;
+    std::vector<Board> b( getBoards() );
     stream << "  Number of slots  : " << numSlots << std::endl;
-    stream << "  Number of boards : " << boards.size() << std::endl;
+    stream << "  Number of boards : " << b.size() << std::endl;
     stream << "  Board information: " << std::endl;
     stream << "  ---------------------------" << std::endl;
-    for (std::vector<Board>::const_iterator it = boards.begin(); it != boards.end(); ++it)
+    for (std::vector<Board>::const_iterator it = b.begin(); it != b.end(); ++it)
         (*it)->printBoardInfo(stream);
     stream << "  ---------------------------" << std::endl;
+    printDiscoveryTimes(stream);
     stream << "=============================" << std::endl;;
 }
 
+void ICrate::printDiscoveryTimes(std::ostream& stream) const
+{
+    double total(0);
+
+    stream << "  Board models with shared channel parameters : " << registry->getSize() << std::endl;
+    stream << "  Discovery times (" << slotWorkers << " slot workers, " << channelWorkers << " channel workers per slot):" << std::endl;
+    for (std::vector< std::pair<std::string, double> >::const_iterator it = discoveryTimes.begin(); it != discoveryTimes.end(); ++it)
+    {
+        stream << "    " << std::left << std::setw(12) << it->first << std::right << " : " << std::fixed << std::setprecision(3) << it->second << " s" << std::endl;
+        total += it->second;
+    }
+    stream << "    " << std::left << std::setw(12) << "Total" << std::right << " : " << std::fixed << std::setprecision(3) << total << " s" << std::endl;
+    stream.unsetf(std::ios_base::floatfield);
+    stream << std::setprecision(6);
+    stream << "  ---------------------------" << std::endl;
+}
+
 template <typename T>
 void ICrate::printProperties(std::ostream& stream, const std::string& type, const T& pv) const
 {
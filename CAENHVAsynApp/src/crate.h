@@ -36,11 +36,16 @@
 #include <inttypes.h>
 #include <arpa/inet.h>
 #include <iostream>
+#include <epicsTime.h>
+#include <epicsMutex.h>
 
 #include "CAENHVWrapper.h"
 #include "common.h"
 #include "board.h"
 #include "system_property.h"
+#include "work_pool.h"
+#include "discovery_cache.h"
+#include "crate_link.h"
 
 class SysProp;
 template<typename T>
@@ -53,38 +58,93 @@ typedef std::shared_ptr<ICrate> Crate;
 class ICrate
 {
 public:
-    ICrate(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password);
+    // The boards are discovered in parallel using up to 'slotWorkers' worker threads, and
+    // the channels of each board using up to 'channelWorkers' worker threads.
+    // If 'cacheFile' is not empty, the metadata of the boards which have not changed
+    // since the last start is read from that file, instead of from the crate.
+    // Once the crate is discovered, the circuit breaker of its link is armed with 'linkConfig'.
+    ICrate(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password,
+           std::size_t slotWorkers = 1, std::size_t channelWorkers = 1, const std::string& cacheFile = "",
+           const LinkConfig& linkConfig = defaultLinkConfig);
     ~ICrate();
 
     // Factory method
-    static Crate create(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password);
+    static Crate create(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password,
+                        std::size_t slotWorkers = 1, std::size_t channelWorkers = 1, const std::string& cacheFile = "",
+                        const LinkConfig& linkConfig = defaultLinkConfig);
+
+    int         getHandle()   const { return handle;   };
+    std::size_t getNumSlots() const { return numSlots; };
+
+    // Connection state of the crate
+    CrateLink   getLink()     const { return link;               };
+    bool        isConnected() const { return link->isConnected(); };
 
     void printInfo(std::ostream& stream) const;
     void printCrateMap(std::ostream& stream) const;
+    void printDiscoveryTimes(std::ostream& stream) const;
 
     std::vector<SystemPropertyInteger> getSystemPropertyIntegers() { return systemPropertyIntegers; };
     std::vector<SystemPropertyFloat>   getSystemPropertyFloats()   { return systemPropertyFloats;   };
     std::vector<SystemPropertyString>  getSystemPropertyStrings()  { return systemPropertyStrings;  };
 
-    std::vector<Board> getBoards() { return boards; };
+    std::vector<Board> getBoards() const;
+
+    // Get the board in a slot. It returns an empty pointer if the slot is empty.
+    Board getBoard(std::size_t slot) const;
+
+    // Read the crate map, and compare it with the boards found during discovery. It returns the slots
+    // whose board has changed: replaced by a board with a different model, serial number, firmware
+    // release, or number of channels, removed, or inserted in a slot which was empty.
+    std::vector<std::size_t> checkCrateMap();
+
+    // Discover again the board found in a slot by the last crate map check, and replace the previous
+    // board of the slot. It returns the new board, or an empty pointer if the slot is now empty.
+    // The other boards are not affected. It throws if the board can not be discovered.
+    Board rediscoverSlot(std::size_t slot);
 
 private:
 
-    int  InitSystem(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password) const;
     void GetPropList();
     void GetCrateMap();
 
     template <typename T>
     void printProperties(std::ostream& stream, const std::string& type, const T& pv) const;
 
-    int handle;
+    // Record the time spent on a discovery phase, since 'start'
+    void addDiscoveryTime(const std::string& phase, const epicsTime& start);
+
+    // Link to the crate. Its ID is used as the crate handle.
+    CrateLink link;
+    int       handle;
+
+    // Number of worker threads used to discover the boards, and the channels of each board
+    std::size_t slotWorkers;
+    std::size_t channelWorkers;
+
+    // Discovery cache file
+    std::string cacheFile;
+
+    // Parameter descriptors shared by the channels of boards of the same model and firmware release
+    ParamDescriptorRegistry registry;
+
+    // Time spent on each discovery phase, in seconds
+    std::vector< std::pair<std::string, double> > discoveryTimes;
 
     // Number of slot in the crate
     std::size_t numSlots;
 
-    // Slots in the crate
+    // Slots in the crate, ordered by slot number
     std::vector<Board> boards;
 
+    // Boards found in the crate by the discovery, and by the last crate map check.
+    // They only contain the board fingerprints, without parameters.
+    std::vector<BoardInfo> crateMap;
+    std::vector<BoardInfo> lastCrateMap;
+
+    // Protects the boards, and the crate maps, which are changed by the hot-plug check
+    mutable epicsMutex boardsMutex;
+
     // Crate properties
     std::vector<SystemPropertyInteger> systemPropertyIntegers;
     std::vector<SystemPropertyFloat>   systemPropertyFloats;
@@ -0,0 +1,404 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : crate_link.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Crate Link Class.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "crate_link.h"
+
+// Links of all the crates in the IOC, indexed by link ID. The links are never
+// removed, so they can be looked up without locks once they are registered.
+static CrateLink          crateLinks[MAX_CRATE_LINKS];
+static std::atomic<int>   numCrateLinks(0);
+static epicsMutex         crateLinksMutex;
+
+// Error message of the calls made while the link is down
+static const char* linkDownError = "The crate is not connected";
+
+const char* getLinkStateName(linkState_t s)
+{
+    switch (s)
+    {
+        case LINK_CONNECTED:    return "Connected";
+        case LINK_DISCONNECTED: return "Disconnected";
+        case LINK_RECONNECTING: return "Reconnecting";
+        default:                return "Unknown";
+    }
+}
+
+// C wrapper for the reconnection thread
+static void reconnectTaskC(void *pvt)
+{
+    ICrateLink *pPvt = (ICrateLink *)pvt;
+    pPvt->reconnectTask();
+}
+
+ICrateLink::ICrateLink(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password, const LinkConfig& config)
+:
+    systemType(systemType),
+    ipAddr(ipAddr),
+    userName(userName),
+    password(password),
+    config(config),
+    id(-1),
+    libHandle(-1),
+    state(LINK_CONNECTED),
+    failures(0),
+    armed(false),
+    acceptChanges(false),
+    serialized(false),
+    numSlots(0),
+    disconnections(0),
+    reconnections(0),
+    attempts(0),
+    rejected(0)
+{
+    std::string functionName("initSystem");
+
+    int h;
+    CAENHVRESULT r( initSystem(h) );
+
+    std::stringstream retMessage;
+    retMessage << "CAENHV_InitSystem: " << CAENHV_GetError(h) << " (num. " << r << ")";
+
+    printMessage(functionName, retMessage.str());
+
+    if( r != CAENHV_OK )
+        throw std::runtime_error(retMessage.str().c_str());
+
+    libHandle = h;
+}
+
+CrateLink ICrateLink::create(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password,
+                             const LinkConfig& config)
+{
+    CrateLink l( std::make_shared<ICrateLink>(systemType, ipAddr, userName, password, config) );
+
+    crateLinksMutex.lock();
+    int n( numCrateLinks.load() );
+    if ( n >= MAX_CRATE_LINKS )
+    {
+        crateLinksMutex.unlock();
+        throw std::runtime_error("Too many crates. The maximum number of crates is " + std::to_string(MAX_CRATE_LINKS));
+    }
+
+    // The link is stored before its ID is published
+    l->id = n;
+    crateLinks[n] = l;
+    numCrateLinks.store(n + 1);
+    crateLinksMutex.unlock();
+
+    return l;
+}
+
+void ICrateLink::start(std::size_t n, const std::vector<BoardInfo>& s)
+{
+    numSlots = n;
+    slots    = s;
+
+    // From now on, the library is called from the I/O worker, and from the reconnection
+    // and hot-plug threads, so the calls are serialized
+    serialized = true;
+
+    // With the circuit breaker disabled, the link never goes down
+    if ( config.maxFailures == 0 )
+        return;
+
+    failures = 0;
+    armed    = true;
+
+    epicsThreadCreate("CAENHVAsynLink",
+                      epicsThreadPriorityLow,
+                      epicsThreadGetStackSize(epicsThreadStackMedium),
+                      (EPICSTHREADFUNC)reconnectTaskC,
+                      this);
+}
+
+void ICrateLink::setCrateMap(const std::vector<BoardInfo>& s)
+{
+    slotsMutex.lock();
+    slots = s;
+    slotsMutex.unlock();
+}
+
+const char* ICrateLink::getError() const
+{
+    if ( state.load() != LINK_CONNECTED )
+        return linkDownError;
+
+    return CAENHV_GetError( libHandle.load() );
+}
+
+LinkStats ICrateLink::getStats() const
+{
+    LinkStats s;
+    s.disconnections = disconnections.load();
+    s.reconnections  = reconnections.load();
+    s.attempts       = attempts.load();
+    s.rejected       = rejected.load();
+
+    return s;
+}
+
+void ICrateLink::setStateCallback(std::function<void(linkState_t)> cb)
+{
+    callbackMutex.lock();
+    stateCallback = cb;
+    callbackMutex.unlock();
+}
+
+bool ICrateLink::isLinkError(CAENHVRESULT r)
+{
+    switch (r)
+    {
+        case CAENHV_WRITEERR:
+        case CAENHV_READERR:
+        case CAENHV_TIMEERR:
+        case CAENHV_DOWN:
+        case CAENHV_SOCKETERROR:
+        case CAENHV_COMMUNICATIONERROR:
+        case CAENHV_NOTCONNECTED:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void ICrateLink::record(CAENHVRESULT r)
+{
+    // Any other result, including the errors on a given parameter, means that the crate answered
+    if ( ! isLinkError(r) )
+    {
+        failures = 0;
+        return;
+    }
+
+    if ( ( ++failures < config.maxFailures ) || ( ! armed.load() ) )
+        return;
+
+    // Only the call which brings the link down changes the state
+    int expected(LINK_CONNECTED);
+    if ( ! state.compare_exchange_strong(expected, LINK_DISCONNECTED) )
+        return;
+
+    ++disconnections;
+
+    std::stringstream msg;
+    msg << "The crate at " << ipAddr << " is not responding after " << failures.load() << " consecutive communication errors. " \
+        << "The calls will fail until it is reconnected.";
+    printMessage("CrateLink", msg.str());
+
+    setState(LINK_DISCONNECTED);
+    event.signal();
+}
+
+void ICrateLink::setState(linkState_t s)
+{
+    state = s;
+
+    callbackMutex.lock();
+    std::function<void(linkState_t)> cb(stateCallback);
+    callbackMutex.unlock();
+
+    if ( cb )
+        cb(s);
+}
+
+CAENHVRESULT ICrateLink::initSystem(int& h)
+{
+    h = -1;
+
+    return wireCall(wireStats, WIRE_INIT_SYSTEM, [&]() {
+        return CAENHV_InitSystem( static_cast<CAENHV_SYSTEM_TYPE_t>(systemType),
+                                  LINKTYPE_TCPIP,
+                                  const_cast<void*>( static_cast<const void*>( ipAddr.c_str() ) ),
+                                  userName.c_str(),
+                                  password.c_str(),
+                                  &h );
+    });
+}
+
+CAENHVRESULT ICrateLink::readCrateMap(int h, std::size_t& n, std::vector<BoardInfo>& s)
+{
+    unsigned short NrOfSlot;
+    unsigned short *NrOfChList;
+    char *ModelList;
+    char *DescriptionList;
+    unsigned short *SerNumList;
+    unsigned char *FmwRelMinList;
+    unsigned char *FmwRelMaxList;
+
+    CAENHVRESULT r = CAENHV_GetCrateMap(h, &NrOfSlot, &NrOfChList, &ModelList, &DescriptionList, &SerNumList, &FmwRelMinList, &FmwRelMaxList);
+
+    if ( r != CAENHV_OK )
+        return r;
+
+    n = NrOfSlot;
+    s.clear();
+
+    char *m = ModelList, *d = DescriptionList;
+
+    for (std::size_t i(0); i < NrOfSlot; ++i, m += strlen(m) + 1, d += strlen(d) + 1)
+    {
+        if ( *m != '\0' )
+        {
+            std::stringstream sn, fw;
+
+            // Process the serial number
+            sn << SerNumList[i];
+
+            // Process the firmware release number
+            fw << unsigned(FmwRelMaxList[i]) << "." << unsigned(FmwRelMinList[i]);
+
+            BoardInfo info;
+            info.slot            = i;
+            info.model           = m;
+            info.description     = d;
+            info.numChannels     = NrOfChList[i];
+            info.serialNumber    = sn.str();
+            info.firmwareRelease = fw.str();
+            s.push_back(info);
+        }
+    }
+
+    // Deallocate memory (Use RAII in the future for this)
+    free(NrOfChList);
+    free(ModelList);
+    free(DescriptionList);
+    free(SerNumList);
+    free(FmwRelMinList);
+    free(FmwRelMaxList);
+
+    return r;
+}
+
+bool ICrateLink::reconnect()
+{
+    std::string functionName("CrateLink");
+
+    ++attempts;
+
+    // After a short outage the current connection may still be valid. Otherwise,
+    // it is closed, and a new one is opened.
+    // The handle is not replaced while a call which started before the link went down is still in progress
+    std::size_t            n(0);
+    std::vector<BoardInfo> s;
+    CAENHVRESULT           r;
+
+    {
+        epicsGuard<epicsMutex> guard(callMutex);
+
+        int h( libHandle.load() );
+
+        r = wireCall(wireStats, WIRE_GET_CRATE_MAP, [&]() { return readCrateMap(h, n, s); });
+
+        if ( isLinkError(r) )
+        {
+            CAENHV_DeinitSystem(h);
+
+            r = initSystem(h);
+            if ( r == CAENHV_OK )
+            {
+                // The new connection is kept for the next attempts
+                libHandle = h;
+
+                r = wireCall(wireStats, WIRE_GET_CRATE_MAP, [&]() { return readCrateMap(h, n, s); });
+            }
+        }
+    }
+
+    if ( r != CAENHV_OK )
+        return false;
+
+    // The objects of the crate can only be used if the same boards are found in the same slots,
+    // unless the changed boards are discovered again by the hot-plug check
+    slotsMutex.lock();
+    bool same( ( n == numSlots ) && ( s.size() == slots.size() ) );
+    for (std::size_t i(0); same && ( i < s.size() ); ++i)
+        same = isSameBoard( s.at(i), slots.at(i) );
+    slotsMutex.unlock();
+
+    if ( ! same )
+    {
+        std::stringstream msg;
+        msg << "The crate at " << ipAddr << " answered, but its boards have changed. ";
+        if ( ( n != numSlots ) || ( ! acceptChanges.load() ) )
+        {
+            msg << "The IOC must be restarted.";
+            printMessage(functionName, msg.str());
+            return false;
+        }
+
+        msg << "The changed slots will be rebuilt by the hot-plug check.";
+        printMessage(functionName, msg.str());
+    }
+
+    failures = 0;
+    ++reconnections;
+
+    std::stringstream msg;
+    msg << "The crate at " << ipAddr << " is connected again, after " << attempts.load() << " reconnection attempts in total.";
+    printMessage(functionName, msg.str());
+
+    setState(LINK_CONNECTED);
+
+    return true;
+}
+
+void ICrateLink::reconnectTask()
+{
+    for (;;)
+    {
+        event.wait();
+
+        // The delay between attempts is doubled after each failed attempt, so that
+        // a crate which is down for a long time is not flooded with connection requests
+        double delay( config.retryMin );
+
+        while ( state.load() != LINK_CONNECTED )
+        {
+            epicsThreadSleep(delay);
+
+            setState(LINK_RECONNECTING);
+
+            if ( reconnect() )
+                break;
+
+            setState(LINK_DISCONNECTED);
+
+            delay = std::min(2 * delay, config.retryMax);
+        }
+    }
+}
+
+ICrateLink& getCrateLink(int handle)
+{
+    if ( ( handle < 0 ) || ( handle >= numCrateLinks.load() ) )
+        throw std::runtime_error("Invalid crate handle " + std::to_string(handle));
+
+    return *crateLinks[handle];
+}
+
+const char* linkError(int handle)
+{
+    if ( ( handle < 0 ) || ( handle >= numCrateLinks.load() ) )
+        return linkDownError;
+
+    return getCrateLink(handle).getError();
+}
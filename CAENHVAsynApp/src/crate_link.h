@@ -0,0 +1,256 @@
+#ifndef CRATE_LINK_H
+#define CRATE_LINK_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : crate_link.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Crate Link Class.
+ * It holds the connection to a crate, and implements a circuit breaker on it.
+ * The objects of a crate do not use the handle returned by the CAEN HV Wrapper
+ * library, but the ID of the link, and make their calls through 'linkCall'. After
+ * a number of consecutive communication errors, the link is considered down, and
+ * all the calls fail immediately, while a background thread reconnects to the
+ * crate. The library handle can change on reconnection, without affecting the
+ * objects of the crate.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <algorithm>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <epicsThread.h>
+#include <epicsMutex.h>
+#include <epicsGuard.h>
+#include <epicsEvent.h>
+
+#include "CAENHVWrapper.h"
+#include "common.h"
+#include "wire_stats.h"
+
+// Maximum number of crate links in the IOC
+#define MAX_CRATE_LINKS (64)
+
+// Connection state of a crate:
+// - Connected    : the calls are made to the crate,
+// - Disconnected : the calls fail immediately, until the next reconnection attempt,
+// - Reconnecting : a reconnection attempt is in progress. The calls still fail immediately.
+enum linkState_t
+{
+    LINK_CONNECTED,
+    LINK_DISCONNECTED,
+    LINK_RECONNECTING,
+    NUM_LINK_STATES
+};
+
+// Get the name of a connection state
+const char* getLinkStateName(linkState_t s);
+
+// Configuration of the circuit breaker:
+// - maxFailures : number of consecutive communication errors after which the link is considered down.
+//                 Zero disables the circuit breaker, and the calls are always made to the crate,
+// - retryMin    : delay before the first reconnection attempt, in seconds,
+// - retryMax    : maximum delay between reconnection attempts, in seconds. The delay
+//                 is doubled after each failed attempt, up to this value.
+struct LinkConfig
+{
+    std::size_t maxFailures;
+    double      retryMin;
+    double      retryMax;
+};
+
+// Default configuration: the link is considered down after 3 consecutive communication
+// errors, and the reconnection is attempted after 1 s, and then at most every 10 s.
+static const LinkConfig defaultLinkConfig = { 3, 1.0, 10.0 };
+
+// Statistics of a link:
+// - disconnections : number of times the link went down,
+// - reconnections  : number of successful reconnections,
+// - attempts       : number of reconnection attempts,
+// - rejected       : number of calls which failed immediately because the link was down.
+struct LinkStats
+{
+    uint64_t disconnections;
+    uint64_t reconnections;
+    uint64_t attempts;
+    uint64_t rejected;
+};
+
+class ICrateLink;
+
+typedef std::shared_ptr<ICrateLink> CrateLink;
+
+class ICrateLink
+{
+public:
+    ICrateLink(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password, const LinkConfig& config);
+    ~ICrateLink() {};
+
+    // Factory method. It connects to the crate, and throws if the connection fails.
+    static CrateLink create(int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password,
+                            const LinkConfig& config);
+
+    // ID of the link. It is used as the crate handle by all the objects of the crate.
+    int getId() const { return id; };
+
+    // Arm the circuit breaker, and start the reconnection thread. The crate map is
+    // compared to the one read on each reconnection: if they differ, the link stays down.
+    // Before this call, the errors do not bring the link down, and the calls are not
+    // serialized, so that the discovery workers can make them in parallel.
+    void start(std::size_t numSlots, const std::vector<BoardInfo>& slots);
+
+    // Replace the crate map compared on each reconnection, after some boards were discovered again
+    void setCrateMap(const std::vector<BoardInfo>& slots);
+
+    // Accept a different crate map on reconnection. It is used when the changed boards
+    // are discovered again by the hot-plug check, so the link does not need to stay down.
+    void acceptMapChanges(bool accept) { acceptChanges = accept; };
+
+    // Make a call to the crate with the current library handle, and record it in the statistics
+    // of its type. When the link is down, the call fails immediately with CAENHV_NOTCONNECTED.
+    // Once the link is started, the calls are serialized, also with the reconnection, which
+    // replaces the library handle.
+    template <typename F>
+    CAENHVRESULT call(wireCall_t type, F f)
+    {
+        if ( state.load() != LINK_CONNECTED )
+        {
+            ++rejected;
+            return CAENHV_NOTCONNECTED;
+        }
+
+        auto doCall = [&]()
+        {
+            int h( libHandle.load() );
+            return wireCall(wireStats, type, [&]() { return f(h); });
+        };
+
+        CAENHVRESULT r;
+        if ( serialized.load() )
+        {
+            // The mutex is released also if the call throws
+            epicsGuard<epicsMutex> guard(callMutex);
+            r = doCall();
+        }
+        else
+        {
+            r = doCall();
+        }
+
+        record(r);
+
+        return r;
+    }
+
+    // Get the error message of the last call
+    const char* getError() const;
+
+    linkState_t getState()    const { return static_cast<linkState_t>( state.load() ); };
+    bool        isConnected() const { return ( state.load() == LINK_CONNECTED );      };
+    LinkStats   getStats()    const;
+
+    // Statistics of the calls made to the crate
+    WireStats&       getWireStats()       { return wireStats; };
+    const WireStats& getWireStats() const { return wireStats; };
+
+    // Set the function called on each change of the connection state. It is called
+    // from the thread which made the last failed call when the link goes down, and from
+    // the reconnection thread otherwise, and must not make calls to the crate.
+    void setStateCallback(std::function<void(linkState_t)> cb);
+
+    // Reconnection thread main loop
+    void reconnectTask();
+
+    // Read the crate map with a library handle. The occupied slots are returned, without
+    // their parameters. It does not go through the circuit breaker.
+    static CAENHVRESULT readCrateMap(int h, std::size_t& numSlots, std::vector<BoardInfo>& slots);
+
+private:
+    // Open a new connection to the crate, and return its library handle
+    CAENHVRESULT initSystem(int& h);
+
+    // Update the circuit breaker with the result of a call
+    void record(CAENHVRESULT r);
+
+    // Change the connection state, and call the state callback
+    void setState(linkState_t s);
+
+    // Try to reconnect to the crate. It returns true if the crate is connected again.
+    bool reconnect();
+
+    // Whether a result code means that the crate could not be reached
+    static bool isLinkError(CAENHVRESULT r);
+
+    int                       systemType;
+    std::string               ipAddr;
+    std::string               userName;
+    std::string               password;
+    LinkConfig                config;
+
+    int                       id;
+    std::atomic<int>          libHandle;
+    std::atomic<int>          state;
+    std::atomic<std::size_t>  failures;
+    std::atomic<bool>         armed;
+    std::atomic<bool>         acceptChanges;
+
+    // Serializes the calls made with the library handle, once the link is started
+    std::atomic<bool>         serialized;
+    epicsMutex                callMutex;
+
+    // Crate map found during discovery
+    std::size_t               numSlots;
+    std::vector<BoardInfo>    slots;
+    epicsMutex                slotsMutex;
+
+    std::atomic<uint64_t>     disconnections;
+    std::atomic<uint64_t>     reconnections;
+    std::atomic<uint64_t>     attempts;
+    std::atomic<uint64_t>     rejected;
+
+    // Statistics of the calls made to the crate
+    WireStats                 wireStats;
+
+    std::function<void(linkState_t)> stateCallback;
+    epicsMutex                       callbackMutex;
+
+    // Signaled when the link goes down
+    epicsEvent                event;
+};
+
+// Get the link of a crate handle
+ICrateLink& getCrateLink(int handle);
+
+// Make a call to the CAEN HV Wrapper library on a crate. The function 'f' receives the
+// library handle of the crate, which must be used instead of the crate handle.
+template <typename F>
+CAENHVRESULT linkCall(wireCall_t type, int handle, F f)
+{
+    return getCrateLink(handle).call(type, f);
+}
+
+// Get the error message of the last call made on a crate
+const char* linkError(int handle);
+
+#endif
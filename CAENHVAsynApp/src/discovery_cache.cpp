@@ -0,0 +1,256 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : discovery_cache.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Discovery Cache Class.
+ * It stores the metadata of the boards, board parameters, and channel
+ * parameters found in a crate, so that it can be reused on the next start
+ * for all the boards which have not changed.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "discovery_cache.h"
+
+// The cache file is a text file, with one record per line, and tab separated fields:
+//   VERSION  <version>
+//   BOARD    <slot> <model> <description> <number of channels> <serial number> <firmware release>
+//   BDPARAM  <name> <type> <mode> <min> <max> <units> <on state> <off state>
+//   CHANNEL  <channel>
+//   CHPARAM  <name> <type> <mode> <min> <max> <units> <on state> <off state>
+// BDPARAM and CHANNEL records belong to the previous BOARD record, and
+// CHPARAM records belong to the previous CHANNEL record.
+const int IDiscoveryCache::version = 1;
+
+IDiscoveryCache::IDiscoveryCache(const std::string& f)
+:
+    fileName(f)
+{
+}
+
+DiscoveryCache IDiscoveryCache::create(const std::string& f)
+{
+    return std::make_shared<IDiscoveryCache>(f);
+}
+
+std::vector<std::string> IDiscoveryCache::split(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::string              field;
+    std::istringstream       stream(line);
+
+    while ( std::getline(stream, field, '\t') )
+        fields.push_back(field);
+
+    // Keep a trailing empty field
+    if ( ( ! line.empty() ) && ( line.at(line.size() - 1) == '\t' ) )
+        fields.push_back("");
+
+    return fields;
+}
+
+void IDiscoveryCache::writeParam(std::ostream& stream, const std::string& tag, const ParamInfo& info)
+{
+    stream << tag           << '\t' \
+           << info.name     << '\t' \
+           << info.type     << '\t' \
+           << info.mode     << '\t' \
+           << info.minVal   << '\t' \
+           << info.maxVal   << '\t' \
+           << info.units    << '\t' \
+           << info.onState  << '\t' \
+           << info.offState << std::endl;
+}
+
+bool IDiscoveryCache::readParam(const std::vector<std::string>& fields, ParamInfo& info)
+{
+    if ( fields.size() != 9 )
+        return false;
+
+    char *end;
+
+    info.name = fields.at(1);
+
+    info.type = strtoul(fields.at(2).c_str(), &end, 10);
+    if ( *end != '\0' )
+        return false;
+
+    info.mode = strtoul(fields.at(3).c_str(), &end, 10);
+    if ( *end != '\0' )
+        return false;
+
+    info.minVal = strtof(fields.at(4).c_str(), &end);
+    if ( *end != '\0' )
+        return false;
+
+    info.maxVal = strtof(fields.at(5).c_str(), &end);
+    if ( *end != '\0' )
+        return false;
+
+    info.units    = fields.at(6);
+    info.onState  = fields.at(7);
+    info.offState = fields.at(8);
+
+    return true;
+}
+
+bool IDiscoveryCache::load()
+{
+    boards.clear();
+
+    std::ifstream file(fileName.c_str());
+    if ( ! file.is_open() )
+        return false;
+
+    std::map<std::size_t, BoardInfo> temp;
+    BoardInfo                        *board = NULL;
+    bool                             versionFound = false;
+    std::string                      line;
+
+    while ( std::getline(file, line) )
+    {
+        if ( line.empty() || ( line.at(0) == '#' ) )
+            continue;
+
+        std::vector<std::string> fields( split(line) );
+        const std::string&       tag( fields.at(0) );
+
+        if ( ! versionFound )
+        {
+            // The first record must be the version
+            if ( ( tag != "VERSION" ) || ( fields.size() != 2 ) || ( atoi(fields.at(1).c_str()) != version ) )
+                return false;
+
+            versionFound = true;
+        }
+        else if ( tag == "BOARD" )
+        {
+            if ( fields.size() != 7 )
+                return false;
+
+            BoardInfo info;
+            info.slot            = strtoul(fields.at(1).c_str(), NULL, 10);
+            info.model           = fields.at(2);
+            info.description     = fields.at(3);
+            info.numChannels     = strtoul(fields.at(4).c_str(), NULL, 10);
+            info.serialNumber    = fields.at(5);
+            info.firmwareRelease = fields.at(6);
+
+            board = &( temp[info.slot] = info );
+        }
+        else if ( ( tag == "BDPARAM" ) && board )
+        {
+            ParamInfo info;
+            if ( ! readParam(fields, info) )
+                return false;
+
+            board->params.push_back(info);
+        }
+        else if ( ( tag == "CHANNEL" ) && board )
+        {
+            // Channels must be listed in order
+            if ( ( fields.size() != 2 ) || ( strtoul(fields.at(1).c_str(), NULL, 10) != board->channelParams.size() ) )
+                return false;
+
+            board->channelParams.push_back( std::vector<ParamInfo>() );
+        }
+        else if ( ( tag == "CHPARAM" ) && board && ( ! board->channelParams.empty() ) )
+        {
+            ParamInfo info;
+            if ( ! readParam(fields, info) )
+                return false;
+
+            board->channelParams.back().push_back(info);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // Check that all the channels of each board are present
+    for (std::map<std::size_t, BoardInfo>::const_iterator it = temp.begin(); it != temp.end(); ++it)
+    {
+        if ( it->second.channelParams.size() != it->second.numChannels )
+            return false;
+    }
+
+    boards.swap(temp);
+
+    return true;
+}
+
+void IDiscoveryCache::save(const std::vector<BoardInfo>& b)
+{
+    boards.clear();
+    for (std::vector<BoardInfo>::const_iterator it = b.begin(); it != b.end(); ++it)
+        boards[it->slot] = *it;
+
+    // Write to a temporary file first, so that an interrupted write doesn't leave a truncated cache
+    std::string   tempFileName(fileName + ".tmp");
+    std::ofstream file(tempFileName.c_str());
+
+    if ( ! file.is_open() )
+        throw std::runtime_error("Could not open the discovery cache file '" + tempFileName + "'");
+
+    file.precision(9);
+    file << "# CAENHVAsyn discovery cache. Delete this file to force a full discovery of the crate." << std::endl;
+    file << "VERSION" << '\t' << version << std::endl;
+
+    for (std::map<std::size_t, BoardInfo>::const_iterator it = boards.begin(); it != boards.end(); ++it)
+    {
+        const BoardInfo& info(it->second);
+
+        file << "BOARD"                << '\t' \
+             << info.slot              << '\t' \
+             << info.model             << '\t' \
+             << info.description       << '\t' \
+             << info.numChannels       << '\t' \
+             << info.serialNumber      << '\t' \
+             << info.firmwareRelease   << std::endl;
+
+        for (std::vector<ParamInfo>::const_iterator pIt = info.params.begin(); pIt != info.params.end(); ++pIt)
+            writeParam(file, "BDPARAM", *pIt);
+
+        for (std::size_t c(0); c < info.channelParams.size(); ++c)
+        {
+            file << "CHANNEL" << '\t' << c << std::endl;
+
+            for (std::vector<ParamInfo>::const_iterator pIt = info.channelParams.at(c).begin(); pIt != info.channelParams.at(c).end(); ++pIt)
+                writeParam(file, "CHPARAM", *pIt);
+        }
+    }
+
+    file.close();
+
+    if ( file.fail() )
+        throw std::runtime_error("Error while writing the discovery cache file '" + tempFileName + "'");
+
+    if ( rename(tempFileName.c_str(), fileName.c_str()) )
+        throw std::runtime_error("Could not rename the discovery cache file '" + tempFileName + "' to '" + fileName + "'");
+}
+
+const BoardInfo* IDiscoveryCache::find(const BoardInfo& board) const
+{
+    std::map<std::size_t, BoardInfo>::const_iterator it = boards.find(board.slot);
+
+    if ( it == boards.end() )
+        return NULL;
+
+    if ( ! isSameBoard(it->second, board) )
+        return NULL;
+
+    return &it->second;
+}
@@ -0,0 +1,84 @@
+#ifndef DISCOVERY_CACHE_H
+#define DISCOVERY_CACHE_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : discovery_cache.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Discovery Cache Class.
+ * It stores the metadata of the boards, board parameters, and channel
+ * parameters found in a crate, so that it can be reused on the next start
+ * for all the boards which have not changed.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <map>
+#include <memory>
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+#include <iostream>
+#include <fstream>
+
+#include "common.h"
+
+class IDiscoveryCache;
+
+typedef std::shared_ptr<IDiscoveryCache> DiscoveryCache;
+
+class IDiscoveryCache
+{
+public:
+    IDiscoveryCache(const std::string& f);
+    ~IDiscoveryCache() {};
+
+    // Factory method
+    static DiscoveryCache create(const std::string& f);
+
+    // Load the cache file. It returns false if the file doesn't exist, was written
+    // with a different version, or is malformed. In that case the cache is empty.
+    bool load();
+
+    // Replace the content of the cache, and write it to the file
+    void save(const std::vector<BoardInfo>& boards);
+
+    // Find the cached metadata of a board. The board fingerprint (slot, model,
+    // serial number, firmware release, and number of channels) must match.
+    // It returns NULL if the board is not in the cache, or if it has changed.
+    const BoardInfo* find(const BoardInfo& board) const;
+
+    std::size_t        getSize()     const { return boards.size(); };
+    const std::string& getFileName() const { return fileName;      };
+
+private:
+    // Cache file format version. It must be incremented when the format changes.
+    static const int version;
+
+    static void writeParam(std::ostream& stream, const std::string& tag, const ParamInfo& info);
+    static bool readParam(const std::vector<std::string>& fields, ParamInfo& info);
+    static std::vector<std::string> split(const std::string& line);
+
+    std::string                       fileName;
+    std::map<std::size_t, BoardInfo>  boards;
+};
+
+#endif
@@ -25,6 +25,223 @@
 // which means that the autogeration is disabled.
 std::string CAENHVAsyn::epicsPrefix;
 std::string CAENHVAsyn::crateInfoFilePath = "/tmp/";
+double      CAENHVAsyn::pollPeriod = 1.0;
+ScanClassList CAENHVAsyn::scanClasses;
+std::vector<DeadbandRule> CAENHVAsyn::deadbands;
+double      CAENHVAsyn::writeWindow = 0;
+bool        CAENHVAsyn::asyncWrites = false;
+bool        CAENHVAsyn::eventMode  = false;
+int         CAENHVAsyn::eventPort  = 0;
+std::size_t CAENHVAsyn::discoverySlotWorkers    = 1;
+std::size_t CAENHVAsyn::discoveryChannelWorkers = 1;
+std::string CAENHVAsyn::discoveryCachePath;
+LinkConfig  CAENHVAsyn::linkConfig = defaultLinkConfig;
+SlotBreakerConfig CAENHVAsyn::slotBreakerConfig = defaultSlotBreakerConfig;
+double      CAENHVAsyn::hotPlugPeriod = 30.0;
+std::vector<HistoryRule> CAENHVAsyn::histories;
+PostMortemConfig CAENHVAsyn::postMortemConfig = defaultPostMortemConfig;
+std::map<std::string, CAENHVAsyn*> CAENHVAsyn::drivers;
+
+// Maximum time the crate information thread waits for the first poller cycle, in seconds
+static const double infoPollTimeout = 60.0;
+
+// Update period of the diagnostic parameters, in seconds
+static const double diagPeriod = 1.0;
+
+// Time to wait before checking again for events, when no events were received, in seconds
+static const double eventIdleTime = 0.02;
+
+// Current time, in seconds since the POSIX epoch. It is used as the time of the history samples.
+static double getPosixTime()
+{
+    epicsTimeStamp ts = epicsTime::getCurrent();
+    return ts.secPastEpoch + static_cast<double>(POSIX_TIME_AT_EPICS_EPOCH) + ts.nsec * 1e-9;
+}
+
+// C wrapper for the poller thread
+static void pollerTaskC(void *drvPvt)
+{
+    static_cast<CAENHVAsyn*>(drvPvt)->pollerTask();
+}
+
+// C wrapper for the event thread
+static void eventTaskC(void *drvPvt)
+{
+    static_cast<CAENHVAsyn*>(drvPvt)->eventTask();
+}
+
+// C wrapper for the write queue thread
+static void writerTaskC(void *drvPvt)
+{
+    static_cast<CAENHVAsyn*>(drvPvt)->writerTask();
+}
+
+// C wrapper for the diagnostic thread
+static void diagTaskC(void *drvPvt)
+{
+    static_cast<CAENHVAsyn*>(drvPvt)->diagTask();
+}
+
+// C wrapper for the hot-plug thread
+static void hotPlugTaskC(void *drvPvt)
+{
+    static_cast<CAENHVAsyn*>(drvPvt)->hotPlugTask();
+}
+
+// C wrapper for the post-mortem thread
+static void postMortemTaskC(void *drvPvt)
+{
+    static_cast<CAENHVAsyn*>(drvPvt)->postMortemTask();
+}
+
+// C wrapper for the crate information thread
+static void infoTaskC(void *drvPvt)
+{
+    static_cast<CAENHVAsyn*>(drvPvt)->infoTask();
+}
+
+// Init hook used to write the crate information once the IOC is running
+static void infoInitHook(initHookState state)
+{
+    if ( state == initHookAfterIocRunning )
+        CAENHVAsyn::startInfoTasks();
+}
+
+// Quote and escape a string for the JSON output of the crate information
+static std::string jsonString(const std::string& s)
+{
+    std::stringstream temp;
+    temp << '"';
+    for (std::string::const_iterator it = s.begin(); it != s.end(); ++it)
+    {
+        switch (*it)
+        {
+            case '"':  temp << "\\\""; break;
+            case '\\': temp << "\\\\"; break;
+            case '\n': temp << "\\n";  break;
+            case '\t': temp << "\\t";  break;
+            default:
+                if ( static_cast<unsigned char>(*it) < 0x20 )
+                    temp << "\\u" << std::hex << std::setfill('0') << std::setw(4) << static_cast<int>(*it) << std::dec;
+                else
+                    temp << *it;
+        }
+    }
+    temp << '"';
+    return temp.str();
+}
+
+// Name of a board or channel parameter type
+static std::string paramTypeName(uint32_t type)
+{
+    switch (type)
+    {
+        case PARAM_TYPE_NUMERIC:  return "Numeric";
+        case PARAM_TYPE_ONOFF:    return "OnOff";
+        case PARAM_TYPE_CHSTATUS: return "ChStatus";
+        case PARAM_TYPE_BDSTATUS: return "BdStatus";
+        case PARAM_TYPE_BINARY:   return "Binary";
+        default:                  return "Unsupported";
+    }
+}
+
+// Type of event value associated to each type of parameter value
+static eventValueType_t eventValueType(float)    { return EVENT_VALUE_FLOAT; }
+static eventValueType_t eventValueType(uint32_t) { return EVENT_VALUE_UINT;  }
+static eventValueType_t eventValueType(int32_t)  { return EVENT_VALUE_INT;   }
+
+// Handler records associated to each type of parameter
+template <typename T>
+static ParamHandler newHandler(paramHandlerKind_t kind, T p, int slot, int channel, bool polled)
+{
+    ParamHandler h;
+    h.kind    = kind;
+    h.slot    = slot;
+    h.channel = channel;
+    h.polled  = polled;
+    h.object  = p.get();
+    return h;
+}
+
+static ParamHandler makeHandler(SystemPropertyInteger    p, bool polled) { return newHandler(HANDLER_SYSTEM_INTEGER,   p, -1,             -1,                polled); }
+static ParamHandler makeHandler(SystemPropertyFloat      p, bool polled) { return newHandler(HANDLER_SYSTEM_FLOAT,     p, -1,             -1,                polled); }
+static ParamHandler makeHandler(SystemPropertyString     p, bool polled) { return newHandler(HANDLER_SYSTEM_STRING,    p, -1,             -1,                polled); }
+static ParamHandler makeHandler(BoardParameterNumeric    p, bool polled) { return newHandler(HANDLER_BOARD_NUMERIC,    p, p->getSlot(), -1,                polled); }
+static ParamHandler makeHandler(BoardParameterOnOff      p, bool polled) { return newHandler(HANDLER_BOARD_ONOFF,      p, p->getSlot(), -1,                polled); }
+static ParamHandler makeHandler(BoardParameterChStatus   p, bool polled) { return newHandler(HANDLER_BOARD_CHSTATUS,   p, p->getSlot(), -1,                polled); }
+static ParamHandler makeHandler(BoardParameterBdStatus   p, bool polled) { return newHandler(HANDLER_BOARD_BDSTATUS,   p, p->getSlot(), -1,                polled); }
+static ParamHandler makeHandler(ChannelParameterNumeric  p, bool polled) { return newHandler(HANDLER_CHANNEL_NUMERIC,  p, p->getSlot(), p->getChannel(), polled); }
+static ParamHandler makeHandler(ChannelParameterOnOff    p, bool polled) { return newHandler(HANDLER_CHANNEL_ONOFF,    p, p->getSlot(), p->getChannel(), polled); }
+static ParamHandler makeHandler(ChannelParameterChStatus p, bool polled) { return newHandler(HANDLER_CHANNEL_CHSTATUS, p, p->getSlot(), p->getChannel(), polled); }
+static ParamHandler makeHandler(ChannelParameterBinary   p, bool polled) { return newHandler(HANDLER_CHANNEL_BINARY,   p, p->getSlot(), p->getChannel(), polled); }
+
+// Status words are read with a higher priority than the rest of the parameters. The poller and
+// the asyn requests use the kind of handler of the parameter, so they use the same priority.
+static bool isStatusKind(paramHandlerKind_t kind)
+{
+    return ( kind == HANDLER_BOARD_CHSTATUS ) || ( kind == HANDLER_BOARD_BDSTATUS ) || ( kind == HANDLER_CHANNEL_CHSTATUS );
+}
+
+template <typename T>
+static bool isStatusParam(T p) { return isStatusKind( makeHandler(p, true).kind ); }
+
+// Asyn address of the parameters of a board: system properties use address 0,
+// and board and channel parameters use the address of their slot
+template <typename T>
+static int getSlotAddress(T p)                     { return p->getSlot() + 1; }
+static int getSlotAddress(SystemPropertyInteger)   { return 0; }
+static int getSlotAddress(SystemPropertyFloat)     { return 0; }
+static int getSlotAddress(SystemPropertyString)    { return 0; }
+
+int CAENHVAsyn::createIndexedParam(const std::string& name, asynParamType type, int addr)
+{
+    // The parameter is only created in the list of its address
+    int reason;
+    if ( createParam(addr, name.c_str(), type, &reason) != asynSuccess )
+        throw std::runtime_error("Failed to create asyn parameter '" + name + "'");
+
+    int index( static_cast<int>( paramAddresses.size() ) );
+    paramAddresses.push_back(addr);
+    paramReasons.push_back(reason);
+
+    if ( addrParams.size() <= static_cast<std::size_t>(addr) )
+        addrParams.resize(addr + 1);
+    if ( addrParams.at(addr).size() <= static_cast<std::size_t>(reason) )
+        addrParams.at(addr).resize(reason + 1, -1);
+    addrParams.at(addr).at(reason) = index;
+
+    paramIndex.insert( std::make_pair(name, index) );
+
+    return index;
+}
+
+int CAENHVAsyn::getParamIndex(asynUser *pasynUser)
+{
+    int addr;
+    if ( getAddress(pasynUser, &addr) != asynSuccess )
+        return -1;
+
+    if ( ( addr < 0 ) || ( static_cast<std::size_t>(addr) >= addrParams.size() ) )
+        return -1;
+
+    const std::vector<int>& params( addrParams.at(addr) );
+    if ( ( pasynUser->reason < 0 ) || ( static_cast<std::size_t>(pasynUser->reason) >= params.size() ) )
+        return -1;
+
+    return params.at(pasynUser->reason);
+}
+
+void CAENHVAsyn::callAddrCallbacks(const std::set<int>& addrs)
+{
+    for (std::set<int>::const_iterator it = addrs.begin(); it != addrs.end(); ++it)
+        callParamCallbacks(*it, *it);
+}
+
+void CAENHVAsyn::callAllParamCallbacks()
+{
+    for (int addr(0); addr < maxAddr; ++addr)
+        callParamCallbacks(addr, addr);
+}
 
 template <typename T>
 void CAENHVAsyn::createParamFloat(T p, std::map<int, T>& list)
@@ -37,19 +254,25 @@ void CAENHVAsyn::createParamFloat(T p, std::map<int, T>& list)
     float       min        = p->getMinVal();
     float       max        = p->getMaxVal();
 
-    int index;
-    createParam(paramName.c_str(), asynParamFloat64, &index);
+    int index( createIndexedParam(paramName, asynParamFloat64, getSlotAddress(p)) );
 
     list.insert( std::make_pair(index, p) );
 
+    // Readback records of parameters updated by the poller are processed on I/O interrupts
+    bool polled( addToPoller(p, index) );
+    std::string scan( polled ? "I/O Intr" : "1 second" );
+
+    handlers.set( index, makeHandler(p, polled) );
+
     if (!epicsPrefix.empty())
     {
         std::stringstream dbParamsLocal;
 
-        // Create list of parameter to pass to the  dbLoadRecords function
+        // Create list of parameter to pass to the  record file
         dbParamsLocal.str("");
         dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
         dbParamsLocal << ",PORT="  << portName_;
+        dbParamsLocal << ",ADDR="  << getParamAddr(index);
         dbParamsLocal << ",PARAM=" << paramName;
         dbParamsLocal << ",DESC="  << desc;
         dbParamsLocal << ",EGU="   << egu;
@@ -58,9 +281,9 @@ void CAENHVAsyn::createParamFloat(T p, std::map<int, T>& list)
 
         if ( (!mode.compare("RW")) || (!mode.compare("RO")) )
         {
-            dbParamsLocal << ",SCAN=1 second";
+            dbParamsLocal << ",SCAN=" << scan;
             dbParamsLocal << ",R=" << recordName << ":Rd";
-            dbLoadRecords("db/ai.template", dbParamsLocal.str().c_str());
+            records->add("db/ai.template", dbParamsLocal.str().c_str());
         }
 
         if ( (!mode.compare("RW")) || (!mode.compare("WO")) )
@@ -68,7 +291,7 @@ void CAENHVAsyn::createParamFloat(T p, std::map<int, T>& list)
             dbParamsLocal << ",DRVL=" << min;
             dbParamsLocal << ",DRVH=" << max;
             dbParamsLocal << ",R="    << recordName << ":St";
-            dbLoadRecords("db/ao.template", dbParamsLocal.str().c_str());
+            records->add("db/ao.template", dbParamsLocal.str().c_str());
         }
 
     }
@@ -84,19 +307,25 @@ void CAENHVAsyn::createParamFloat(SystemPropertyFloat p, std::map<int, SystemPro
     std::string desc       = p->getEpicsDesc();
     std::string mode       = p->getMode();
 
-    int index;
-    createParam(paramName.c_str(), asynParamFloat64, &index);
+    int index( createIndexedParam(paramName, asynParamFloat64, getSlotAddress(p)) );
 
     list.insert( std::make_pair(index, p) );
 
+    // Readback records of parameters updated by the poller are processed on I/O interrupts
+    bool polled( addToPoller(p, index) );
+    std::string scan( polled ? "I/O Intr" : "1 second" );
+
+    handlers.set( index, makeHandler(p, polled) );
+
     if (!epicsPrefix.empty())
     {
         std::stringstream dbParamsLocal;
 
-        // Create list of parameter to pass to the  dbLoadRecords function
+        // Create list of parameter to pass to the  record file
         dbParamsLocal.str("");
         dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
         dbParamsLocal << ",PORT="  << portName_;
+        dbParamsLocal << ",ADDR="  << getParamAddr(index);
         dbParamsLocal << ",PARAM=" << paramName;
         dbParamsLocal << ",DESC="  << desc;
         dbParamsLocal << ",EGU=";
@@ -105,9 +334,9 @@ void CAENHVAsyn::createParamFloat(SystemPropertyFloat p, std::map<int, SystemPro
 
         if ( (!mode.compare("RW")) || (!mode.compare("RO")) )
         {
-            dbParamsLocal << ",SCAN=1 second";
+            dbParamsLocal << ",SCAN=" << scan;
             dbParamsLocal << ",R=" << recordName << ":Rd";
-            dbLoadRecords("db/ai.template", dbParamsLocal.str().c_str());
+            records->add("db/ai.template", dbParamsLocal.str().c_str());
         }
 
         if ( (!mode.compare("RW")) || (!mode.compare("WO")) )
@@ -115,7 +344,7 @@ void CAENHVAsyn::createParamFloat(SystemPropertyFloat p, std::map<int, SystemPro
             dbParamsLocal << ",DRVL=";
             dbParamsLocal << ",DRVH=";
             dbParamsLocal << ",R="    << recordName << ":St";
-            dbLoadRecords("db/ao.template", dbParamsLocal.str().c_str());
+            records->add("db/ao.template", dbParamsLocal.str().c_str());
         }
 
     }
@@ -131,19 +360,25 @@ void CAENHVAsyn::createParamBinary(T p, std::map<int, T>& list)
     std::string onLabel    = p->getOnState();
     std::string offLabel   = p->getOffState();
 
-    int index;
-    createParam(paramName.c_str(), asynParamUInt32Digital, &index);
+    int index( createIndexedParam(paramName, asynParamUInt32Digital, getSlotAddress(p)) );
 
     list.insert( std::make_pair(index, p) );
 
+    // Readback records of parameters updated by the poller are processed on I/O interrupts
+    bool polled( addToPoller(p, index) );
+    std::string scan( polled ? "I/O Intr" : "1 second" );
+
+    handlers.set( index, makeHandler(p, polled) );
+
     if (!epicsPrefix.empty())
     {
         std::stringstream dbParamsLocal;
 
-        // Create list of parameter to pass to the  dbLoadRecords function
+        // Create list of parameter to pass to the  record file
         dbParamsLocal.str("");
         dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
         dbParamsLocal << ",PORT="  << portName_;
+        dbParamsLocal << ",ADDR="  << getParamAddr(index);
         dbParamsLocal << ",PARAM=" << paramName;
         dbParamsLocal << ",DESC="  << desc;
         dbParamsLocal << ",ZNAM="  << offLabel;
@@ -152,15 +387,15 @@ void CAENHVAsyn::createParamBinary(T p, std::map<int, T>& list)
 
         if ( (!mode.compare("RW")) || (!mode.compare("RO")) )
         {
-            dbParamsLocal << ",SCAN=1 second";
+            dbParamsLocal << ",SCAN=" << scan;
             dbParamsLocal << ",R=" << recordName << ":Rd";
-            dbLoadRecords("db/bi.template", dbParamsLocal.str().c_str());
+            records->add("db/bi.template", dbParamsLocal.str().c_str());
         }
 
         if ( (!mode.compare("RW")) || (!mode.compare("WO")) )
         {
             dbParamsLocal << ",R="    << recordName << ":St";
-            dbLoadRecords("db/bo.template", dbParamsLocal.str().c_str());
+            records->add("db/bo.template", dbParamsLocal.str().c_str());
         }
     }
 }
@@ -172,19 +407,25 @@ void CAENHVAsyn::createParamMBinary(T p, std::map<int, T>& list, const statusRec
     std::string recordName = p->getEpicsRecordName();
     std::string mode       = p->getMode();
 
-    int index;
-    createParam(paramName.c_str(), asynParamUInt32Digital, &index);
+    int index( createIndexedParam(paramName, asynParamUInt32Digital, getSlotAddress(p)) );
 
     list.insert( std::make_pair(index, p) );
 
+    // Readback records of parameters updated by the poller are processed on I/O interrupts
+    bool polled( addToPoller(p, index) );
+    std::string scan( polled ? "I/O Intr" : "1 second" );
+
+    handlers.set( index, makeHandler(p, polled) );
+
     if (!epicsPrefix.empty())
     {
         std::stringstream dbParamsLocal;
 
-        // Create list of paramater to pass to the  dbLoadRecords function
+        // Create list of paramater to pass to the  record file
         dbParamsLocal.str("");
         dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
         dbParamsLocal << ",PORT="  << portName_;
+        dbParamsLocal << ",ADDR="  << getParamAddr(index);
         dbParamsLocal << ",PARAM=" << paramName;
         dbParamsLocal << ",ZNAM=Off";
         dbParamsLocal << ",ONAM=On";
@@ -196,11 +437,11 @@ void CAENHVAsyn::createParamMBinary(T p, std::map<int, T>& list, const statusRec
                 std::stringstream dbParamsLocal2;
                 dbParamsLocal2.str("");
                 dbParamsLocal2 <<  dbParamsLocal.str();
-                dbParamsLocal2 << ",SCAN=1 second";
+                dbParamsLocal2 << ",SCAN=" << scan;
                 dbParamsLocal2 << ",MASK=" << it->first;
                 dbParamsLocal2 << ",DESC=" << it->second.second;
                 dbParamsLocal2 << ",R="    << recordName << it->second.first << ":Rd";
-                dbLoadRecords("db/bi.template", dbParamsLocal2.str().c_str());
+                records->add("db/bi.template", dbParamsLocal2.str().c_str());
             }
         }
 
@@ -215,7 +456,7 @@ void CAENHVAsyn::createParamMBinary(T p, std::map<int, T>& list, const statusRec
                 dbParamsLocal2 << ",MASK=" << it->first;
                 dbParamsLocal2 << ",DESC=" << it->second.second;
                 dbParamsLocal2 << ",R="    << recordName << it->second.first << ":Rd";
-                dbLoadRecords("db/bo.template", dbParamsLocal2.str().c_str());
+                records->add("db/bo.template", dbParamsLocal2.str().c_str());
             }
         }
 
@@ -230,33 +471,39 @@ void CAENHVAsyn::createParamInteger(T p, std::map<int, T>& list)
     std::string desc       = p->getEpicsDesc();
     std::string mode       = p->getMode();
 
-    int index;
-    createParam(paramName.c_str(), asynParamInt32, &index);
+    int index( createIndexedParam(paramName, asynParamInt32, getSlotAddress(p)) );
 
     list.insert( std::make_pair(index, p) );
 
+    // Readback records of parameters updated by the poller are processed on I/O interrupts
+    bool polled( addToPoller(p, index) );
+    std::string scan( polled ? "I/O Intr" : "1 second" );
+
+    handlers.set( index, makeHandler(p, polled) );
+
     if (!epicsPrefix.empty())
     {
         std::stringstream dbParamsLocal;
 
-        // Create list of paramater to pass to the  dbLoadRecords function
+        // Create list of paramater to pass to the  record file
         dbParamsLocal.str("");
         dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
         dbParamsLocal << ",PORT="  << portName_;
+        dbParamsLocal << ",ADDR="  << getParamAddr(index);
         dbParamsLocal << ",PARAM=" << paramName;
         dbParamsLocal << ",DESC="  << desc;
 
         if ( (!mode.compare("RW")) || (!mode.compare("RO")) )
         {
             dbParamsLocal << ",R=" << recordName << ":Rd";
-            dbParamsLocal << ",SCAN=1 second";
-            dbLoadRecords("db/longin.template", dbParamsLocal.str().c_str());
+            dbParamsLocal << ",SCAN=" << scan;
+            records->add("db/longin.template", dbParamsLocal.str().c_str());
         }
 
         if ( (!mode.compare("RW")) || (!mode.compare("WO")) )
         {
             dbParamsLocal << ",R=" << recordName << ":St";
-            dbLoadRecords("db/longout.template", dbParamsLocal.str().c_str());
+            records->add("db/longout.template", dbParamsLocal.str().c_str());
         }
     }
 }
@@ -269,19 +516,25 @@ void CAENHVAsyn::createParamString(T p, std::map<int, T>& list)
     std::string desc       = p->getEpicsDesc();
     std::string mode       = p->getMode();
 
-    int index;
-    createParam(paramName.c_str(), asynParamOctet, &index);
+    int index( createIndexedParam(paramName, asynParamOctet, getSlotAddress(p)) );
 
     list.insert( std::make_pair(index, p) );
 
+    // Readback records of parameters updated by the poller are processed on I/O interrupts
+    bool polled( addToPoller(p, index) );
+    std::string scan( polled ? "I/O Intr" : "1 second" );
+
+    handlers.set( index, makeHandler(p, polled) );
+
     if (!epicsPrefix.empty())
     {
         std::stringstream dbParamsLocal;
 
-        // Create list of paramater to pass to the  dbLoadRecords function
+        // Create list of paramater to pass to the  record file
         dbParamsLocal.str("");
         dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
         dbParamsLocal << ",PORT="  << portName_;
+        dbParamsLocal << ",ADDR="  << getParamAddr(index);
         dbParamsLocal << ",PARAM=" << paramName;
         dbParamsLocal << ",DESC="  << desc;
         dbParamsLocal << ",NELM=4096";
@@ -289,305 +542,3450 @@ void CAENHVAsyn::createParamString(T p, std::map<int, T>& list)
         if ( (!mode.compare("RW")) || (!mode.compare("RO")) )
         {
             dbParamsLocal << ",R=" << recordName << ":Rd";
-            dbParamsLocal << ",SCAN=1 second";
-            dbLoadRecords("db/stringin.template", dbParamsLocal.str().c_str());
+            dbParamsLocal << ",SCAN=" << scan;
+            records->add("db/stringin.template", dbParamsLocal.str().c_str());
         }
 
         if ( (!mode.compare("RW")) || (!mode.compare("WO")) )
         {
             dbParamsLocal << ",R=" << recordName << ":St";
-            dbLoadRecords("db/stringout.template", dbParamsLocal.str().c_str());
+            records->add("db/stringout.template", dbParamsLocal.str().c_str());
         }
     }
 }
 
-CAENHVAsyn::CAENHVAsyn(const std::string& portName, int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password)
-:
-    asynPortDriver(
-        portName.c_str(),
-        MAX_SIGNALS,
-        NUM_PARAMS,
-        asynInt32Mask | asynDrvUserMask | asynInt16ArrayMask | asynInt32ArrayMask | asynOctetMask | \
-        asynFloat64ArrayMask | asynUInt32DigitalMask | asynFloat64Mask,                             // Interface Mask
-        asynInt16ArrayMask | asynInt32ArrayMask | asynInt32Mask | asynUInt32DigitalMask,            // Interrupt Mask
-        ASYN_MULTIDEVICE | ASYN_CANBLOCK,                                                           // asynFlags
-        1,                                                                                          // Autoconnect
-        0,                                                                                          // Default priority
-        0),                                                                                         // Default stack size
-    driverName_("CAENHVAsyn"),
-    portName_(portName)
+template <typename T>
+void CAENHVAsyn::createParamArray(std::vector< PollEntry<T> >& list, bool isFloat)
 {
-    // Check parameters
-    if ( portName_.empty() )
-        throw std::runtime_error("The port name must be defined");
-
-    if ( userName.empty() )
-        throw std::runtime_error("The user name must be defined");
-
-    if ( ipAddr.empty() )
-        throw std::runtime_error("The IP address must be defined");
-    else
+    for (typename std::vector< PollEntry<T> >::iterator it = list.begin(); it != list.end(); ++it)
     {
-        unsigned char buf[sizeof(struct in6_addr)];
-        if (!inet_pton(AF_INET, ipAddr.c_str(), buf))
-            throw std::runtime_error("Invalid IP address");
-    }
+        std::stringstream temp;
+        std::string param( processParamName(it->group->getParam()) );
 
-    // Only SYx527 are supported at the
-    if ( (systemType < 0) || (systemType > 3) )
-        throw std::runtime_error("Unsupported system type. Only supported types are SYx527 (0-3)");
+        temp.str("");
+        temp << "S" << std::setfill('0') << std::setw(2) << it->group->getSlot() << "_" << param << "_ARR";
+        std::string paramName( temp.str() );
 
-    // Create a Crate object
-    crate = ICrate::create(systemType, ipAddr, userName, password);
+        temp.str("");
+        temp << "S" << std::setfill('0') << std::setw(2) << it->group->getSlot() << ":" << param << "_ARR";
+        std::string recordName( temp.str() );
 
-    // Print the crate map to the IOC shell
-    std::cout << std::endl;
-    crate->printCrateMap(std::cout);
-    std::cout << std::endl;
+        temp.str("");
+        temp << "'Slot " << it->group->getSlot() << ", " << it->group->getParam() << ", all channels'";
+        std::string desc( temp.str() );
 
-    // Print Crate information
-    //crate->printInfo(std::cout);
+        int index( createIndexedParam(paramName, isFloat ? asynParamFloat64Array : asynParamInt32Array, it->group->getSlot() + 1) );
 
-    // Print Crate information to a temporal file
-    // This need to be reimplemented using RAII...
-    // Also, the user should be able to override the output location
-    std::string infoFileName(crateInfoFilePath + this->driverName_ + "_" + this->portName_ + "_crateInfo.txt");
-    std::ofstream infoFile;
+        ArrayParam a;
+        a.isFloat = isFloat;
+        a.values.resize( it->group->getSize() );
+        std::map<int, ArrayParam>::iterator aIt = arrayParamList.insert( std::make_pair(index, a) ).first;
 
-    std::cout << "Dumping crate information on '" << infoFileName << "'... ";
-    infoFile.open(infoFileName);
-    crate->printInfo(infoFile);
-    infoFile.close();
-    std::cout  << "Done" << std::endl;
+        ParamHandler h;
+        h.kind    = isFloat ? HANDLER_FLOAT64_ARRAY : HANDLER_INT32_ARRAY;
+        h.slot    = it->group->getSlot();
+        h.channel = -1;
+        h.polled  = true;
+        h.object  = &aIt->second;
+        handlers.set(index, h);
 
-    if (epicsPrefix.empty())
-        std::cout << "Autogeneration of PVs is disabled." << std::endl;
-    else
-        std::cout << "Autogeneration of PVs is enabled with prefix '" << epicsPrefix << "'" << std::endl;
+        it->arrayIndex = index;
 
-    // System properties
-    {
-        std::vector<SystemPropertyInteger> s = crate->getSystemPropertyIntegers();
-        for (std::vector<SystemPropertyInteger>::iterator it = s.begin(); it != s.end(); ++it)
-            createParamInteger<SystemPropertyInteger>(*it, systemPropertyIntegerList);
+        if (!epicsPrefix.empty())
+        {
+            std::stringstream dbParamsLocal;
+
+            // Create list of parameter to pass to the  record file
+            dbParamsLocal.str("");
+            dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
+            dbParamsLocal << ",PORT="  << portName_;
+            dbParamsLocal << ",ADDR="  << getParamAddr(index);
+            dbParamsLocal << ",PARAM=" << paramName;
+            dbParamsLocal << ",DESC="  << desc;
+            dbParamsLocal << ",DTYP="  << ( isFloat ? "asynFloat64ArrayIn" : "asynInt32ArrayIn" );
+            dbParamsLocal << ",FTVL="  << ( isFloat ? "DOUBLE" : "LONG" );
+            dbParamsLocal << ",NELM="  << it->group->getSize();
+            dbParamsLocal << ",SCAN="  << "I/O Intr";
+            dbParamsLocal << ",R="     << recordName << ":Rd";
+            records->add("db/waveform.template", dbParamsLocal.str().c_str());
+        }
     }
+}
 
+void CAENHVAsyn::createParamHistory(std::vector< PollEntry<ChannelParameterGroupFloat> >& list)
+{
+    for (std::vector< PollEntry<ChannelParameterGroupFloat> >::iterator it = list.begin(); it != list.end(); ++it)
     {
-        std::vector<SystemPropertyFloat> s = crate->getSystemPropertyFloats();
-        for (std::vector<SystemPropertyFloat>::iterator it = s.begin(); it != s.end(); ++it)
-            createParamFloat<SystemPropertyFloat>(*it, systemPropertyFloatList);
-    }
+        const HistoryRule* rule( getHistoryRule(it->group->getParam()) );
+        if ( ! rule )
+            continue;
 
-    {
-        std::vector<SystemPropertyString> s = crate->getSystemPropertyStrings();
-        for (std::vector<SystemPropertyString>::iterator it = s.begin(); it != s.end(); ++it)
-            createParamString<SystemPropertyString>(*it, systemPropertyStringList);
-    }
+        std::size_t slot( it->group->getSlot() );
+        std::string param( processParamName(it->group->getParam()) );
 
-    // Boards
-    std::vector<Board> b = crate->getBoards();
+        // The values, one row per sample and one column per channel, and the time of each sample
+        HistoryParam hp;
+        hp.buffer = IHistoryBuffer::create(it->group->getSize(), rule->capacity, rule->decimation);
 
-    for (std::vector<Board>::iterator boardIt = b.begin(); boardIt != b.end(); ++boardIt)
-    {
-        std::vector<BoardParameterNumeric> pn = (*boardIt)->getBoardParameterNumerics();
+        int indexes[2];
+        for (int i(0); i < 2; ++i)
+        {
+            const char* suffix( i ? "_HIST_T" : "_HIST" );
+            std::stringstream temp;
 
-        for (std::vector<BoardParameterNumeric>::iterator paramIt = pn.begin(); paramIt != pn.end(); ++paramIt)
-            createParamFloat<BoardParameterNumeric>(*paramIt, boardParameterNumericList);
+            temp.str("");
+            temp << "S" << std::setfill('0') << std::setw(2) << slot << "_" << param << suffix;
+            std::string paramName( temp.str() );
 
-        std::vector<BoardParameterOnOff> po = (*boardIt)->getBoardParameterOnOffs();
+            temp.str("");
+            temp << "S" << std::setfill('0') << std::setw(2) << slot << ":" << param << suffix;
+            std::string recordName( temp.str() );
 
-        for (std::vector<BoardParameterOnOff>::iterator paramIt = po.begin(); paramIt != po.end(); ++paramIt)
-            createParamBinary<BoardParameterOnOff>(*paramIt, boardParameterOnOffList);
+            temp.str("");
+            temp << "'Slot " << slot << ", " << it->group->getParam() << ( i ? ", history times'" : ", history'" );
+            std::string desc( temp.str() );
 
-        std::vector<BoardParameterChStatus> pcs = (*boardIt)->getBoardParameterChStatuses();
+            indexes[i] = createIndexedParam(paramName, asynParamFloat64Array, slot + 1);
 
-        for (std::vector<BoardParameterChStatus>::iterator paramIt = pcs.begin(); paramIt != pcs.end(); ++paramIt)
-            createParamMBinary<BoardParameterChStatus>(*paramIt, boardParameterChStatusList, recordFieldBdParamChStatus);
+            if (!epicsPrefix.empty())
+            {
+                std::stringstream dbParamsLocal;
+
+                // The history is only read when the record is processed
+                dbParamsLocal.str("");
+                dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
+                dbParamsLocal << ",PORT="  << portName_;
+                dbParamsLocal << ",ADDR="  << getParamAddr(indexes[i]);
+                dbParamsLocal << ",PARAM=" << paramName;
+                dbParamsLocal << ",DESC="  << desc;
+                dbParamsLocal << ",DTYP="  << "asynFloat64ArrayIn";
+                dbParamsLocal << ",FTVL="  << "DOUBLE";
+                dbParamsLocal << ",NELM="  << ( i ? 1 : it->group->getSize() ) * rule->capacity;
+                dbParamsLocal << ",SCAN="  << "Passive";
+                dbParamsLocal << ",R="     << recordName << ":Rd";
+                records->add("db/waveform.template", dbParamsLocal.str().c_str());
+            }
+        }
 
-        std::vector<BoardParameterBdStatus> pbs = (*boardIt)->getBoardParameterBdStatuses();
+        hp.timesIndex = indexes[1];
+        std::map<int, HistoryParam>::iterator hIt = historyParamList.insert( std::make_pair(indexes[0], hp) ).first;
 
-        for (std::vector<BoardParameterBdStatus>::iterator paramIt = pbs.begin(); paramIt != pbs.end(); ++paramIt)
-            createParamMBinary<BoardParameterBdStatus>(*paramIt, boardParameterBdStatusList, recordFieldBdParamBdStatus);
+        for (int i(0); i < 2; ++i)
+        {
+            ParamHandler h;
+            h.kind    = i ? HANDLER_HISTORY_TIMES : HANDLER_HISTORY_VALUES;
+            h.slot    = slot;
+            h.channel = -1;
+            h.polled  = true;
+            h.object  = hIt->second.buffer.get();
+            handlers.set(indexes[i], h);
+        }
 
-        std::vector<Channel> c = (*boardIt)->getChannels();
+        it->historyIndex = indexes[0];
+    }
+}
 
-        for(std::vector<Channel>::iterator channelIt = c.begin(); channelIt != c.end(); ++channelIt)
-        {
-            std::vector<ChannelParameterNumeric> cpn = (*channelIt)->getChannelParameterNumerics();
-            for (std::vector<ChannelParameterNumeric>::iterator paramIt = cpn.begin(); paramIt != cpn.end(); ++paramIt)
-                createParamFloat<ChannelParameterNumeric>(*paramIt, channelParameterNumericList);
+const HistoryRule* CAENHVAsyn::getHistoryRule(const std::string& param)
+{
+    // The first history rule matching the parameter name is used
+    for (std::vector<HistoryRule>::const_iterator it = histories.begin(); it != histories.end(); ++it)
+        if ( epicsStrGlobMatch(param.c_str(), it->pattern.c_str()) )
+            return &(*it);
 
-            std::vector<ChannelParameterOnOff> cpo = (*channelIt)->getChannelParameterOnOffs();
-            for (std::vector<ChannelParameterOnOff>::iterator paramIt = cpo.begin(); paramIt != cpo.end(); ++paramIt)
-                createParamBinary<ChannelParameterOnOff>(*paramIt, channelParameterOnOffList);
+    return NULL;
+}
 
-            std::vector<ChannelParameterChStatus> cpcs = (*channelIt)->getChannelParameterChStatuses();
-            for (std::vector<ChannelParameterChStatus>::iterator paramIt = cpcs.begin(); paramIt != cpcs.end(); ++paramIt)
-                createParamMBinary<ChannelParameterChStatus>(*paramIt, channelParameterChStatusList, recordFieldChParamChStatus);
+template <typename T, typename U>
+void CAENHVAsyn::addToPollList(T p, int index, std::vector< PollEntry<U> >& list)
+{
+    std::pair<std::size_t, std::string> key( p->getSlot(), p->getParam() );
+    std::map< std::pair<std::size_t, std::string>, std::size_t >::iterator it = pollIndex.find(key);
 
-            std::vector<ChannelParameterBinary> cpb = (*channelIt)->getChannelParameterBinaries();
-            for (std::vector<ChannelParameterBinary>::iterator paramIt = cpb.begin(); paramIt != cpb.end(); ++paramIt)
-                createParamInteger<ChannelParameterBinary>(*paramIt, channelParameterBinaryList);
-        }
+    // Create a new group the first time a parameter is found on a board
+    if ( it == pollIndex.end() )
+    {
+        PollEntry<U> e;
+        e.group      = U::element_type::create(p->getHandle(), p->getSlot(), p->getParam());
+        e.scanClass  = getScanClass(p->getParam());
+        e.arrayIndex   = -1;
+        e.historyIndex = -1;
+        e.subscribed   = false;
+        e.priority   = getPollPriority(e.scanClass, isStatusParam(p));
+        list.push_back(e);
+        it = pollIndex.insert( std::make_pair( key, list.size() - 1 ) ).first;
     }
+
+    PollEntry<U>& e = list.at(it->second);
+    e.group->addChannel(p->getChannel());
+    e.indexes.push_back(index);
+
+    setDeadband(index, p->getParam());
 }
 
-////////////////////////////////////////////
-// Methods overridden from asynPortDriver //
-////////////////////////////////////////////
-asynStatus CAENHVAsyn::readInt32(asynUser *pasynUser, epicsInt32 *value)
+template <typename T, typename U>
+void CAENHVAsyn::addToBoardPollList(T p, int index, std::vector< PollEntry<U> >& list, std::map< std::string, std::size_t >& listIndex)
 {
-    static std::string method("readInt32");
-    int function(pasynUser->reason);
-    int status(0);
+    std::string key( p->getParam() );
+    std::map< std::string, std::size_t >::iterator it = listIndex.find(key);
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
+    // Create a new group the first time a parameter is found on any board
+    if ( it == listIndex.end() )
+    {
+        PollEntry<U> e;
+        e.group      = U::element_type::create(p->getHandle(), p->getParam());
+        e.scanClass  = getScanClass(p->getParam());
+        e.arrayIndex   = -1;
+        e.historyIndex = -1;
+        e.subscribed   = false;
+        e.priority   = getPollPriority(e.scanClass, isStatusParam(p));
+        list.push_back(e);
+        it = listIndex.insert( std::make_pair( key, list.size() - 1 ) ).first;
+    }
 
-    const char *name;
-    getParamName(addr, function, &name);
+    PollEntry<U>& e = list.at(it->second);
+    e.group->addBoard(p->getSlot());
+    e.indexes.push_back(index);
 
-    // Iterators
-    std::map< int, SystemPropertyInteger >::iterator spIt;
+    setDeadband(index, p->getParam());
+}
 
-    // Check if the function is found in out lists
-    bool found = false;
+template <typename T, typename U>
+void CAENHVAsyn::addToSystemPollList(T p, int index, std::vector< PollEntry<U> >& list)
+{
+    PollEntry<U> e;
+    e.group      = U::element_type::create(p);
+    e.scanClass  = getScanClass(p->getProp());
+    e.arrayIndex   = -1;
+    e.historyIndex = -1;
+    e.subscribed   = false;
+    e.priority   = getPollPriority(e.scanClass, false);
+    e.indexes.push_back(index);
+    list.push_back(e);
+
+    setDeadband(index, p->getProp());
+}
 
-    // Look for the function number in the parameter lists
-    try
+void CAENHVAsyn::setDeadband(int index, const std::string& param)
+{
+    if ( publishedValues.size() <= static_cast<std::size_t>(index) )
     {
-        if ( ( spIt = systemPropertyIntegerList.find(function) ) != systemPropertyIntegerList.end() )
-        {
-            *value = spIt->second->getVal();
-            found = true;
-        }
+        PublishedValue p;
+        p.valid    = false;
+        p.value    = 0;
+        p.absolute = 0;
+        p.relative = 0;
+        publishedValues.resize(index + 1, p);
     }
-    catch(std::runtime_error& e)
+
+    // The first deadband rule matching the parameter name is used
+    for (std::vector<DeadbandRule>::const_iterator it = deadbands.begin(); it != deadbands.end(); ++it)
     {
-        status = -1;
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+        if ( epicsStrGlobMatch(param.c_str(), it->pattern.c_str()) )
+        {
+            publishedValues.at(index).absolute = it->absolute;
+            publishedValues.at(index).relative = it->relative;
+            break;
+        }
     }
+}
 
-    // If the function was not found, fall back to the base method
-    if (!found)
-        status = asynPortDriver::readInt32(pasynUser, value);
+bool CAENHVAsyn::isPublished(const std::vector<int>& indexes)
+{
+    bool published(true);
 
-    // Log status and return
-    if (0 == status)
+    lock();
+    for (std::vector<int>::const_iterator it = indexes.begin(); it != indexes.end(); ++it)
     {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, *value);
-
-        return asynSuccess;
+        if ( ! publishedValues.at(*it).valid )
+        {
+            published = false;
+            break;
+        }
     }
-    else
-    {
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, status);
+    unlock();
 
-        return asynError;
-    }
+    return published;
 }
 
-asynStatus CAENHVAsyn::writeInt32(asynUser *pasynUser, epicsInt32 value)
+bool CAENHVAsyn::isChanged(const PublishedValue& p, float value) const
 {
-    static std::string method("writeInt32");
-    int function(pasynUser->reason);
-    int status(0);
+    double diff = fabs(value - p.value);
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
+    if ( diff == 0 )
+        return false;
 
-    const char *name;
-    getParamName(addr, function, &name);
+    if ( ( p.absolute > 0 ) && ( diff <= p.absolute ) )
+        return false;
 
-    // Iterators
-    std::map< int, SystemPropertyInteger >::iterator spIt;
+    if ( ( p.relative > 0 ) && ( diff <= p.relative * fabs(p.value) ) )
+        return false;
 
-    // Check if the function is found in out lists
-    bool found = false;
+    return true;
+}
 
-    // Look for the function number in the parameter lists
-    try
-    {
-        if ( ( spIt = systemPropertyIntegerList.find(function) ) != systemPropertyIntegerList.end() )
-        {
-            spIt->second->setVal(value);
-            found = true;
-        }
-    }
-    catch(std::runtime_error& e)
-    {
-        status = -1;
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
-    }
+template <typename T>
+bool CAENHVAsyn::updateParamValue(int index, T value)
+{
+    PublishedValue& p = publishedValues.at(index);
 
-    // If the function was not found, fall back to the base method
-    if (!found)
-        status = asynPortDriver::writeInt32(pasynUser, value);
+    // The value is always published if no value has been published yet,
+    // or if the last read failed
+    if ( p.valid && ( ! isChanged(p, value) ) )
+        return false;
 
-    // Log status and return
-    if (0 == status)
-    {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value);
+    setParamValue(index, value);
+    p.valid = true;
+    p.value = value;
 
-        return asynSuccess;
-    }
-    else
+    return true;
+}
+
+bool CAENHVAsyn::updateParamValue(int index, const std::string& value)
+{
+    PublishedValue& p = publishedValues.at(index);
+
+    if ( p.valid && ( ! p.text.compare(value) ) )
+        return false;
+
+    setParamValue(index, value);
+    p.valid = true;
+    p.text  = value;
+
+    return true;
+}
+
+template <typename T>
+void CAENHVAsyn::updateArrayValues(int index, const std::vector<T>& vals)
+{
+    ArrayParam& a = arrayParamList.at(index);
+    a.values.assign(vals.begin(), vals.end());
+
+    doArrayCallbacks(index);
+}
+
+template <typename T>
+void CAENHVAsyn::recordHistory(int index, double time, const std::vector<T>& vals)
+{
+    historyParamList.at(index).buffer->record(time, vals);
+}
+
+void CAENHVAsyn::checkTrip(int index, uint32_t value, double time)
+{
+    const ParamHandler& h( handlers.get(index) );
+    if ( h.kind != HANDLER_CHANNEL_CHSTATUS )
+        return;
+
+    // The state before the first value, or after a failed read, is not known
+    const PublishedValue& p( publishedValues.at(index) );
+    if ( ! p.valid )
+        return;
+
+    uint32_t bits( value & ~static_cast<uint32_t>(p.value) & TRIP_STATUS_MASK );
+    if ( bits == 0 )
+        return;
+
+    TripEvent t;
+    t.slot    = h.slot;
+    t.channel = h.channel;
+    t.status  = bits;
+    t.time    = time;
+    postMortem->trigger(t);
+}
+
+void CAENHVAsyn::doArrayCallbacks(int index)
+{
+    ArrayParam& a = arrayParamList.at(index);
+
+    if ( a.isFloat )
+    {
+        std::vector<epicsFloat64> temp(a.values.begin(), a.values.end());
+        doCallbacksFloat64Array(temp.empty() ? NULL : &temp.at(0), temp.size(), getParamReason(index), getParamAddr(index));
+    }
+    else
+    {
+        std::vector<epicsInt32> temp;
+        temp.reserve(a.values.size());
+        for (std::vector<double>::const_iterator it = a.values.begin(); it != a.values.end(); ++it)
+            temp.push_back( static_cast<epicsInt32>( static_cast<int64_t>(*it) ) );
+        doCallbacksInt32Array(temp.empty() ? NULL : &temp.at(0), temp.size(), getParamReason(index), getParamAddr(index));
+    }
+}
+
+std::size_t CAENHVAsyn::getScanClass(const std::string& param) const
+{
+    // Parameters not included in any of the loaded scan classes use the default one
+    if ( ! scanClasses )
+        return 0;
+
+    int i = scanClasses->find(param);
+
+    return ( i < 0 ) ? 0 : i + 1;
+}
+
+ioPriority_t CAENHVAsyn::getPollPriority(std::size_t scanClass, bool status) const
+{
+    if ( status )
+        return IO_PRIORITY_HIGH;
+
+    // Scan classes slower than the poller period, or read only once, are considered diagnostics
+    double period( scanSchedule.at(scanClass).period );
+    if ( ( period <= 0 ) || ( period > pollPeriod_ ) )
+        return IO_PRIORITY_LOW;
+
+    return IO_PRIORITY_NORMAL;
+}
+
+ioPriority_t CAENHVAsyn::getReadPriority(const ParamHandler& h) const
+{
+    return isStatusKind(h.kind) ? IO_PRIORITY_HIGH : IO_PRIORITY_NORMAL;
+}
+
+void CAENHVAsyn::ioRun(ioPriority_t priority, int slot, std::function<void()> job)
+{
+    // The port is unlocked while waiting, as the worker takes the port lock
+    // to publish the results of the previous jobs
+    unlock();
+    try
+    {
+        ioWorker->run(priority, slot, job);
+    }
+    catch(std::runtime_error& e)
+    {
+        lock();
+        throw;
+    }
+    lock();
+}
+
+void CAENHVAsyn::ioWrite(int function, std::function<void()> write)
+{
+    if ( ! asyncWrites )
+    {
+        ioRun(IO_PRIORITY_HIGH, handlers.get(function).slot, write);
+        return;
+    }
+
+    ioWorker->submit(IO_PRIORITY_HIGH, handlers.get(function).slot, write, [this, function](const std::string& error) { writeDone(function, error); });
+}
+
+void CAENHVAsyn::writeDone(int function, const std::string& error)
+{
+    static std::string method("writeDone");
+
+    lock();
+    setIndexedParamStatus(function, error.empty() ? asynSuccess : asynError);
+
+    // After a failed write, the next read publishes the value and its status again,
+    // even if the value has not changed
+    if ( ( ! error.empty() ) && ( static_cast<std::size_t>(function) < publishedValues.size() ) )
+        publishedValues.at(function).valid = false;
+
+    callParamCallbacks(getParamAddr(function), getParamAddr(function));
+    unlock();
+
+    if ( ! error.empty() )
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), error.c_str());
+}
+
+void CAENHVAsyn::queuedWritesFailed(const std::vector<IWriteQueue::writeKey_t>& failed)
+{
+    // The queued writes have already been reported as successful, so the failure is published as the
+    // status of the parameters, until the next read publishes their value again, as after a failed write
+    std::set<int> changed;
+
+    lock();
+    for (std::vector<IWriteQueue::writeKey_t>::const_iterator it = failed.begin(); it != failed.end(); ++it)
+    {
+        std::stringstream paramName;
+        paramName << "S" << std::setfill('0') << std::setw(2) << std::get<0>(*it) << "_" \
+                  << "C" << std::setfill('0') << std::setw(2) << std::get<2>(*it) << "_" \
+                  << processParamName( std::get<1>(*it) );
+
+        std::unordered_map<std::string, int>::const_iterator indexIt = paramIndex.find( paramName.str() );
+        if ( indexIt == paramIndex.end() )
+            continue;
+
+        int index( indexIt->second );
+        setIndexedParamStatus(index, asynError);
+        if ( static_cast<std::size_t>(index) < publishedValues.size() )
+            publishedValues.at(index).valid = false;
+        changed.insert( getParamAddr(index) );
+    }
+    callAddrCallbacks(changed);
+    unlock();
+}
+
+bool CAENHVAsyn::addToPoller(ChannelParameterNumeric p, int index)
+{
+    if ( ( ! polling ) || ( ! p->getMode().compare("WO") ) )
+        return false;
+
+    addToPollList(p, index, pollChannelFloatList);
+    return true;
+}
+
+bool CAENHVAsyn::addToPoller(ChannelParameterOnOff p, int index)
+{
+    if ( ( ! polling ) || ( ! p->getMode().compare("WO") ) )
+        return false;
+
+    addToPollList(p, index, pollChannelUIntList);
+    return true;
+}
+
+bool CAENHVAsyn::addToPoller(ChannelParameterChStatus p, int index)
+{
+    if ( ( ! polling ) || ( ! p->getMode().compare("WO") ) )
+        return false;
+
+    addToPollList(p, index, pollChannelUIntList);
+    return true;
+}
+
+bool CAENHVAsyn::addToPoller(ChannelParameterBinary p, int index)
+{
+    if ( ( ! polling ) || ( ! p->getMode().compare("WO") ) )
+        return false;
+
+    addToPollList(p, index, pollChannelIntList);
+    return true;
+}
+
+bool CAENHVAsyn::addToPoller(BoardParameterNumeric p, int index)
+{
+    if ( ( ! polling ) || ( ! p->getMode().compare("WO") ) )
+        return false;
+
+    addToBoardPollList(p, index, pollBoardFloatList, pollBoardFloatIndex);
+    return true;
+}
+
+bool CAENHVAsyn::addToPoller(BoardParameterOnOff p, int index)
+{
+    if ( ( ! polling ) || ( ! p->getMode().compare("WO") ) )
+        return false;
+
+    addToBoardPollList(p, index, pollBoardUIntList, pollBoardUIntIndex);
+    return true;
+}
+
+bool CAENHVAsyn::addToPoller(BoardParameterChStatus p, int index)
+{
+    if ( ( ! polling ) || ( ! p->getMode().compare("WO") ) )
+        return false;
+
+    addToBoardPollList(p, index, pollBoardUIntList, pollBoardUIntIndex);
+    return true;
+}
+
+bool CAENHVAsyn::addToPoller(BoardParameterBdStatus p, int index)
+{
+    if ( ( ! polling ) || ( ! p->getMode().compare("WO") ) )
+        return false;
+
+    addToBoardPollList(p, index, pollBoardUIntList, pollBoardUIntIndex);
+    return true;
+}
+
+bool CAENHVAsyn::addToPoller(SystemPropertyInteger p, int index)
+{
+    if ( ( ! polling ) || ( ! p->getMode().compare("WO") ) )
+        return false;
+
+    addToSystemPollList(p, index, pollSystemIntList);
+    return true;
+}
+
+bool CAENHVAsyn::addToPoller(SystemPropertyFloat p, int index)
+{
+    if ( ( ! polling ) || ( ! p->getMode().compare("WO") ) )
+        return false;
+
+    addToSystemPollList(p, index, pollSystemFloatList);
+    return true;
+}
+
+bool CAENHVAsyn::addToPoller(SystemPropertyString p, int index)
+{
+    if ( ( ! polling ) || ( ! p->getMode().compare("WO") ) )
+        return false;
+
+    addToSystemPollList(p, index, pollSystemStringList);
+    return true;
+}
+
+template <typename T>
+void CAENHVAsyn::pollList(std::vector< PollEntry<T> >& list, std::size_t scanClass, bool all)
+{
+    for (typename std::vector< PollEntry<T> >::iterator it = list.begin(); it != list.end(); ++it)
+    {
+        if ( it->scanClass != scanClass )
+            continue;
+
+        // Groups of a slot being rebuilt are empty
+        if ( it->indexes.empty() )
+            continue;
+
+        // Groups updated by events are only read when all groups are requested, or when one of their
+        // values is no longer published, for example after a failed write. Otherwise, their history
+        // is recorded from the values last received, as they are not read from the crate.
+        if ( ( ! all ) && it->subscribed && isPublished(it->indexes) )
+        {
+            if ( it->historyIndex >= 0 )
+            {
+                lock();
+                recordHistory(it->historyIndex, getPosixTime(), arrayParamList.at(it->arrayIndex).values);
+                unlock();
+            }
+            continue;
+        }
+
+        pollEntry(*it);
+    }
+}
+
+template <typename T>
+void CAENHVAsyn::readGroup(const std::shared_ptr< IChannelParameterGroup<T> >& g, ioPriority_t p, std::vector<T>& vals, std::vector<bool>& held)
+{
+    // The group is not read while its slot is held
+    if ( ioWorker->reject(p, g->getSlot()) )
+    {
+        held.assign(g->getSize(), true);
+        return;
+    }
+
+    ioWorker->run(p, g->getSlot(), [&]() { vals = g->getVals(); });
+}
+
+template <typename T>
+void CAENHVAsyn::readGroup(const std::shared_ptr< IBoardParameterGroup<T> >& g, ioPriority_t p, std::vector<T>& vals, std::vector<bool>& held)
+{
+    const std::vector<uint16_t>& slots = g->getSlots();
+
+    std::vector<bool> h;
+    for (std::vector<uint16_t>::const_iterator it = slots.begin(); it != slots.end(); ++it)
+        h.push_back( ioWorker->reject(p, *it) );
+
+    // The group reads several slots with a single call, so it is not counted by the slot breakers
+    if ( std::find(h.begin(), h.end(), true) == h.end() )
+    {
+        ioWorker->run(p, IO_NO_SLOT, [&]() { vals = g->getVals(); });
+        return;
+    }
+
+    // The boards of the held slots are left out of the call
+    std::shared_ptr< IBoardParameterGroup<T> > active( IBoardParameterGroup<T>::create(crate->getHandle(), g->getParam()) );
+    for (std::size_t i(0); i < slots.size(); ++i)
+        if ( ! h.at(i) )
+            active->addBoard(slots.at(i));
+
+    std::vector<T> activeVals;
+    if ( active->getSize() )
+        ioWorker->run(p, IO_NO_SLOT, [&]() { activeVals = active->getVals(); });
+
+    vals.assign(slots.size(), T());
+    for (std::size_t i(0), j(0); i < slots.size(); ++i)
+        if ( ! h.at(i) )
+            vals.at(i) = activeVals.at(j++);
+
+    held = h;
+}
+
+// System properties are not bound to a slot, so they are always read
+template <typename P, typename T>
+void CAENHVAsyn::readGroup(const std::shared_ptr< ISystemPropertyGroup<P, T> >& g, ioPriority_t p, std::vector<T>& vals, std::vector<bool>&)
+{
+    ioWorker->run(p, IO_NO_SLOT, [&]() { vals = g->getVals(); });
+}
+
+template <typename T>
+void CAENHVAsyn::pollEntry(PollEntry<T>& entry)
+{
+    static std::string method("pollEntry");
+
+    try
+    {
+        // Read the parameter from all the members of the group at once, on the I/O worker
+        std::vector<typename T::element_type::value_type> vals;
+        std::vector<bool> held;
+        readGroup(entry.group, entry.priority, vals, held);
+        double time( getPosixTime() );
+
+        // Only the values that have changed are published, on the address of each parameter.
+        // The members of the slots held by their breaker are published as failed reads.
+        std::set<int> changed;
+
+        lock();
+        if ( ! held.empty() )
+        {
+            for (std::size_t i(0); i < held.size(); ++i)
+            {
+                int index( entry.indexes.at(i) );
+
+                if ( held.at(i) && publishedValues.at(index).valid )
+                {
+                    setIndexedParamStatus(index, asynError);
+                    publishedValues.at(index).valid = false;
+                    changed.insert( getParamAddr(index) );
+                }
+            }
+
+            // A channel group only has members of one slot
+            if ( vals.empty() )
+            {
+                callAddrCallbacks(changed);
+                unlock();
+                return;
+            }
+        }
+
+        for (std::size_t i(0); i < vals.size(); ++i)
+        {
+            int index( entry.indexes.at(i) );
+
+            if ( ( ! held.empty() ) && held.at(i) )
+                continue;
+
+            if ( postMortem )
+                checkTrip(index, vals.at(i), time);
+
+            if ( updateParamValue(index, vals.at(i)) )
+            {
+                setIndexedParamStatus(index, asynSuccess);
+                changed.insert( getParamAddr(index) );
+            }
+        }
+        if ( ! changed.empty() )
+        {
+            callAddrCallbacks(changed);
+
+            // The array parameter contains the values of all the members of the group
+            if ( entry.arrayIndex >= 0 )
+                updateArrayValues(entry.arrayIndex, vals);
+        }
+
+        // The history records all the samples, whether they have changed or not
+        if ( entry.historyIndex >= 0 )
+            recordHistory(entry.historyIndex, time, vals);
+        unlock();
+    }
+    catch(std::runtime_error& e)
+    {
+        // When the crate is disconnected, all its parameters are already marked as disconnected
+        if ( ! crate->isConnected() )
+            return;
+
+        // The values are published again after the next successful read
+        std::set<int> changed;
+
+        lock();
+        for (std::vector<int>::iterator indexIt = entry.indexes.begin(); indexIt != entry.indexes.end(); ++indexIt)
+        {
+            setIndexedParamStatus(*indexIt, asynError);
+            publishedValues.at(*indexIt).valid = false;
+            changed.insert( getParamAddr(*indexIt) );
+        }
+        callAddrCallbacks(changed);
+        unlock();
+
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Group '%s' : exception caught '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), entry.group->getDesc().c_str(), e.what());
+    }
+}
+
+template <typename T>
+void CAENHVAsyn::countScanClass(const std::vector< PollEntry<T> >& list, std::vector<std::size_t>& count) const
+{
+    for (typename std::vector< PollEntry<T> >::const_iterator it = list.begin(); it != list.end(); ++it)
+        ++count.at(it->scanClass);
+}
+
+void CAENHVAsyn::pollScanClass(std::size_t scanClass, bool all)
+{
+    // The poller lists are not changed by the hot-plug thread during the sweep
+    pollMutex.lock();
+    pollList(pollChannelFloatList, scanClass, all);
+    pollList(pollChannelUIntList,  scanClass, all);
+    pollList(pollChannelIntList,   scanClass, all);
+    pollList(pollBoardFloatList,   scanClass, all);
+    pollList(pollBoardUIntList,    scanClass, all);
+    pollList(pollSystemIntList,    scanClass, all);
+    pollList(pollSystemFloatList,  scanClass, all);
+    pollList(pollSystemStringList, scanClass, all);
+    pollMutex.unlock();
+}
+
+void CAENHVAsyn::pollerTask()
+{
+    std::size_t n( scanSchedule.size() );
+
+    // Time at which each scan class is due. Scan classes without parameters are never read.
+    std::vector<epicsTime>   next( n, epicsTime::getCurrent() );
+    std::vector<bool>        done( n, false );
+    std::vector<std::size_t> count( n, 0 );
+
+    countScanClass(pollChannelFloatList, count);
+    countScanClass(pollChannelUIntList,  count);
+    countScanClass(pollChannelIntList,   count);
+    countScanClass(pollBoardFloatList,   count);
+    countScanClass(pollBoardUIntList,    count);
+    countScanClass(pollSystemIntList,    count);
+    countScanClass(pollSystemFloatList,  count);
+    countScanClass(pollSystemStringList, count);
+
+    for (std::size_t i(0); i < n; ++i)
+        done.at(i) = ( count.at(i) == 0 );
+
+    // The first read of each scan class includes all the groups, including the ones
+    // updated by events, in order to get their initial values.
+    std::vector<bool> first( n, true );
+    bool              firstCycleDone(false);
+
+    for(;;)
+    {
+        // Nothing is read while the crate is disconnected
+        if ( ! crate->isConnected() )
+        {
+            epicsThreadSleep(pollPeriod_);
+            continue;
+        }
+
+        // After a reconnection, all the scan classes are read again, including the groups
+        // updated by events, and the scan classes which are read only once
+        if ( restorePending.exchange(false) )
+        {
+            if ( ! eventTargets.empty() )
+                resubscribeParams();
+
+            epicsTime now = epicsTime::getCurrent();
+            for (std::size_t i(0); i < n; ++i)
+            {
+                done.at(i)  = ( count.at(i) == 0 );
+                first.at(i) = true;
+                next.at(i)  = now;
+            }
+        }
+
+        // Number of scan classes due at the start of the cycle, and how late the oldest one is
+        {
+            std::size_t pendingClasses(0);
+            double      oldest(0);
+            epicsTime   now = epicsTime::getCurrent();
+            for (std::size_t i(0); i < n; ++i)
+            {
+                if ( done.at(i) || ( now < next.at(i) ) )
+                    continue;
+
+                ++pendingClasses;
+                oldest = std::max(oldest, now - next.at(i));
+            }
+            updatePendingDiagParams(pendingClasses, oldest);
+        }
+
+        for (std::size_t i(0); i < n; ++i)
+        {
+            if ( done.at(i) || ( epicsTime::getCurrent() < next.at(i) ) )
+                continue;
+
+            epicsTime start = epicsTime::getCurrent();
+            pollScanClass(i, first.at(i));
+            first.at(i) = false;
+            updateSweepDiagParams(i, epicsTime::getCurrent() - start);
+
+            // Scan classes with a period of zero are read only once
+            double period( scanSchedule.at(i).period );
+            if ( period <= 0 )
+            {
+                done.at(i) = true;
+                continue;
+            }
+
+            // If the reads took longer than the period, skip the missed cycles
+            next.at(i) = next.at(i) + period;
+            epicsTime now = epicsTime::getCurrent();
+            if ( next.at(i) < now )
+                next.at(i) = now + period;
+        }
+
+        // All the scan classes have been read at least once after the first cycle
+        if ( ! firstCycleDone )
+        {
+            firstPollDone.signal();
+            firstCycleDone = true;
+        }
+
+        // Sleep until the next scan class is due
+        bool      pending(false);
+        epicsTime wake;
+        for (std::size_t i(0); i < n; ++i)
+        {
+            if ( ( ! done.at(i) ) && ( ( ! pending ) || ( next.at(i) < wake ) ) )
+            {
+                wake    = next.at(i);
+                pending = true;
+            }
+        }
+
+        // All the scan classes were read only once. The poller keeps running, in order
+        // to read them again after a reconnection.
+        if ( ! pending )
+        {
+            epicsThreadSleep(pollPeriod_);
+            continue;
+        }
+
+        double wait = wake - epicsTime::getCurrent();
+        if ( wait > 0 )
+            epicsThreadSleep(wait);
+    }
+}
+
+template <typename T>
+void CAENHVAsyn::addSubscriptionRequests(std::vector< PollEntry<T> >& list, subscriptionRequests_t& requests)
+{
+    for (typename std::vector< PollEntry<T> >::iterator it = list.begin(); it != list.end(); ++it)
+    {
+        const std::vector<uint16_t>& channels = it->group->getChannels();
+        for (std::size_t i(0); i < channels.size(); ++i)
+        {
+            EventTarget t;
+            t.index      = it->indexes.at(i);
+            t.type       = eventValueType( typename T::element_type::value_type() );
+            t.arrayIndex = it->arrayIndex;
+            t.arrayPos   = i;
+            requests[ std::make_pair( static_cast<int>(it->group->getSlot()), static_cast<int>(channels.at(i)) ) ].push_back( std::make_pair( it->group->getParam(), t ) );
+        }
+    }
+}
+
+template <typename T>
+void CAENHVAsyn::addBoardSubscriptionRequests(std::vector< PollEntry<T> >& list, subscriptionRequests_t& requests)
+{
+    for (typename std::vector< PollEntry<T> >::iterator it = list.begin(); it != list.end(); ++it)
+    {
+        const std::vector<uint16_t>& slots = it->group->getSlots();
+        for (std::size_t i(0); i < slots.size(); ++i)
+        {
+            EventTarget t;
+            t.index      = it->indexes.at(i);
+            t.type       = eventValueType( typename T::element_type::value_type() );
+            t.arrayIndex = -1;
+            t.arrayPos   = 0;
+            requests[ std::make_pair( static_cast<int>(slots.at(i)), -1 ) ].push_back( std::make_pair( it->group->getParam(), t ) );
+        }
+    }
+}
+
+template <typename T>
+std::size_t CAENHVAsyn::markSubscribed(std::vector< PollEntry<T> >& list)
+{
+    std::size_t n(0);
+
+    for (typename std::vector< PollEntry<T> >::iterator it = list.begin(); it != list.end(); ++it)
+    {
+        // A group stops being polled only if the subscription was accepted for all its channels
+        const std::vector<uint16_t>& channels = it->group->getChannels();
+        it->subscribed = true;
+        for (std::vector<uint16_t>::const_iterator chIt = channels.begin(); chIt != channels.end(); ++chIt)
+            if ( eventTargets.find( eventKey_t( it->group->getSlot(), *chIt, it->group->getParam() ) ) == eventTargets.end() )
+                it->subscribed = false;
+
+        if ( it->subscribed )
+            ++n;
+    }
+
+    return n;
+}
+
+template <typename T>
+std::size_t CAENHVAsyn::markBoardSubscribed(std::vector< PollEntry<T> >& list)
+{
+    std::size_t n(0);
+
+    for (typename std::vector< PollEntry<T> >::iterator it = list.begin(); it != list.end(); ++it)
+    {
+        // A group stops being polled only if the subscription was accepted for all its boards
+        const std::vector<uint16_t>& slots = it->group->getSlots();
+        it->subscribed = true;
+        for (std::vector<uint16_t>::const_iterator slotIt = slots.begin(); slotIt != slots.end(); ++slotIt)
+            if ( eventTargets.find( eventKey_t( *slotIt, -1, it->group->getParam() ) ) == eventTargets.end() )
+                it->subscribed = false;
+
+        if ( it->subscribed )
+            ++n;
+    }
+
+    return n;
+}
+
+void CAENHVAsyn::subscribeParams()
+{
+    subscription = ISubscription::create(crate->getHandle(), eventPort);
+
+    // Collect the parameters to subscribe to, by slot and channel
+    subscriptionRequests_t requests;
+    addSubscriptionRequests(pollChannelFloatList, requests);
+    addSubscriptionRequests(pollChannelUIntList,  requests);
+    addSubscriptionRequests(pollChannelIntList,   requests);
+    addBoardSubscriptionRequests(pollBoardFloatList, requests);
+    addBoardSubscriptionRequests(pollBoardUIntList,  requests);
+
+    // Subscribe to all the parameters of each channel, or board, with a single call
+    std::size_t failed(0);
+    for (subscriptionRequests_t::iterator it = requests.begin(); it != requests.end(); ++it)
+    {
+        int slot    = it->first.first;
+        int channel = it->first.second;
+
+        std::vector<std::string> params;
+        for (std::vector< std::pair<std::string, EventTarget> >::iterator pIt = it->second.begin(); pIt != it->second.end(); ++pIt)
+            params.push_back(pIt->first);
+
+        std::vector<bool> accepted;
+        if ( channel < 0 )
+            accepted = subscription->subscribeBoardParams(slot, params);
+        else
+            accepted = subscription->subscribeChannelParams(slot, channel, params);
+
+        for (std::size_t i(0); i < params.size(); ++i)
+        {
+            if ( accepted.at(i) )
+                eventTargets.insert( std::make_pair( eventKey_t(slot, channel, params.at(i)), it->second.at(i).second ) );
+            else
+                ++failed;
+        }
+    }
+
+    // Groups whose members are all subscribed are no longer polled
+    std::size_t n(0);
+    n += markSubscribed(pollChannelFloatList);
+    n += markSubscribed(pollChannelUIntList);
+    n += markSubscribed(pollChannelIntList);
+    n += markBoardSubscribed(pollBoardFloatList);
+    n += markBoardSubscribed(pollBoardUIntList);
+
+    std::cout << "Event mode: subscribed to " << eventTargets.size() << " parameters on port " << eventPort \
+              << " (" << failed << " rejected). " << n << " parameter groups are updated by events only." << std::endl;
+}
+
+void CAENHVAsyn::resubscribeParams()
+{
+    static std::string method("resubscribeParams");
+
+    // The subscriptions are lost when the connection to the crate is opened again. The
+    // parameters accepted on the first subscription are requested again, by slot and channel.
+    std::map< std::pair<int, int>, std::vector<std::string> > requests;
+    lock();
+    for (std::map< eventKey_t, EventTarget >::const_iterator it = eventTargets.begin(); it != eventTargets.end(); ++it)
+        requests[ std::make_pair( std::get<0>(it->first), std::get<1>(it->first) ) ].push_back( std::get<2>(it->first) );
+    unlock();
+
+    std::size_t failed(0);
+    for (std::map< std::pair<int, int>, std::vector<std::string> >::const_iterator it = requests.begin(); it != requests.end(); ++it)
+    {
+        std::vector<bool> accepted;
+
+        try
+        {
+            ioWorker->run(IO_PRIORITY_LOW, it->first.first, [&]() {
+                if ( it->first.second < 0 )
+                    accepted = subscription->subscribeBoardParams(it->first.first, it->second);
+                else
+                    accepted = subscription->subscribeChannelParams(it->first.first, it->first.second, it->second);
+            });
+        }
+        catch(std::runtime_error& e)
+        {
+            accepted.assign(it->second.size(), false);
+        }
+
+        failed += std::count(accepted.begin(), accepted.end(), false);
+    }
+
+    if ( failed )
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s' : %zu parameters were rejected when subscribing again after a reconnection\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), failed);
+}
+
+void CAENHVAsyn::linkStateChanged(linkState_t s)
+{
+    static std::string method("linkStateChanged");
+
+    bool up( s == LINK_CONNECTED );
+
+    lock();
+
+    // The reconnection attempts do not change the published state
+    if ( up == linkUp )
+    {
+        unlock();
+        return;
+    }
+    linkUp = up;
+
+    for (std::size_t i(0); i < handlers.size(); ++i)
+    {
+        // The parameters of a removed or replaced board, or of a disabled slot, keep their status
+        const ParamHandler& h( handlers.get(i) );
+        if ( ( h.kind == HANDLER_NONE ) || ( h.kind == HANDLER_DETACHED ) || ( h.kind == HANDLER_SLOT_DISABLE ) )
+            continue;
+
+        int index( static_cast<int>(i) );
+        if ( ! up )
+        {
+            // The records are set in COMM/INVALID alarm, and the values are published again once read
+            setIndexedParamStatus(index, asynDisconnected);
+            if ( i < publishedValues.size() )
+                publishedValues.at(i).valid = false;
+        }
+        else if ( ! h.polled )
+        {
+            // The parameters updated by the poller are cleared when they are read again
+            setIndexedParamStatus(index, asynSuccess);
+        }
+    }
+    callAllParamCallbacks();
+
+    if ( up )
+        restorePending = true;
+
+    unlock();
+
+    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                "Driver '%s', Port '%s', Method '%s' : the crate is %s\n", \
+                this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), up ? "connected again" : "disconnected");
+}
+
+template <typename T>
+bool CAENHVAsyn::rebindParam(T p, std::map<int, T>& list)
+{
+    // Only the parameters with an asyn parameter of the same type on the previous board can be rebound
+    std::unordered_map<std::string, int>::const_iterator it = paramIndex.find( p->getEpicsParamName() );
+    if ( it == paramIndex.end() )
+        return false;
+
+    int index( it->second );
+    typename std::map<int, T>::iterator listIt = list.find(index);
+    if ( listIt == list.end() )
+        return false;
+
+    listIt->second = p;
+
+    // The parameters updated by the poller are cleared when they are read
+    bool polled( addToPoller(p, index) );
+    handlers.set( index, makeHandler(p, polled) );
+    if ( ! polled )
+        setIndexedParamStatus(index, asynSuccess);
+
+    return true;
+}
+
+template <typename T>
+void CAENHVAsyn::rebindParams(const std::vector<T>& params, std::map<int, T>& list, std::size_t& rebound, std::size_t& missing)
+{
+    for (typename std::vector<T>::const_iterator it = params.begin(); it != params.end(); ++it)
+    {
+        if ( rebindParam(*it, list) )
+            ++rebound;
+        else
+            ++missing;
+    }
+}
+
+template <typename T>
+void CAENHVAsyn::clearSlotEntries(std::vector< PollEntry<T> >& list, std::size_t slot)
+{
+    for (typename std::vector< PollEntry<T> >::iterator it = list.begin(); it != list.end(); ++it)
+    {
+        if ( it->group->getSlot() != slot )
+            continue;
+
+        // The channels are added again when the parameters are rebound
+        it->group      = T::element_type::create(crate->getHandle(), slot, it->group->getParam());
+        it->indexes.clear();
+        it->subscribed = false;
+    }
+}
+
+template <typename T>
+void CAENHVAsyn::clearBoardSlotEntries(std::vector< PollEntry<T> >& list, std::size_t slot)
+{
+    for (typename std::vector< PollEntry<T> >::iterator it = list.begin(); it != list.end(); ++it)
+    {
+        const std::vector<uint16_t>& slots = it->group->getSlots();
+        if ( std::find(slots.begin(), slots.end(), slot) == slots.end() )
+            continue;
+
+        // The group is created again with the other boards. The board is added
+        // back at the end of the group when its parameter is rebound.
+        T                group( T::element_type::create(crate->getHandle(), it->group->getParam()) );
+        std::vector<int> indexes;
+        for (std::size_t i(0); i < slots.size(); ++i)
+        {
+            if ( slots.at(i) == slot )
+                continue;
+
+            group->addBoard(slots.at(i));
+            indexes.push_back(it->indexes.at(i));
+        }
+
+        it->group      = group;
+        it->indexes    = indexes;
+        it->subscribed = false;
+    }
+}
+
+template <typename T>
+void CAENHVAsyn::attachArrays(std::vector< PollEntry<T> >& list, std::size_t slot)
+{
+    for (typename std::vector< PollEntry<T> >::iterator it = list.begin(); it != list.end(); ++it)
+    {
+        if ( ( it->arrayIndex < 0 ) || ( it->group->getSlot() != slot ) || it->indexes.empty() )
+            continue;
+
+        // The array contains the channels of the new board which have the parameter
+        ArrayParam& a = arrayParamList.at(it->arrayIndex);
+        a.values.assign(it->group->getSize(), 0);
+
+        ParamHandler h( handlers.get(it->arrayIndex) );
+        h.kind = a.isFloat ? HANDLER_FLOAT64_ARRAY : HANDLER_INT32_ARRAY;
+        handlers.set(it->arrayIndex, h);
+        setIndexedParamStatus(it->arrayIndex, asynSuccess);
+
+        // The history of the previous board is discarded. It keeps its width, so the
+        // channels of the new board beyond it are not recorded.
+        if ( it->historyIndex < 0 )
+            continue;
+
+        HistoryParam& hp = historyParamList.at(it->historyIndex);
+        hp.buffer->clear();
+
+        int indexes[2] = { it->historyIndex, hp.timesIndex };
+        for (int i(0); i < 2; ++i)
+        {
+            ParamHandler hh( handlers.get(indexes[i]) );
+            hh.kind = i ? HANDLER_HISTORY_TIMES : HANDLER_HISTORY_VALUES;
+            handlers.set(indexes[i], hh);
+            setIndexedParamStatus(indexes[i], asynSuccess);
+        }
+    }
+}
+
+// Whether a parameter group reads a slot
+template <typename T>
+static bool groupHasSlot(const std::shared_ptr< IChannelParameterGroup<T> >& g, std::size_t slot)
+{
+    return ( g->getSlot() == slot );
+}
+
+template <typename T>
+static bool groupHasSlot(const std::shared_ptr< IBoardParameterGroup<T> >& g, std::size_t slot)
+{
+    const std::vector<uint16_t>& slots = g->getSlots();
+    return ( std::find(slots.begin(), slots.end(), slot) != slots.end() );
+}
+
+template <typename T>
+void CAENHVAsyn::pollSlotList(std::vector< PollEntry<T> >& list, std::size_t slot)
+{
+    for (typename std::vector< PollEntry<T> >::iterator it = list.begin(); it != list.end(); ++it)
+        if ( ( ! it->indexes.empty() ) && groupHasSlot(it->group, slot) )
+            pollEntry(*it);
+}
+
+void CAENHVAsyn::pollSlot(std::size_t slot)
+{
+    // The groups of the slot are read once, including the ones updated by events,
+    // in order to publish the initial values of the new board
+    pollMutex.lock();
+    pollSlotList(pollChannelFloatList, slot);
+    pollSlotList(pollChannelUIntList,  slot);
+    pollSlotList(pollChannelIntList,   slot);
+    pollSlotList(pollBoardFloatList,   slot);
+    pollSlotList(pollBoardUIntList,    slot);
+    pollMutex.unlock();
+}
+
+void CAENHVAsyn::detachSlot(std::size_t slot, asynStatus status)
+{
+    static std::string method("detachSlot");
+
+    lock();
+
+    // The records are set in COMM/INVALID, or DISABLE/INVALID, alarm, and the values are published again once read
+    for (std::size_t i(0); i < handlers.size(); ++i)
+    {
+        ParamHandler h( handlers.get(i) );
+        if ( ( h.kind == HANDLER_NONE ) || ( h.kind == HANDLER_SLOT_DISABLE ) || ( h.slot != static_cast<int>(slot) ) )
+            continue;
+
+        int index( static_cast<int>(i) );
+        h.kind = HANDLER_DETACHED;
+        handlers.set(index, h);
+        setIndexedParamStatus(index, status);
+        if ( i < publishedValues.size() )
+            publishedValues.at(i).valid = false;
+    }
+    callParamCallbacks(static_cast<int>(slot) + 1, static_cast<int>(slot) + 1);
+
+    // The events of the slot are ignored until it is subscribed again
+    for (std::map< eventKey_t, EventTarget >::iterator it = eventTargets.begin(); it != eventTargets.end(); )
+    {
+        if ( std::get<0>(it->first) == static_cast<int>(slot) )
+            eventTargets.erase(it++);
+        else
+            ++it;
+    }
+
+    // The groups of the slot are emptied, so they are not read by the poller
+    clearSlotEntries(pollChannelFloatList, slot);
+    clearSlotEntries(pollChannelUIntList,  slot);
+    clearSlotEntries(pollChannelIntList,   slot);
+    clearBoardSlotEntries(pollBoardFloatList, slot);
+    clearBoardSlotEntries(pollBoardUIntList,  slot);
+
+    unlock();
+
+    // The setpoints still queued for the previous board must not be sent to the new one
+    std::size_t dropped(0);
+    if ( writeQueue )
+        dropped = writeQueue->drop(slot);
+
+    if ( dropped )
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s' : %zu pending writes to slot %zu were dropped\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), dropped, slot);
+}
+
+void CAENHVAsyn::attachBoard(Board b, std::size_t& rebound, std::size_t& missing)
+{
+    std::size_t slot( b->getSlot() );
+
+    lock();
+
+    rebindParams(b->getBoardParameterNumerics(),   boardParameterNumericList,  rebound, missing);
+    rebindParams(b->getBoardParameterOnOffs(),     boardParameterOnOffList,    rebound, missing);
+    rebindParams(b->getBoardParameterChStatuses(), boardParameterChStatusList, rebound, missing);
+    rebindParams(b->getBoardParameterBdStatuses(), boardParameterBdStatusList, rebound, missing);
+
+    std::vector<Channel> c = b->getChannels();
+    for (std::vector<Channel>::iterator channelIt = c.begin(); channelIt != c.end(); ++channelIt)
+    {
+        rebindParams((*channelIt)->getChannelParameterNumerics(),   channelParameterNumericList,  rebound, missing);
+        rebindParams((*channelIt)->getChannelParameterOnOffs(),     channelParameterOnOffList,    rebound, missing);
+        rebindParams((*channelIt)->getChannelParameterChStatuses(), channelParameterChStatusList, rebound, missing);
+        rebindParams((*channelIt)->getChannelParameterBinaries(),   channelParameterBinaryList,   rebound, missing);
+    }
+
+    attachArrays(pollChannelFloatList, slot);
+    attachArrays(pollChannelUIntList,  slot);
+    attachArrays(pollChannelIntList,   slot);
+
+    callParamCallbacks(static_cast<int>(slot) + 1, static_cast<int>(slot) + 1);
+
+    unlock();
+}
+
+std::size_t CAENHVAsyn::subscribeSlot(std::size_t slot)
+{
+    // Collect the parameters of the slot to subscribe to, by channel
+    subscriptionRequests_t requests;
+
+    pollMutex.lock();
+    addSubscriptionRequests(pollChannelFloatList, requests);
+    addSubscriptionRequests(pollChannelUIntList,  requests);
+    addSubscriptionRequests(pollChannelIntList,   requests);
+    addBoardSubscriptionRequests(pollBoardFloatList, requests);
+    addBoardSubscriptionRequests(pollBoardUIntList,  requests);
+    pollMutex.unlock();
+
+    std::size_t failed(0);
+    std::vector< std::pair<eventKey_t, EventTarget> > targets;
+    for (subscriptionRequests_t::iterator it = requests.begin(); it != requests.end(); ++it)
+    {
+        int s       = it->first.first;
+        int channel = it->first.second;
+
+        if ( s != static_cast<int>(slot) )
+            continue;
+
+        std::vector<std::string> params;
+        for (std::vector< std::pair<std::string, EventTarget> >::iterator pIt = it->second.begin(); pIt != it->second.end(); ++pIt)
+            params.push_back(pIt->first);
+
+        std::vector<bool> accepted;
+        try
+        {
+            ioWorker->run(IO_PRIORITY_LOW, s, [&]() {
+                if ( channel < 0 )
+                    accepted = subscription->subscribeBoardParams(s, params);
+                else
+                    accepted = subscription->subscribeChannelParams(s, channel, params);
+            });
+        }
+        catch(std::runtime_error& e)
+        {
+            accepted.assign(params.size(), false);
+        }
+
+        for (std::size_t i(0); i < params.size(); ++i)
+        {
+            if ( accepted.at(i) )
+                targets.push_back( std::make_pair( eventKey_t(s, channel, params.at(i)), it->second.at(i).second ) );
+            else
+                ++failed;
+        }
+    }
+
+    // Groups whose members are all subscribed are no longer polled
+    pollMutex.lock();
+    lock();
+    for (std::vector< std::pair<eventKey_t, EventTarget> >::const_iterator it = targets.begin(); it != targets.end(); ++it)
+        eventTargets[it->first] = it->second;
+    markSubscribed(pollChannelFloatList);
+    markSubscribed(pollChannelUIntList);
+    markSubscribed(pollChannelIntList);
+    markBoardSubscribed(pollBoardFloatList);
+    markBoardSubscribed(pollBoardUIntList);
+    unlock();
+    pollMutex.unlock();
+
+    return failed;
+}
+
+void CAENHVAsyn::rebuildSlot(std::size_t slot)
+{
+    static std::string method("rebuildSlot");
+
+    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                "Driver '%s', Port '%s', Method '%s' : the board in slot %zu has changed. It will be discovered again\n", \
+                this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), slot);
+
+    // The slot is not enabled or disabled while it is rebuilt
+    slotMutex.lock();
+    bool enabled( slotEnabled.at(slot) );
+
+    // The objects of the previous board are kept alive
+    Board old( crate->getBoard(slot) );
+    if ( old && ( std::find(retiredBoards.begin(), retiredBoards.end(), old) == retiredBoards.end() ) )
+        retiredBoards.push_back(old);
+
+    pollMutex.lock();
+    detachSlot(slot, enabled ? asynDisconnected : asynDisabled);
+    pollMutex.unlock();
+
+    // The board is discovered on this thread, and not as a single job of the I/O worker, which would block
+    // the writes and reads of the other slots until the whole board is discovered. Each call to the crate
+    // only holds the mutex of the library handle, so the I/O worker makes its calls in between. If the
+    // discovery fails, the parameters of the slot stay detached, and the slot is discovered again on the
+    // next check.
+    Board b;
+    try
+    {
+        b = crate->rediscoverSlot(slot);
+    }
+    catch(std::runtime_error& e)
+    {
+        slotMutex.unlock();
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s' : failed to discover the board in slot %zu. It will be tried again on the next check: '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), slot, e.what());
+        return;
+    }
+
+    // The new board of a disabled slot is attached when the slot is enabled
+    if ( enabled )
+        attachSlot(slot, b);
+    slotMutex.unlock();
+}
+
+void CAENHVAsyn::attachSlot(std::size_t slot, Board b)
+{
+    static std::string method("attachSlot");
+
+    std::size_t rebound(0);
+    std::size_t missing(0);
+    std::size_t detached(0);
+
+    pollMutex.lock();
+    if ( b )
+        attachBoard(b, rebound, missing);
+
+    // The parameters not found on the board stay detached, and disconnected, even if the slot was disabled
+    lock();
+    for (std::size_t i(0); i < handlers.size(); ++i)
+    {
+        const ParamHandler& h( handlers.get(i) );
+        if ( ( h.kind == HANDLER_DETACHED ) && ( h.slot == static_cast<int>(slot) ) )
+        {
+            setIndexedParamStatus(static_cast<int>(i), asynDisconnected);
+            ++detached;
+        }
+    }
+    callParamCallbacks(static_cast<int>(slot) + 1, static_cast<int>(slot) + 1);
+    unlock();
+    pollMutex.unlock();
+
+    std::size_t rejected(0);
+    if ( b && subscription )
+        rejected = subscribeSlot(slot);
+
+    if ( b )
+        pollSlot(slot);
+
+    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                "Driver '%s', Port '%s', Method '%s' : slot %zu attached. %zu parameters rebound, %zu disconnected, " \
+                "%zu new parameters not available until the IOC is restarted, %zu event subscriptions rejected\n", \
+                this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), slot, rebound, detached, missing, rejected);
+}
+
+void CAENHVAsyn::createSlotParams()
+{
+    slotEnabled.assign(crate->getNumSlots(), true);
+
+    std::vector<Board> b = crate->getBoards();
+    for (std::vector<Board>::iterator boardIt = b.begin(); boardIt != b.end(); ++boardIt)
+    {
+        std::size_t slot( (*boardIt)->getSlot() );
+
+        std::stringstream temp;
+        temp << "S" << std::setfill('0') << std::setw(2) << slot;
+        std::string paramName( temp.str() + "_DISABLE" );
+
+        int index( createIndexedParam(paramName, asynParamUInt32Digital, 0) );
+        setParamValue(index, static_cast<uint32_t>(0));
+
+        ParamHandler h;
+        h.kind    = HANDLER_SLOT_DISABLE;
+        h.slot    = static_cast<int>(slot);
+        h.channel = -1;
+        h.polled  = false;
+        h.object  = NULL;
+        handlers.set(index, h);
+
+        if (records)
+        {
+            std::stringstream dbParamsLocal;
+            dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
+            dbParamsLocal << ",PORT="  << portName_;
+            dbParamsLocal << ",ADDR="  << getParamAddr(index);
+            dbParamsLocal << ",PARAM=" << paramName;
+            dbParamsLocal << ",DESC="  << "'Slot " << slot << ", disable'";
+            dbParamsLocal << ",ZNAM="  << "Enabled";
+            dbParamsLocal << ",ONAM="  << "Disabled";
+            dbParamsLocal << ",MASK=1";
+            records->add("db/bo.template", ( dbParamsLocal.str() + ",R=" + temp.str() + ":DISABLE:St" ).c_str());
+            records->add("db/bi.template", ( dbParamsLocal.str() + ",SCAN=I/O Intr,R=" + temp.str() + ":DISABLE:Rd" ).c_str());
+        }
+    }
+}
+
+void CAENHVAsyn::setSlotEnabled(std::size_t slot, bool enabled)
+{
+    static std::string method("setSlotEnabled");
+
+    slotMutex.lock();
+
+    if ( enabled == slotEnabled.at(slot) )
+    {
+        slotMutex.unlock();
+        return;
+    }
+    slotEnabled.at(slot) = enabled;
+
+    asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                "Driver '%s', Port '%s', Method '%s' : slot %zu %s\n", \
+                this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), slot, enabled ? "enabled" : "disabled");
+
+    // The current board of the slot is attached again, as after it was rebuilt
+    if ( enabled )
+    {
+        attachSlot(slot, crate->getBoard(slot));
+    }
+    else
+    {
+        pollMutex.lock();
+        detachSlot(slot, asynDisabled);
+        pollMutex.unlock();
+    }
+
+    slotMutex.unlock();
+}
+
+void CAENHVAsyn::hotPlugTask()
+{
+    static std::string method("hotPlugTask");
+
+    for(;;)
+    {
+        epicsThreadSleep(hotPlugPeriod_);
+
+        // The crate map is not checked while the crate is disconnected
+        if ( ! crate->isConnected() )
+            continue;
+
+        std::vector<std::size_t> slots;
+        try
+        {
+            ioWorker->run(IO_PRIORITY_LOW, IO_NO_SLOT, [&]() { slots = crate->checkCrateMap(); });
+        }
+        catch(std::runtime_error& e)
+        {
+            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s', Method '%s' : exception caught '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), e.what());
+            continue;
+        }
+
+        for (std::vector<std::size_t>::const_iterator it = slots.begin(); it != slots.end(); ++it)
+            rebuildSlot(*it);
+    }
+}
+
+void CAENHVAsyn::createPostMortemParams()
+{
+    postMortemParams.count   = createDriverParam("PM_COUNT",   "'Post-mortem captures'",     "",  0);
+    postMortemParams.trips   = createDriverParam("PM_TRIPS",   "'Channel trips'",            "",  0);
+    postMortemParams.slot    = createDriverParam("PM_SLOT",    "'Last capture, slot'",       "",  0);
+    postMortemParams.channel = createDriverParam("PM_CHANNEL", "'Last capture, channel'",    "",  0);
+    postMortemParams.status  = createDriverParam("PM_STATUS",  "'Last capture, trip bits'",  "",  0);
+    postMortemParams.time    = createDriverParam("PM_TIME",    "'Last capture, trip time'",  "s", 3);
+
+    // Each parameter with a history has a trace of the tripped channel, as long as its longest history
+    std::map<std::string, std::size_t> samples;
+    for (std::vector< PollEntry<ChannelParameterGroupFloat> >::const_iterator it = pollChannelFloatList.begin(); it != pollChannelFloatList.end(); ++it)
+    {
+        if ( it->historyIndex < 0 )
+            continue;
+
+        std::size_t& n( samples[ it->group->getParam() ] );
+        n = std::max( n, historyParamList.at(it->historyIndex).buffer->getCapacity() );
+    }
+
+    for (std::map<std::string, std::size_t>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+    {
+        std::string param( processParamName(it->first) );
+
+        int indexes[2];
+        for (int i(0); i < 2; ++i)
+        {
+            std::string suffix( i ? "_T" : "" );
+            std::string paramName( "PM_" + param + suffix );
+
+            indexes[i] = createIndexedParam(paramName, asynParamFloat64Array, 0);
+
+            // The trace is replaced on each capture, without reallocating it
+            ArrayParam a;
+            a.isFloat = true;
+            std::map<int, ArrayParam>::iterator aIt = arrayParamList.insert( std::make_pair(indexes[i], a) ).first;
+            aIt->second.values.reserve(it->second);
+
+            ParamHandler h;
+            h.kind    = HANDLER_FLOAT64_ARRAY;
+            h.slot    = -1;
+            h.channel = -1;
+            h.polled  = true;
+            h.object  = &aIt->second;
+            handlers.set(indexes[i], h);
+
+            if (records)
+            {
+                std::stringstream dbParamsLocal;
+                dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
+                dbParamsLocal << ",PORT="  << portName_;
+                dbParamsLocal << ",ADDR="  << getParamAddr(indexes[i]);
+                dbParamsLocal << ",PARAM=" << paramName;
+                dbParamsLocal << ",DESC="  << "'Last capture, " << it->first << ( i ? " times'" : "'" );
+                dbParamsLocal << ",DTYP="  << "asynFloat64ArrayIn";
+                dbParamsLocal << ",FTVL="  << "DOUBLE";
+                dbParamsLocal << ",NELM="  << it->second;
+                dbParamsLocal << ",SCAN="  << "I/O Intr";
+                dbParamsLocal << ",R="     << "PM:" << param << suffix << ":Rd";
+                records->add("db/waveform.template", dbParamsLocal.str().c_str());
+            }
+        }
+
+        postMortemParams.traces[it->first] = std::make_pair(indexes[0], indexes[1]);
+    }
+}
+
+void CAENHVAsyn::freezeCapture(Capture& c)
+{
+    bool crateWide( postMortem->getConfig().crateWide );
+
+    std::set<std::size_t> slots;
+    for (std::vector<TripEvent>::const_iterator it = c.trips.begin(); it != c.trips.end(); ++it)
+        slots.insert(it->slot);
+
+    // The history is copied with the port lock held, as it is recorded by the poller,
+    // and the poller lists are not changed by the hot-plug thread during the copy
+    pollMutex.lock();
+    lock();
+    for (std::vector< PollEntry<ChannelParameterGroupFloat> >::const_iterator it = pollChannelFloatList.begin(); it != pollChannelFloatList.end(); ++it)
+    {
+        if ( it->historyIndex < 0 )
+            continue;
+
+        std::size_t slot( it->group->getSlot() );
+        if ( ( ! crateWide ) && ( slots.find(slot) == slots.end() ) )
+            continue;
+
+        const HistoryBuffer& h( historyParamList.at(it->historyIndex).buffer );
+
+        c.sections.push_back( CaptureSection() );
+        CaptureSection& s( c.sections.back() );
+        s.slot     = slot;
+        s.param    = it->group->getParam();
+        s.channels = it->group->getChannels();
+
+        // After a board was replaced, the columns of the history beyond its channels have no channel
+        s.channels.resize(h->getWidth(), 0xFFFF);
+
+        h->copyWindow(c.start, c.end, s.times, s.values);
+    }
+    unlock();
+    pollMutex.unlock();
+}
+
+void CAENHVAsyn::publishCapture(const Capture& c)
+{
+    const TripEvent& t( c.trips.front() );
+
+    lock();
+    for (std::map< std::string, std::pair<int, int> >::const_iterator it = postMortemParams.traces.begin(); it != postMortemParams.traces.end(); ++it)
+    {
+        std::vector<double>& values( arrayParamList.at(it->second.first).values );
+        std::vector<double>& times( arrayParamList.at(it->second.second).values );
+        values.clear();
+        times.clear();
+
+        // The trace of the tripped channel, with the times relative to the trip
+        for (std::vector<CaptureSection>::const_iterator sIt = c.sections.begin(); sIt != c.sections.end(); ++sIt)
+        {
+            if ( ( sIt->slot != t.slot ) || sIt->param.compare(it->first) )
+                continue;
+
+            std::vector<uint16_t>::const_iterator chIt = std::find(sIt->channels.begin(), sIt->channels.end(), t.channel);
+            if ( chIt == sIt->channels.end() )
+                break;
+
+            std::size_t width( sIt->channels.size() );
+            std::size_t column( chIt - sIt->channels.begin() );
+            for (std::size_t i(0); ( i < sIt->times.size() ) && ( i < times.capacity() ); ++i)
+            {
+                values.push_back( sIt->values.at(i * width + column) );
+                times.push_back( sIt->times.at(i) - t.time );
+            }
+            break;
+        }
+
+        doArrayCallbacks(it->second.first);
+        doArrayCallbacks(it->second.second);
+    }
+
+    setDiagParam(postMortemParams.count,   postMortem->getNumCaptures());
+    setDiagParam(postMortemParams.trips,   postMortem->getNumTrips());
+    setDiagParam(postMortemParams.slot,    t.slot);
+    setDiagParam(postMortemParams.channel, t.channel);
+    setDiagParam(postMortemParams.status,  t.status);
+    setDiagParam(postMortemParams.time,    t.time);
+    callParamCallbacks();
+    unlock();
+}
+
+void CAENHVAsyn::postMortemTask()
+{
+    static std::string method("postMortemTask");
+
+    const PostMortemConfig& config( postMortem->getConfig() );
+
+    for(;;)
+    {
+        // The poller keeps recording the history after the trip while waiting
+        Capture c;
+        postMortem->waitCapture(c.trips);
+
+        const TripEvent& t( c.trips.front() );
+        c.start = t.time - config.pre;
+        c.end   = t.time + config.post;
+
+        freezeCapture(c);
+        publishCapture(c);
+
+        std::string fileName;
+        if ( ! config.path.empty() )
+        {
+            try
+            {
+                fileName = postMortem->write(c);
+            }
+            catch(std::runtime_error& e)
+            {
+                asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                            "Driver '%s', Port '%s', Method '%s' : failed to write the post-mortem capture: '%s'\n", \
+                            this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), e.what());
+            }
+        }
+
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s' : channel %zu of slot %zu tripped (status bits 0x%04x). " \
+                    "Post-mortem capture of %zu trips, and %zu parameter histories%s%s\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), t.channel, t.slot, t.status, \
+                    c.trips.size(), c.sections.size(), fileName.empty() ? "" : ", written to ", fileName.c_str());
+    }
+}
+
+void CAENHVAsyn::eventTask()
+{
+    static std::string method("eventTask");
+
+    std::vector<ParameterEvent> events;
+
+    for(;;)
+    {
+        // No events are received while the crate is disconnected
+        if ( ! crate->isConnected() )
+        {
+            epicsThreadSleep(pollPeriod_);
+            continue;
+        }
+
+        try
+        {
+            ioWorker->run(IO_PRIORITY_NORMAL, IO_NO_SLOT, [&]() { subscription->getEvents(events); });
+        }
+        catch(std::runtime_error& e)
+        {
+            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s', Method '%s' : exception caught '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), e.what());
+
+            epicsThreadSleep(pollPeriod_);
+            continue;
+        }
+
+        if ( events.empty() )
+        {
+            epicsThreadSleep(eventIdleTime);
+            continue;
+        }
+
+        // Only the values that have changed are published, on the address of each parameter
+        std::set<int> changed;
+        std::set<int> changedArrays;
+        double        time( getPosixTime() );
+
+        lock();
+        for (std::vector<ParameterEvent>::iterator it = events.begin(); it != events.end(); ++it)
+        {
+            std::map< eventKey_t, EventTarget >::iterator tIt = eventTargets.find( eventKey_t( it->slot, it->channel, it->param ) );
+
+            // Board parameter events may carry a channel number
+            if ( tIt == eventTargets.end() )
+                tIt = eventTargets.find( eventKey_t( it->slot, -1, it->param ) );
+
+            if ( tIt == eventTargets.end() )
+                continue;
+
+            bool   updated(false);
+            double value(0);
+            switch ( tIt->second.type )
+            {
+                case EVENT_VALUE_FLOAT:
+                    updated = updateParamValue( tIt->second.index, it->floatValue );
+                    value   = it->floatValue;
+                    break;
+
+                case EVENT_VALUE_UINT:
+                    if ( postMortem )
+                        checkTrip( tIt->second.index, static_cast<uint32_t>(it->intValue), time );
+                    updated = updateParamValue( tIt->second.index, static_cast<uint32_t>(it->intValue) );
+                    value   = static_cast<uint32_t>(it->intValue);
+                    break;
+
+                case EVENT_VALUE_INT:
+                    updated = updateParamValue( tIt->second.index, it->intValue );
+                    value   = it->intValue;
+                    break;
+            }
+
+            if ( updated )
+            {
+                setIndexedParamStatus( tIt->second.index, asynSuccess );
+                changed.insert( getParamAddr(tIt->second.index) );
+
+                if ( tIt->second.arrayIndex >= 0 )
+                {
+                    arrayParamList.at(tIt->second.arrayIndex).values.at(tIt->second.arrayPos) = value;
+                    changedArrays.insert(tIt->second.arrayIndex);
+                }
+            }
+        }
+        callAddrCallbacks(changed);
+        for (std::set<int>::iterator aIt = changedArrays.begin(); aIt != changedArrays.end(); ++aIt)
+            doArrayCallbacks(*aIt);
+        unlock();
+    }
+}
+
+void CAENHVAsyn::writerTask()
+{
+    static std::string method("writerTask");
+
+    for(;;)
+    {
+        writeQueue->wait();
+
+        // Gather the writes received during the window, and send them together
+        epicsThreadSleep(writeWindow_);
+
+        std::vector<IWriteQueue::writeKey_t> failed;
+
+        try
+        {
+            // The writes are sent with the same priority as the operator writes
+            ioWorker->run(IO_PRIORITY_HIGH, IO_NO_SLOT, [&]() { writeQueue->flush(failed); });
+
+            asynPrint(pasynUserSelf, ASYN_TRACEIO_DRIVER, \
+                        "Driver '%s', Port '%s', Method '%s' : %zu writes received, %zu calls made to the crate\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), writeQueue->getNumWrites(), writeQueue->getNumCalls());
+        }
+        catch(std::runtime_error& e)
+        {
+            asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                        "Driver '%s', Port '%s', Method '%s' : exception caught '%s'\n", \
+                        this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), e.what());
+
+            queuedWritesFailed(failed);
+        }
+    }
+}
+
+Crate CAENHVAsyn::createCrate(const std::string& portName, int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password)
+{
+    // Check parameters
+    if ( portName.empty() )
+        throw std::runtime_error("The port name must be defined");
+
+    if ( userName.empty() )
+        throw std::runtime_error("The user name must be defined");
+
+    if ( ipAddr.empty() )
+        throw std::runtime_error("The IP address must be defined");
+    else
+    {
+        unsigned char buf[sizeof(struct in6_addr)];
+        if (!inet_pton(AF_INET, ipAddr.c_str(), buf))
+            throw std::runtime_error("Invalid IP address");
+    }
+
+    // Only SYx527 are supported at the
+    if ( (systemType < 0) || (systemType > 3) )
+        throw std::runtime_error("Unsupported system type. Only supported types are SYx527 (0-3)");
+
+    // Create a Crate object
+    // The discovery cache is used only if its location was defined
+    std::string cacheFileName;
+    if ( ! discoveryCachePath.empty() )
+        cacheFileName = discoveryCachePath + "CAENHVAsyn_" + portName + "_discoveryCache.txt";
+
+    return ICrate::create(systemType, ipAddr, userName, password, discoverySlotWorkers, discoveryChannelWorkers, cacheFileName, linkConfig);
+}
+
+// Add the names of the channel parameters read by the poller to a set, and return the number of parameters
+template <typename T>
+static std::size_t addPolledNames(const std::vector<T>& params, std::set<std::string>& names)
+{
+    for (typename std::vector<T>::const_iterator it = params.begin(); it != params.end(); ++it)
+        if ( (*it)->getMode().compare("WO") )
+            names.insert( (*it)->getParam() );
+
+    return params.size();
+}
+
+std::size_t CAENHVAsyn::countParams(Crate c, bool polling)
+{
+    // The system properties, and the driver parameters, are defined on address 0
+    std::size_t n(NUM_WIRE_CALLS * NUM_WIRE_DIAG_PARAMS + NUM_POLL_DIAG_PARAMS + NUM_IO_PRIORITIES * NUM_IO_DIAG_PARAMS \
+                + NUM_LOCK_DIAG_PARAMS + NUM_LINK_DIAG_PARAMS);
+
+    // The default scan class, and the scan classes loaded from file
+    n += NUM_SCAN_DIAG_PARAMS * ( 1 + ( scanClasses ? scanClasses->size() : 0 ) );
+
+    n += c->getSystemPropertyIntegers().size() + c->getSystemPropertyFloats().size() + c->getSystemPropertyStrings().size();
+
+    // Names of the channel parameters with a history. Each of them has two post-mortem traces.
+    std::set<std::string> historyNames;
+
+    // Number of parameters in the largest list of a slot
+    std::size_t maxSlot(0);
+
+    std::vector<Board> b = c->getBoards();
+    for (std::vector<Board>::iterator boardIt = b.begin(); boardIt != b.end(); ++boardIt)
+    {
+        // The parameter to disable the slot is defined on address 0
+        ++n;
+
+        // The board parameters
+        std::size_t nSlot( (*boardIt)->getBoardParameterNumerics().size()   + (*boardIt)->getBoardParameterOnOffs().size() \
+                         + (*boardIt)->getBoardParameterChStatuses().size() + (*boardIt)->getBoardParameterBdStatuses().size() );
+
+        // Names of the channel parameters of this board read by the poller. When the poller is enabled,
+        // each of them has an array parameter, with all the channels of the board, and the numeric ones
+        // matching a history rule have two history parameters.
+        std::set<std::string> numericNames;
+        std::set<std::string> names;
+
+        std::vector<Channel> ch = (*boardIt)->getChannels();
+        for(std::vector<Channel>::iterator channelIt = ch.begin(); channelIt != ch.end(); ++channelIt)
+        {
+            nSlot += addPolledNames((*channelIt)->getChannelParameterNumerics(),   numericNames) \
+                   + addPolledNames((*channelIt)->getChannelParameterOnOffs(),     names) \
+                   + addPolledNames((*channelIt)->getChannelParameterChStatuses(), names) \
+                   + addPolledNames((*channelIt)->getChannelParameterBinaries(),   names);
+        }
+
+        if (polling)
+        {
+            nSlot += numericNames.size() + names.size();
+
+            for (std::set<std::string>::const_iterator it = numericNames.begin(); it != numericNames.end(); ++it)
+            {
+                if ( getHistoryRule(*it) )
+                {
+                    nSlot += 2;
+                    historyNames.insert(*it);
+                }
+            }
+        }
+
+        maxSlot = std::max(maxSlot, nSlot);
+    }
+
+    if ( postMortemConfig.enabled && ( ! historyNames.empty() ) )
+        n += NUM_PM_PARAMS + 2 * historyNames.size();
+
+    return std::max(n, maxSlot);
+}
+
+CAENHVAsyn::CAENHVAsyn(const std::string& portName, int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password)
+:
+    CAENHVAsyn(portName, createCrate(portName, systemType, ipAddr, userName, password))
+{
+}
+
+CAENHVAsyn::CAENHVAsyn(const std::string& portName, Crate c)
+:
+    CAENHVAsyn(portName, c, countParams(c, pollPeriod > 0))
+{
+}
+
+CAENHVAsyn::CAENHVAsyn(const std::string& portName, Crate c, std::size_t numParams)
+:
+    asynPortDriver(
+        portName.c_str(),
+        countAddresses(c),
+        numParams,
+        asynInt32Mask | asynDrvUserMask | asynInt16ArrayMask | asynInt32ArrayMask | asynOctetMask | \
+        asynFloat64ArrayMask | asynUInt32DigitalMask | asynFloat64Mask,                             // Interface Mask
+        asynInt16ArrayMask | asynInt32ArrayMask | asynInt32Mask | asynUInt32DigitalMask | \
+        asynFloat64Mask,                                                                            // Interrupt Mask
+        ASYN_MULTIDEVICE | ASYN_CANBLOCK,                                                           // asynFlags
+        1,                                                                                          // Autoconnect
+        0,                                                                                          // Default priority
+        0),                                                                                         // Default stack size
+    driverName_("CAENHVAsyn"),
+    portName_(portName),
+    pollPeriod_(pollPeriod),
+    writeWindow_(writeWindow),
+    hotPlugPeriod_(hotPlugPeriod),
+    crate(c),
+    polling(pollPeriod > 0),
+    linkUp(true),
+    restorePending(false)
+{
+    lockDiag.depth = 0;
+    lockDiag.count = 0;
+    lockDiag.total = 0;
+    lockDiag.max   = 0;
+
+    paramIndex.reserve(numParams);
+
+    // Print the crate map to the IOC shell
+    std::cout << std::endl;
+    crate->printCrateMap(std::cout);
+    std::cout << std::endl;
+
+    // The crate information file is written by a background thread once the IOC is running,
+    // from the metadata found during discovery and the values read by the poller
+    std::cout << "The crate information will be written to '" << crateInfoFilePath << this->driverName_ << "_" << this->portName_ << "_crateInfo.txt' once the IOC is running." << std::endl;
+
+    if (epicsPrefix.empty())
+        std::cout << "Autogeneration of PVs is disabled." << std::endl;
+    else
+    {
+        std::cout << "Autogeneration of PVs is enabled with prefix '" << epicsPrefix << "'" << std::endl;
+
+        // All the records are collected, and loaded at once from a single database file
+        records = IRecordFile::create(crateInfoFilePath + this->driverName_ + "_" + this->portName_ + "_records.db");
+    }
+
+    // Scan classes used by the poller. The default class must be the first one.
+    {
+        ScanClass c;
+        c.name   = "default";
+        c.period = pollPeriod_;
+        scanSchedule.push_back(c);
+
+        if (scanClasses)
+            for (std::size_t i(0); i < scanClasses->size(); ++i)
+                scanSchedule.push_back(scanClasses->at(i));
+    }
+
+    // System properties
+    {
+        std::vector<SystemPropertyInteger> s = crate->getSystemPropertyIntegers();
+        for (std::vector<SystemPropertyInteger>::iterator it = s.begin(); it != s.end(); ++it)
+            createParamInteger<SystemPropertyInteger>(*it, systemPropertyIntegerList);
+    }
+
+    {
+        std::vector<SystemPropertyFloat> s = crate->getSystemPropertyFloats();
+        for (std::vector<SystemPropertyFloat>::iterator it = s.begin(); it != s.end(); ++it)
+            createParamFloat<SystemPropertyFloat>(*it, systemPropertyFloatList);
+    }
+
+    {
+        std::vector<SystemPropertyString> s = crate->getSystemPropertyStrings();
+        for (std::vector<SystemPropertyString>::iterator it = s.begin(); it != s.end(); ++it)
+            createParamString<SystemPropertyString>(*it, systemPropertyStringList);
+    }
+
+    // Boards
+    std::vector<Board> b = crate->getBoards();
+
+    for (std::vector<Board>::iterator boardIt = b.begin(); boardIt != b.end(); ++boardIt)
+    {
+        std::vector<BoardParameterNumeric> pn = (*boardIt)->getBoardParameterNumerics();
+
+        for (std::vector<BoardParameterNumeric>::iterator paramIt = pn.begin(); paramIt != pn.end(); ++paramIt)
+            createParamFloat<BoardParameterNumeric>(*paramIt, boardParameterNumericList);
+
+        std::vector<BoardParameterOnOff> po = (*boardIt)->getBoardParameterOnOffs();
+
+        for (std::vector<BoardParameterOnOff>::iterator paramIt = po.begin(); paramIt != po.end(); ++paramIt)
+            createParamBinary<BoardParameterOnOff>(*paramIt, boardParameterOnOffList);
+
+        std::vector<BoardParameterChStatus> pcs = (*boardIt)->getBoardParameterChStatuses();
+
+        for (std::vector<BoardParameterChStatus>::iterator paramIt = pcs.begin(); paramIt != pcs.end(); ++paramIt)
+            createParamMBinary<BoardParameterChStatus>(*paramIt, boardParameterChStatusList, recordFieldBdParamChStatus);
+
+        std::vector<BoardParameterBdStatus> pbs = (*boardIt)->getBoardParameterBdStatuses();
+
+        for (std::vector<BoardParameterBdStatus>::iterator paramIt = pbs.begin(); paramIt != pbs.end(); ++paramIt)
+            createParamMBinary<BoardParameterBdStatus>(*paramIt, boardParameterBdStatusList, recordFieldBdParamBdStatus);
+
+        std::vector<Channel> c = (*boardIt)->getChannels();
+
+        for(std::vector<Channel>::iterator channelIt = c.begin(); channelIt != c.end(); ++channelIt)
+        {
+            std::vector<ChannelParameterNumeric> cpn = (*channelIt)->getChannelParameterNumerics();
+            for (std::vector<ChannelParameterNumeric>::iterator paramIt = cpn.begin(); paramIt != cpn.end(); ++paramIt)
+                createParamFloat<ChannelParameterNumeric>(*paramIt, channelParameterNumericList);
+
+            std::vector<ChannelParameterOnOff> cpo = (*channelIt)->getChannelParameterOnOffs();
+            for (std::vector<ChannelParameterOnOff>::iterator paramIt = cpo.begin(); paramIt != cpo.end(); ++paramIt)
+                createParamBinary<ChannelParameterOnOff>(*paramIt, channelParameterOnOffList);
+
+            std::vector<ChannelParameterChStatus> cpcs = (*channelIt)->getChannelParameterChStatuses();
+            for (std::vector<ChannelParameterChStatus>::iterator paramIt = cpcs.begin(); paramIt != cpcs.end(); ++paramIt)
+                createParamMBinary<ChannelParameterChStatus>(*paramIt, channelParameterChStatusList, recordFieldChParamChStatus);
+
+            std::vector<ChannelParameterBinary> cpb = (*channelIt)->getChannelParameterBinaries();
+            for (std::vector<ChannelParameterBinary>::iterator paramIt = cpb.begin(); paramIt != cpb.end(); ++paramIt)
+                createParamInteger<ChannelParameterBinary>(*paramIt, channelParameterBinaryList);
+        }
+    }
+
+    // Array parameters, containing all the channels of each channel parameter group
+    createParamArray(pollChannelFloatList, true);
+    createParamArray(pollChannelUIntList,  false);
+    createParamArray(pollChannelIntList,   false);
+
+    // History parameters of the numeric channel parameter groups
+    createParamHistory(pollChannelFloatList);
+    if ( ! historyParamList.empty() )
+    {
+        std::size_t memory(0);
+        for (std::map<int, HistoryParam>::const_iterator it = historyParamList.begin(); it != historyParamList.end(); ++it)
+            memory += it->second.buffer->getMemory();
+
+        std::cout << "Created " << historyParamList.size() << " history buffers, using " << ( memory + 1023 ) / 1024 << " kB." << std::endl;
+    }
+
+    // Post-mortem capture of the channel trips, frozen from the history buffers
+    if ( postMortemConfig.enabled )
+    {
+        if ( historyParamList.empty() )
+        {
+            std::cerr << "The post-mortem capture requires history buffers. It will be disabled." << std::endl;
+        }
+        else
+        {
+            postMortem = IPostMortem::create(postMortemConfig, portName_);
+            createPostMortemParams();
+        }
+    }
+
+    // Parameters to disable each slot
+    createSlotParams();
+
+    // Diagnostic parameters
+    createDiagParams();
+
+    std::cout << "Created " << paramIndex.size() << " asyn parameters, on " << maxAddr << " addresses with a table of " << numParams << " parameters each." << std::endl;
+
+    // Load the auto-generated records
+    if (records)
+    {
+        std::cout << "Loading " << records->getSize() << " records from '" << records->getFileName() << "'... ";
+        bool reused( records->load() );
+        std::cout << ( reused ? "Done (reused existing file)" : "Done" ) << std::endl;
+    }
+
+    // Start the I/O worker thread. From now on, all the calls to the crate are run by it.
+    std::cout << "Starting I/O worker. Writes are " << ( asyncWrites ? "asynchronous." : "synchronous." ) << std::endl;
+    ioWorker = IIoWorker::create("CAENHVAsynIO", slotBreakerConfig);
+
+    // Follow the connection state of the crate
+    crate->getLink()->setStateCallback([this](linkState_t s) { linkStateChanged(s); });
+
+    // Start the write queue thread
+    if ( writeWindow_ > 0 )
+    {
+        std::cout << "Starting write queue with a window of " << writeWindow_ << " s." << std::endl;
+
+        writeQueue = IWriteQueue::create(crate->getHandle());
+
+        epicsThreadCreate("CAENHVAsynWriter",
+                          epicsThreadPriorityMedium,
+                          epicsThreadGetStackSize(epicsThreadStackMedium),
+                          (EPICSTHREADFUNC)writerTaskC,
+                          this);
+    }
+
+    // Subscribe to parameter changes and start the event thread
+    if ( eventMode )
+    {
+        if ( polling )
+        {
+            subscribeParams();
+
+            if ( ! eventTargets.empty() )
+                epicsThreadCreate("CAENHVAsynEvents",
+                                  epicsThreadPriorityMedium,
+                                  epicsThreadGetStackSize(epicsThreadStackMedium),
+                                  (EPICSTHREADFUNC)eventTaskC,
+                                  this);
+        }
+        else
+        {
+            std::cerr << "The event mode requires the parameter poller. The event mode will be disabled." << std::endl;
+        }
+    }
+
+    // Start the poller thread
+    if (polling)
+    {
+        std::size_t groups = pollChannelFloatList.size() + pollChannelUIntList.size() + pollChannelIntList.size() \
+                           + pollBoardFloatList.size()   + pollBoardUIntList.size() \
+                           + pollSystemIntList.size()    + pollSystemFloatList.size() + pollSystemStringList.size();
+
+        std::cout << "Starting parameter poller with a period of " << pollPeriod_ << " s: " \
+                  << groups << " parameter groups." << std::endl;
+
+        if (scanClasses)
+        {
+            std::cout << "Scan classes:" << std::endl;
+            scanClasses->printInfo(std::cout);
+        }
+
+        epicsThreadCreate("CAENHVAsynPoller",
+                          epicsThreadPriorityMedium,
+                          epicsThreadGetStackSize(epicsThreadStackMedium),
+                          (EPICSTHREADFUNC)pollerTaskC,
+                          this);
+    }
+    else
+    {
+        std::cout << "The parameter poller is disabled." << std::endl;
+    }
+
+    // Start the hot-plug thread. The link is reconnected even if some boards have
+    // changed while it was down, as the changed slots are rebuilt by this thread.
+    if ( hotPlugPeriod_ > 0 )
+    {
+        std::cout << "Starting hot-plug check with a period of " << hotPlugPeriod_ << " s." << std::endl;
+
+        crate->getLink()->acceptMapChanges(true);
+
+        epicsThreadCreate("CAENHVAsynHotPlug",
+                          epicsThreadPriorityLow,
+                          epicsThreadGetStackSize(epicsThreadStackMedium),
+                          (EPICSTHREADFUNC)hotPlugTaskC,
+                          this);
+    }
+    else
+    {
+        std::cout << "The hot-plug check is disabled." << std::endl;
+    }
+
+    // Start the post-mortem thread
+    if ( postMortem )
+    {
+        const PostMortemConfig& config( postMortem->getConfig() );
+
+        std::cout << "Starting post-mortem capture of " << config.pre << " s before and " << config.post << " s after each trip, on " \
+                  << ( config.crateWide ? "all the boards" : "the tripped boards" ) << ". ";
+        if ( config.path.empty() )
+            std::cout << "The captures will not be written to disk." << std::endl;
+        else
+            std::cout << "The captures will be written to '" << config.path << "'." << std::endl;
+
+        // The history must cover the whole window, or the oldest samples are lost
+        std::set<std::string> shortHistories;
+        for (std::vector< PollEntry<ChannelParameterGroupFloat> >::const_iterator it = pollChannelFloatList.begin(); it != pollChannelFloatList.end(); ++it)
+        {
+            if ( it->historyIndex < 0 )
+                continue;
+
+            const HistoryBuffer& h( historyParamList.at(it->historyIndex).buffer );
+            double covered( h->getCapacity() * h->getDecimation() * scanSchedule.at(it->scanClass).period );
+            if ( ( covered > 0 ) && ( covered < config.pre + config.post ) )
+                shortHistories.insert( it->group->getParam() );
+        }
+        for (std::set<std::string>::const_iterator it = shortHistories.begin(); it != shortHistories.end(); ++it)
+            std::cerr << "The history of '" << *it << "' is shorter than the post-mortem window. Its captures will be incomplete." << std::endl;
+
+        epicsThreadCreate("CAENHVAsynPostMortem",
+                          epicsThreadPriorityLow,
+                          epicsThreadGetStackSize(epicsThreadStackMedium),
+                          (EPICSTHREADFUNC)postMortemTaskC,
+                          this);
+    }
+    else
+    {
+        std::cout << "The post-mortem capture is disabled." << std::endl;
+    }
+
+    // Start the diagnostic thread
+    epicsThreadCreate("CAENHVAsynDiag",
+                      epicsThreadPriorityLow,
+                      epicsThreadGetStackSize(epicsThreadStackMedium),
+                      (EPICSTHREADFUNC)diagTaskC,
+                      this);
+
+    drivers[portName_] = this;
+}
+
+std::string CAENHVAsyn::getCachedValue(const std::string& paramName, const std::vector<PublishedValue>& values, bool isString, bool json) const
+{
+    std::unordered_map<std::string, int>::const_iterator it = paramIndex.find(paramName);
+
+    // Only parameters updated by the poller, or by events, have a cached value
+    if ( ( it == paramIndex.end() ) || ( static_cast<std::size_t>(it->second) >= values.size() ) || ( ! values.at(it->second).valid ) )
+        return json ? "null" : "n/a";
+
+    const PublishedValue& v( values.at(it->second) );
+
+    if ( isString )
+        return json ? jsonString(v.text) : v.text;
+
+    std::stringstream temp;
+    temp << v.value;
+    return temp.str();
+}
+
+void CAENHVAsyn::writeParamInfo(std::ostream& stream, bool json, const ParamInfo& info, const std::string& paramName, const std::vector<PublishedValue>& values) const
+{
+    std::string value( getCachedValue(paramName, values, false, json) );
+
+    if ( json )
+    {
+        stream << "{\"name\": "       << jsonString(info.name) \
+               << ", \"type\": "      << jsonString(paramTypeName(info.type)) \
+               << ", \"mode\": "      << jsonString(processMode(info.mode));
+
+        if ( info.type == PARAM_TYPE_NUMERIC )
+            stream << ", \"minVal\": " << info.minVal \
+                   << ", \"maxVal\": " << info.maxVal \
+                   << ", \"units\": "  << jsonString(info.units);
+
+        if ( info.type == PARAM_TYPE_ONOFF )
+            stream << ", \"onState\": "  << jsonString(info.onState) \
+                   << ", \"offState\": " << jsonString(info.offState);
+
+        stream << ", \"epicsParamName\": " << jsonString(paramName) \
+               << ", \"value\": "          << value << "}";
+    }
+    else
+    {
+        stream << "Param = " << info.name \
+               << ", Type = " << paramTypeName(info.type) \
+               << ", Mode = " << processMode(info.mode);
+
+        if ( info.type == PARAM_TYPE_NUMERIC )
+            stream << ", Minval = " << info.minVal \
+                   << ", Maxval = " << info.maxVal \
+                   << ", Units = "  << info.units;
+
+        if ( info.type == PARAM_TYPE_ONOFF )
+            stream << ", On state = "  << info.onState \
+                   << ", Off state = " << info.offState;
+
+        stream << ", Value = "          << value \
+               << ", epicsParamName = " << paramName \
+               << std::endl;
+    }
+}
+
+template <typename T>
+void CAENHVAsyn::writePropertyInfo(std::ostream& stream, bool json, bool& first, const std::vector<T>& props, bool isString, const std::vector<PublishedValue>& values) const
+{
+    for (typename std::vector<T>::const_iterator it = props.begin(); it != props.end(); ++it)
+    {
+        std::string value( getCachedValue((*it)->getEpicsParamName(), values, isString, json) );
+
+        if ( json )
+        {
+            stream << ( first ? "\n    " : ",\n    " ) \
+                   << "{\"name\": "            << jsonString((*it)->getProp()) \
+                   << ", \"mode\": "           << jsonString((*it)->getMode()) \
+                   << ", \"epicsParamName\": " << jsonString((*it)->getEpicsParamName()) \
+                   << ", \"value\": "          << value << "}";
+        }
+        else
+        {
+            stream << "      Name = "           << (*it)->getProp() \
+                   << ", Mode = "               << (*it)->getMode() \
+                   << ", Value = "              << value \
+                   << ", epicsParamName = "     << (*it)->getEpicsParamName() \
+                   << std::endl;
+        }
+
+        first = false;
+    }
+}
+
+void CAENHVAsyn::writeCrateInfo(std::ostream& stream, bool json)
+{
+    // Copy the last published values, so that the port is not locked while writing
+    lock();
+    std::vector<PublishedValue> values(publishedValues);
+    unlock();
+
+    std::vector<Board> b = crate->getBoards();
+
+    if ( json )
+    {
+        bool first(true);
+
+        stream << "{" << std::endl;
+        stream << "  \"port\": "     << jsonString(portName_) << "," << std::endl;
+        stream << "  \"numSlots\": " << crate->getNumSlots() << "," << std::endl;
+        stream << "  \"systemProperties\": [";
+        writePropertyInfo(stream, json, first, crate->getSystemPropertyIntegers(), false, values);
+        writePropertyInfo(stream, json, first, crate->getSystemPropertyFloats(),   false, values);
+        writePropertyInfo(stream, json, first, crate->getSystemPropertyStrings(),  true,  values);
+        stream << std::endl << "  ]," << std::endl;
+        stream << "  \"boards\": [";
+
+        for (std::vector<Board>::const_iterator boardIt = b.begin(); boardIt != b.end(); ++boardIt)
+        {
+            BoardInfo info( (*boardIt)->getInfo() );
+
+            std::stringstream prefix;
+            prefix << "S" << std::setfill('0') << std::setw(2) << info.slot << "_";
+
+            stream << ( ( boardIt == b.begin() ) ? "\n    {" : ",\n    {" ) << std::endl;
+            stream << "      \"slot\": "            << info.slot                        << "," << std::endl;
+            stream << "      \"model\": "           << jsonString(info.model)           << "," << std::endl;
+            stream << "      \"description\": "     << jsonString(info.description)     << "," << std::endl;
+            stream << "      \"numChannels\": "     << info.numChannels                 << "," << std::endl;
+            stream << "      \"serialNumber\": "    << jsonString(info.serialNumber)    << "," << std::endl;
+            stream << "      \"firmwareRelease\": " << jsonString(info.firmwareRelease) << "," << std::endl;
+            stream << "      \"params\": [";
+            for (std::vector<ParamInfo>::const_iterator it = info.params.begin(); it != info.params.end(); ++it)
+            {
+                stream << ( ( it == info.params.begin() ) ? "\n        " : ",\n        " );
+                writeParamInfo(stream, json, *it, prefix.str() + processParamName(it->name), values);
+            }
+            stream << std::endl << "      ]," << std::endl;
+            stream << "      \"channels\": [";
+            for (std::size_t c(0); c < info.channelParams.size(); ++c)
+            {
+                std::stringstream channelPrefix;
+                channelPrefix << prefix.str() << "C" << std::setfill('0') << std::setw(2) << c << "_";
+
+                stream << ( ( c == 0 ) ? "\n        " : ",\n        " );
+                stream << "{\"channel\": " << c << ", \"params\": [";
+                const std::vector<ParamInfo>& params( info.channelParams.at(c) );
+                for (std::vector<ParamInfo>::const_iterator it = params.begin(); it != params.end(); ++it)
+                {
+                    stream << ( ( it == params.begin() ) ? "\n          " : ",\n          " );
+                    writeParamInfo(stream, json, *it, channelPrefix.str() + processParamName(it->name), values);
+                }
+                stream << std::endl << "        ]}";
+            }
+            stream << std::endl << "      ]" << std::endl;
+            stream << "    }";
+        }
+
+        stream << std::endl << "  ]" << std::endl;
+        stream << "}" << std::endl;
+    }
+    else
+    {
+        bool first(true);
+
+        stream << "=========================" << std::endl;
+        stream << "Crate information:" << std::endl;
+        stream << "=========================" << std::endl;
+        stream << "  Port             : " << portName_ << std::endl;
+        stream << "  Number of slots  : " << crate->getNumSlots() << std::endl;
+        stream << "  Number of boards : " << b.size() << std::endl;
+        stream << "  Properties:" << std::endl;
+        stream << "  ---------------------------" << std::endl;
+        writePropertyInfo(stream, json, first, crate->getSystemPropertyIntegers(), false, values);
+        writePropertyInfo(stream, json, first, crate->getSystemPropertyFloats(),   false, values);
+        writePropertyInfo(stream, json, first, crate->getSystemPropertyStrings(),  true,  values);
+        stream << "  Board information: " << std::endl;
+        stream << "  ---------------------------" << std::endl;
+
+        for (std::vector<Board>::const_iterator boardIt = b.begin(); boardIt != b.end(); ++boardIt)
+        {
+            BoardInfo info( (*boardIt)->getInfo() );
+
+            std::stringstream prefix;
+            prefix << "S" << std::setfill('0') << std::setw(2) << info.slot << "_";
+
+            (*boardIt)->printBoardInfo(stream);
+            stream << "    Board parameters:" << std::endl;
+            stream << "    ..........................." << std::endl;
+            for (std::vector<ParamInfo>::const_iterator it = info.params.begin(); it != info.params.end(); ++it)
+            {
+                stream << "          ";
+                writeParamInfo(stream, json, *it, prefix.str() + processParamName(it->name), values);
+            }
+
+            stream << "    Channel parameters:" << std::endl;
+            stream << "    ..........................." << std::endl;
+            for (std::size_t c(0); c < info.channelParams.size(); ++c)
+            {
+                std::stringstream channelPrefix;
+                channelPrefix << prefix.str() << "C" << std::setfill('0') << std::setw(2) << c << "_";
+
+                stream << "      Slot = " << info.slot << ", Channel = " << c << std::endl;
+                const std::vector<ParamInfo>& params( info.channelParams.at(c) );
+                for (std::vector<ParamInfo>::const_iterator it = params.begin(); it != params.end(); ++it)
+                {
+                    stream << "          ";
+                    writeParamInfo(stream, json, *it, channelPrefix.str() + processParamName(it->name), values);
+                }
+            }
+        }
+
+        stream << "=========================" << std::endl;
+        stream << std::endl;
+    }
+}
+
+int CAENHVAsyn::createDiagParam(const std::string& name, const std::string& desc, const std::string& egu, int prec)
+{
+    return createDriverParam("DIAG_" + name, desc, egu, prec);
+}
+
+int CAENHVAsyn::createDriverParam(const std::string& paramName, const std::string& desc, const std::string& egu, int prec)
+{
+    int index( createIndexedParam(paramName, asynParamFloat64, 0) );
+    setDiagParam(index, 0);
+
+    if (records)
+    {
+        std::string recordName( paramName );
+        std::replace(recordName.begin(), recordName.end(), '_', ':');
+
+        std::stringstream dbParamsLocal;
+        dbParamsLocal << "P="      << CAENHVAsyn::epicsPrefix;
+        dbParamsLocal << ",PORT="  << portName_;
+        dbParamsLocal << ",ADDR="  << getParamAddr(index);
+        dbParamsLocal << ",PARAM=" << paramName;
+        dbParamsLocal << ",DESC="  << desc;
+        dbParamsLocal << ",EGU="   << egu;
+        dbParamsLocal << ",PREC="  << prec;
+        dbParamsLocal << ",LOPR=";
+        dbParamsLocal << ",HOPR=";
+        dbParamsLocal << ",SCAN=I/O Intr";
+        dbParamsLocal << ",R="     << recordName << ":Rd";
+        records->add("db/ai.template", dbParamsLocal.str().c_str());
+    }
+
+    return index;
+}
+
+void CAENHVAsyn::createDiagParams()
+{
+    for (std::size_t i(0); i < NUM_WIRE_CALLS; ++i)
+    {
+        std::string call( getWireCallName(static_cast<wireCall_t>(i)) );
+        std::string name( processParamName(call) + "_" );
+
+        WireDiagParams p;
+        p.count  = createDiagParam(name + "COUNT",  "'" + call + " calls'",              "",   0);
+        p.errors = createDiagParam(name + "ERRORS", "'" + call + " errors'",             "",   0);
+        p.mean   = createDiagParam(name + "MEAN",   "'" + call + " mean latency'",       "ms", 3);
+        p.p50    = createDiagParam(name + "P50",    "'" + call + " median latency'",     "ms", 3);
+        p.p99    = createDiagParam(name + "P99",    "'" + call + " 99th pct latency'",   "ms", 3);
+        p.max    = createDiagParam(name + "MAX",    "'" + call + " max latency'",        "ms", 3);
+        wireDiagParams.push_back(p);
+    }
+
+    for (std::vector<ScanClass>::const_iterator it = scanSchedule.begin(); it != scanSchedule.end(); ++it)
+    {
+        std::string name( "SCAN_" + processParamName(it->name) + "_" );
+        std::string desc( "'Scan class " + it->name );
+
+        ScanClassDiag d;
+        d.sweeps        = 0;
+        d.overruns      = 0;
+        d.total         = 0;
+        d.max           = 0;
+        d.sweepsParam   = createDiagParam(name + "SWEEPS",   desc + " sweeps'",         "",   0);
+        d.overrunsParam = createDiagParam(name + "OVERRUNS", desc + " overruns'",       "",   0);
+        d.lastParam     = createDiagParam(name + "LAST",     desc + " last sweep'",     "ms", 3);
+        d.maxParam      = createDiagParam(name + "MAX",      desc + " max sweep'",      "ms", 3);
+        d.meanParam     = createDiagParam(name + "MEAN",     desc + " mean sweep'",     "ms", 3);
+        scanClassDiag.push_back(d);
+    }
+
+    pollPendingParam = createDiagParam("POLL_PENDING", "'Scan classes due'",           "",   0);
+    pollOldestParam  = createDiagParam("POLL_OLDEST",  "'Delay of oldest scan class'", "ms", 3);
+
+    for (std::size_t i(0); i < NUM_IO_PRIORITIES; ++i)
+    {
+        std::string priority( getIoPriorityName(static_cast<ioPriority_t>(i)) );
+        std::string name( "IO_" + processParamName(priority) + "_" );
+        std::string desc( "'" + priority + " priority I/O " );
+
+        IoDiagParams p;
+        p.jobs     = createDiagParam(name + "JOBS",     desc + "jobs'",     "",   0);
+        p.pending  = createDiagParam(name + "PENDING",  desc + "pending'",  "",   0);
+        p.meanWait = createDiagParam(name + "MEANWAIT", desc + "mean wait'", "ms", 3);
+        p.maxWait  = createDiagParam(name + "MAXWAIT",  desc + "max wait'",  "ms", 3);
+        p.rejected = createDiagParam(name + "REJECTED", desc + "rejected'",  "",   0);
+        ioDiagParams.push_back(p);
+    }
+
+    lockDiag.countParam = createDiagParam("LOCK_COUNT", "'Port lock acquisitions'", "",   0);
+    lockDiag.meanParam  = createDiagParam("LOCK_MEAN",  "'Port lock mean hold'",    "ms", 3);
+    lockDiag.maxParam   = createDiagParam("LOCK_MAX",   "'Port lock max hold'",     "ms", 3);
+
+    linkDiagParams.state          = createDiagParam("LINK_STATE",          "'Crate link state'",          "", 0);
+    linkDiagParams.disconnections = createDiagParam("LINK_DISCONNECTIONS", "'Crate link disconnections'", "", 0);
+    linkDiagParams.reconnections  = createDiagParam("LINK_RECONNECTIONS",  "'Crate link reconnections'",  "", 0);
+    linkDiagParams.attempts       = createDiagParam("LINK_ATTEMPTS",       "'Crate reconnect attempts'",  "", 0);
+    linkDiagParams.rejected       = createDiagParam("LINK_REJECTED",       "'Calls rejected while down'", "", 0);
+}
+
+void CAENHVAsyn::updateSweepDiagParams(std::size_t scanClass, double sweepTime)
+{
+    ScanClassDiag& d( scanClassDiag.at(scanClass) );
+
+    ++d.sweeps;
+    d.total += sweepTime;
+    d.max    = std::max(d.max, sweepTime);
+
+    double period( scanSchedule.at(scanClass).period );
+    if ( ( period > 0 ) && ( sweepTime > period ) )
+        ++d.overruns;
+
+    lock();
+    setDiagParam(d.sweepsParam,   d.sweeps);
+    setDiagParam(d.overrunsParam, d.overruns);
+    setDiagParam(d.lastParam,     1e3 * sweepTime);
+    setDiagParam(d.maxParam,      1e3 * d.max);
+    setDiagParam(d.meanParam,     1e3 * d.total / d.sweeps);
+    callParamCallbacks();
+    unlock();
+}
+
+void CAENHVAsyn::updatePendingDiagParams(std::size_t pending, double oldest)
+{
+    lock();
+    setDiagParam(pollPendingParam, pending);
+    setDiagParam(pollOldestParam,  1e3 * oldest);
+    callParamCallbacks();
+    unlock();
+}
+
+void CAENHVAsyn::updateDiagParams()
+{
+    // The statistics of the calls made to this crate are read before locking the port
+    const WireStats& wireStats( crate->getLink()->getWireStats() );
+    std::vector<WireCallSummary> summaries;
+    for (std::size_t i(0); i < wireDiagParams.size(); ++i)
+        summaries.push_back( wireStats.get(static_cast<wireCall_t>(i)).getSummary() );
+
+    std::vector<IoQueueStats> ioStats;
+    for (std::size_t i(0); i < ioDiagParams.size(); ++i)
+        ioStats.push_back( ioWorker->getStats(static_cast<ioPriority_t>(i)) );
+
+    linkState_t linkState( crate->getLink()->getState() );
+    LinkStats   linkStats( crate->getLink()->getStats() );
+
+    lock();
+    for (std::size_t i(0); i < wireDiagParams.size(); ++i)
+    {
+        const WireDiagParams&  p( wireDiagParams.at(i) );
+        const WireCallSummary& s( summaries.at(i) );
+
+        setDiagParam(p.count,  s.count);
+        setDiagParam(p.errors, s.errors);
+        setDiagParam(p.mean,   s.mean);
+        setDiagParam(p.p50,    s.p50);
+        setDiagParam(p.p99,    s.p99);
+        setDiagParam(p.max,    s.max);
+    }
+    for (std::size_t i(0); i < ioDiagParams.size(); ++i)
+    {
+        const IoDiagParams& p( ioDiagParams.at(i) );
+        const IoQueueStats& s( ioStats.at(i) );
+
+        setDiagParam(p.jobs,     s.jobs);
+        setDiagParam(p.pending,  s.pending);
+        setDiagParam(p.meanWait, s.meanWait);
+        setDiagParam(p.maxWait,  s.maxWait);
+        setDiagParam(p.rejected, s.rejected);
+    }
+    setDiagParam(lockDiag.countParam, lockDiag.count);
+    setDiagParam(lockDiag.meanParam,  lockDiag.count ? ( 1e3 * lockDiag.total / lockDiag.count ) : 0);
+    setDiagParam(lockDiag.maxParam,   1e3 * lockDiag.max);
+    setDiagParam(linkDiagParams.state,          linkState);
+    setDiagParam(linkDiagParams.disconnections, linkStats.disconnections);
+    setDiagParam(linkDiagParams.reconnections,  linkStats.reconnections);
+    setDiagParam(linkDiagParams.attempts,       linkStats.attempts);
+    setDiagParam(linkDiagParams.rejected,       linkStats.rejected);
+    if ( postMortem )
+        setDiagParam(postMortemParams.trips, postMortem->getNumTrips());
+    callParamCallbacks();
+    unlock();
+}
+
+void CAENHVAsyn::diagTask()
+{
+    for(;;)
+    {
+        updateDiagParams();
+        epicsThreadSleep(diagPeriod);
+    }
+}
+
+void CAENHVAsyn::infoTask()
+{
+    static std::string method("infoTask");
+
+    // Wait for the first poller cycle, so that the values read from the crate are included
+    if ( polling && ( ! firstPollDone.wait(infoPollTimeout) ) )
+        asynPrint(pasynUserSelf, ASYN_TRACE_WARNING, \
+                    "Driver '%s', Port '%s', Method '%s' : the first poller cycle is not done. The crate information will not include all the values.\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str());
+
+    std::string infoFileName(crateInfoFilePath + this->driverName_ + "_" + this->portName_ + "_crateInfo.txt");
+    std::ofstream infoFile(infoFileName.c_str());
+
+    if ( ! infoFile.is_open() )
+    {
+        asynPrint(pasynUserSelf, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s' : could not open the crate information file '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), infoFileName.c_str());
+        return;
+    }
+
+    writeCrateInfo(infoFile, false);
+}
+
+CAENHVAsyn* CAENHVAsyn::findDriver(const std::string& portName)
+{
+    std::map<std::string, CAENHVAsyn*>::const_iterator it = drivers.find(portName);
+
+    if ( it == drivers.end() )
+        return NULL;
+
+    return it->second;
+}
+
+void CAENHVAsyn::startInfoTasks()
+{
+    for (std::map<std::string, CAENHVAsyn*>::const_iterator it = drivers.begin(); it != drivers.end(); ++it)
+        epicsThreadCreate("CAENHVAsynInfo",
+                          epicsThreadPriorityLow,
+                          epicsThreadGetStackSize(epicsThreadStackMedium),
+                          (EPICSTHREADFUNC)infoTaskC,
+                          it->second);
+}
+
+void CAENHVAsyn::printWireStats(std::ostream& stream, int level, bool reset)
+{
+    for (std::map<std::string, CAENHVAsyn*>::const_iterator it = drivers.begin(); it != drivers.end(); ++it)
+    {
+        WireStats& stats( it->second->crate->getLink()->getWireStats() );
+
+        stats.print(stream, "Port '" + it->first + "'", level);
+
+        if ( reset )
+            stats.reset();
+    }
+}
+
+////////////////////////////////////////////
+// Methods overridden from asynPortDriver //
+////////////////////////////////////////////
+asynStatus CAENHVAsyn::lock()
+{
+    asynStatus status( asynPortDriver::lock() );
+
+    if ( ( status == asynSuccess ) && ( lockDiag.depth++ == 0 ) )
+        lockDiag.start = std::chrono::steady_clock::now();
+
+    return status;
+}
+
+asynStatus CAENHVAsyn::unlock()
+{
+    // The statistics are updated before the lock is released
+    if ( ( lockDiag.depth > 0 ) && ( --lockDiag.depth == 0 ) )
+    {
+        double hold( std::chrono::duration<double>( std::chrono::steady_clock::now() - lockDiag.start ).count() );
+        ++lockDiag.count;
+        lockDiag.total += hold;
+        lockDiag.max    = std::max(lockDiag.max, hold);
+    }
+
+    return asynPortDriver::unlock();
+}
+
+const char* CAENHVAsyn::reasonName(int function)
+{
+    // The parameter name is only looked up when a message is printed
+    const char *name = "";
+    if ( ( function >= 0 ) && ( static_cast<std::size_t>(function) < paramAddresses.size() ) )
+        getParamName(getParamAddr(function), getParamReason(function), &name);
+
+    return name;
+}
+
+asynStatus CAENHVAsyn::readInt32(asynUser *pasynUser, epicsInt32 *value)
+{
+    static std::string method("readInt32");
+    int function( getParamIndex(pasynUser) );
+    int status(0);
+
+    // Handler associated to the function number
+    const ParamHandler& h = handlers.get(function);
+
+    // Check if the function is found in out lists
+    bool found = false;
+
+    // Parameters updated by the poller are read from the parameter cache
+    try
+    {
+        if ( ( h.kind == HANDLER_SYSTEM_INTEGER ) && ( ! h.polled ) )
+        {
+            ISystemPropertyInteger* p = static_cast<ISystemPropertyInteger*>(h.object);
+            ioRun(getReadPriority(h), h.slot, [&]() { *value = p->getVal(); });
+            found = true;
+        }
+    }
+    catch(std::runtime_error& e)
+    {
+        status = -1;
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), e.what());
+    }
+
+    // If the function was not found, fall back to the base method. A failed read
+    // is not found either, but it must keep its error so the record gets an alarm.
+    if ( ( ! found ) && ( 0 == status ) )
+        status = asynPortDriver::readInt32(pasynUser, value);
+
+    // Log status and return
+    if (0 == status)
+    {
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), *value);
+
+        return asynSuccess;
+    }
+    else
+    {
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), status);
+
+        return asynError;
+    }
+}
+
+asynStatus CAENHVAsyn::writeInt32(asynUser *pasynUser, epicsInt32 value)
+{
+    static std::string method("writeInt32");
+    int function( getParamIndex(pasynUser) );
+    int status(0);
+
+    // Handler associated to the function number
+    const ParamHandler& h = handlers.get(function);
+
+    // Check if the function is found in out lists
+    bool found = false;
+
+    try
+    {
+        if ( h.kind == HANDLER_SYSTEM_INTEGER )
+        {
+            ISystemPropertyInteger* p = static_cast<ISystemPropertyInteger*>(h.object);
+            ioWrite(function, [p, value]() { p->setVal(value); });
+            found = true;
+        }
+    }
+    catch(std::runtime_error& e)
+    {
+        status = -1;
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), e.what());
+    }
+
+    // If the function was not found, fall back to the base method. The parameters
+    // of a board which was removed or replaced can not be written. A failed write
+    // is not found, but it must not fall back, as it would report it as successful.
+    if ( ( ! found ) && ( 0 == status ) )
+        status = ( h.kind == HANDLER_DETACHED ) ? -1 : asynPortDriver::writeInt32(pasynUser, value);
+
+    // Log status and return
+    if (0 == status)
+    {
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), value);
+
+        return asynSuccess;
+    }
+    else
+    {
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%d', status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), value, status);
+
+        return asynError;
+    }
+}
+
+asynStatus CAENHVAsyn::drvUserCreate(asynUser *pasynUser, const char *drvInfo, const char **pptypeName, size_t *psize)
+{
+    static std::string method("drvUserCreate");
+
+    // Look up the parameter in the name index, instead of searching the parameter list.
+    // Names not found in the index are resolved by asynPortDriver.
+    std::unordered_map<std::string, int>::const_iterator it = paramIndex.find(drvInfo);
+    if ( it == paramIndex.end() )
+        return asynPortDriver::drvUserCreate(pasynUser, drvInfo, pptypeName, psize);
+
+    int addr;
+    if ( getAddress(pasynUser, &addr) != asynSuccess )
+        return asynError;
+
+    // Each parameter is only defined in the list of its address
+    if ( addr != getParamAddr(it->second) )
+    {
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s' : drvInfo '%s' must be used with address %d, not %d\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), drvInfo, getParamAddr(it->second), addr);
+        return asynError;
+    }
+
+    // Asyn numbers the parameters of each address separately
+    pasynUser->reason = getParamReason(it->second);
+
+    asynPrint(pasynUser, ASYN_TRACE_FLOW, \
+                "Driver '%s', Port '%s', Method '%s' : drvInfo '%s', index %d, address %d, reason %d\n", \
+                this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), drvInfo, it->second, addr, pasynUser->reason);
+
+    return asynSuccess;
+}
+
+asynStatus CAENHVAsyn::readFloat64(asynUser *pasynUser, epicsFloat64 *value)
+{
+    static std::string method("readFloat64");
+    int function( getParamIndex(pasynUser) );
+    int status(0);
+
+    // Handler associated to the function number
+    const ParamHandler& h = handlers.get(function);
+
+    // Check if the function is found in out lists
+    bool found = false;
+
+    // Parameters updated by the poller are read from the parameter cache
+    try
+    {
+        if ( ! h.polled )
+        {
+            switch ( h.kind )
+            {
+                case HANDLER_CHANNEL_NUMERIC:
+                {
+                    IChannelParameterNumeric* p = static_cast<IChannelParameterNumeric*>(h.object);
+                    ioRun(getReadPriority(h), h.slot, [&]() { *value = p->getVal(); });
+                    found = true;
+                    break;
+                }
+
+                case HANDLER_BOARD_NUMERIC:
+                {
+                    IBoardParameterNumeric* p = static_cast<IBoardParameterNumeric*>(h.object);
+                    ioRun(getReadPriority(h), h.slot, [&]() { *value = p->getVal(); });
+                    found = true;
+                    break;
+                }
+
+                case HANDLER_SYSTEM_FLOAT:
+                {
+                    ISystemPropertyFloat* p = static_cast<ISystemPropertyFloat*>(h.object);
+                    ioRun(getReadPriority(h), h.slot, [&]() { *value = p->getVal(); });
+                    found = true;
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+    }
+    catch(std::runtime_error& e)
+    {
+        status = -1;
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), e.what());
+    }
+
+    // If the function was not found, fall back to the base method. A failed read
+    // is not found either, but it must keep its error so the record gets an alarm.
+    if ( ( ! found ) && ( 0 == status ) )
+        status = asynPortDriver::readFloat64(pasynUser, value);
+
+    // Log status and return
+    if (0 == status)
+    {
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%f'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), *value);
+
+        return asynSuccess;
+    }
+    else
+    {
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), status);
+
+        return asynError;
+    }
+}
+
+asynStatus CAENHVAsyn::writeFloat64(asynUser *pasynUser, epicsFloat64 value)
+{
+    static std::string method("writeFloat64");
+    int function( getParamIndex(pasynUser) );
+    int status(0);
+
+    // Handler associated to the function number
+    const ParamHandler& h = handlers.get(function);
+
+    // Check if the function is found in out lists
+    bool found = false;
+
+    try
+    {
+        switch ( h.kind )
+        {
+            case HANDLER_CHANNEL_NUMERIC:
+            {
+                IChannelParameterNumeric* p = static_cast<IChannelParameterNumeric*>(h.object);
+
+                // When the write queue is enabled, the write is sent together with other writes of the same value
+                if ( writeQueue && p->getMode().compare("RO") )
+                    writeQueue->push(p->getSlot(), p->getChannel(), p->getParam(), static_cast<float>(value));
+                else
+                    ioWrite(function, [p, value]() { p->setVal(value); });
+                found = true;
+                break;
+            }
+
+            case HANDLER_BOARD_NUMERIC:
+            {
+                IBoardParameterNumeric* p = static_cast<IBoardParameterNumeric*>(h.object);
+                ioWrite(function, [p, value]() { p->setVal(value); });
+                found = true;
+                break;
+            }
+
+            case HANDLER_SYSTEM_FLOAT:
+            {
+                ISystemPropertyFloat* p = static_cast<ISystemPropertyFloat*>(h.object);
+                ioWrite(function, [p, value]() { p->setVal(value); });
+                found = true;
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+    catch(std::runtime_error& e)
+    {
+        status = -1;
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), e.what());
+    }
+
+    // If the function was not found, fall back to the base method. The parameters
+    // of a board which was removed or replaced can not be written. A failed write
+    // is not found, but it must not fall back, as it would report it as successful.
+    if ( ( ! found ) && ( 0 == status ) )
+        status = ( h.kind == HANDLER_DETACHED ) ? -1 : asynPortDriver::writeFloat64(pasynUser, value);
+
+    // Log status and return
+    if (0 == status)
+    {
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%f'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), value);
+
+        return asynSuccess;
+    }
+    else
+    {
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%f', status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), value, status);
+
+        return asynError;
+    }
+}
+
+asynStatus CAENHVAsyn::readUInt32Digital(asynUser *pasynUser, epicsUInt32 *value, epicsUInt32 mask)
+{
+    static std::string method("readUInt32Digital");
+    int function( getParamIndex(pasynUser) );
+    int status(0);
+
+    // Handler associated to the function number
+    const ParamHandler& h = handlers.get(function);
+
+    // Check if the function is found in out lists
+    bool found = false;
+
+    // Parameters updated by the poller are read from the parameter cache.
+    // For status words, the bits are read from the stored word.
+    try
+    {
+        if ( ! h.polled )
+        {
+            switch ( h.kind )
+            {
+                case HANDLER_BOARD_ONOFF:
+                {
+                    IBoardParameterOnOff* p = static_cast<IBoardParameterOnOff*>(h.object);
+                    ioRun(getReadPriority(h), h.slot, [&]() { *value = p->getVal() & mask; });
+                    found = true;
+                    break;
+                }
+
+                case HANDLER_BOARD_CHSTATUS:
+                {
+                    IBoardParameterChStatus* p = static_cast<IBoardParameterChStatus*>(h.object);
+                    ioRun(getReadPriority(h), h.slot, [&]() { *value = p->getVal() & mask; });
+                    found = true;
+                    break;
+                }
+
+                case HANDLER_BOARD_BDSTATUS:
+                {
+                    IBoardParameterBdStatus* p = static_cast<IBoardParameterBdStatus*>(h.object);
+                    ioRun(getReadPriority(h), h.slot, [&]() { *value = p->getVal() & mask; });
+                    found = true;
+                    break;
+                }
+
+                case HANDLER_CHANNEL_ONOFF:
+                {
+                    IChannelParameterOnOff* p = static_cast<IChannelParameterOnOff*>(h.object);
+                    ioRun(getReadPriority(h), h.slot, [&]() { *value = p->getVal() & mask; });
+                    found = true;
+                    break;
+                }
+
+                case HANDLER_CHANNEL_CHSTATUS:
+                {
+                    IChannelParameterChStatus* p = static_cast<IChannelParameterChStatus*>(h.object);
+                    ioRun(getReadPriority(h), h.slot, [&]() { *value = p->getVal() & mask; });
+                    found = true;
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+    }
+    catch(std::runtime_error& e)
+    {
+        status = -1;
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), e.what());
+    }
+
+    // If the function was not found, fall back to the base method. A failed read
+    // is not found either, but it must keep its error so the record gets an alarm.
+    if ( ( ! found ) && ( 0 == status ) )
+        status = asynPortDriver::readUInt32Digital(pasynUser, value, mask);
+
+    // Log status and return
+    if (0 == status)
+    {
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%d', mask '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), *value, mask);
+
+        return asynSuccess;
+    }
+    else
+    {
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, mask '%d', status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), mask, status);
+
+        return asynError;
+    }
+}
+
+
+asynStatus CAENHVAsyn::writeUInt32Digital(asynUser *pasynUser, epicsUInt32 value, epicsUInt32 mask)
+{
+    static std::string method("writeUInt32Digital");
+    int function( getParamIndex(pasynUser) );
+    int status(0);
+
+    epicsUInt32 val(0);
+    val &= ~mask;
+    val |= value;
+
+    // Handler associated to the function number
+    const ParamHandler& h = handlers.get(function);
+
+    // Check if the function is found in out lists
+    bool found = false;
+
+    try
+    {
+        switch ( h.kind )
+        {
+            case HANDLER_BOARD_ONOFF:
+            {
+                IBoardParameterOnOff* p = static_cast<IBoardParameterOnOff*>(h.object);
+                ioWrite(function, [p, val]() { p->setVal(val); });
+                found = true;
+                break;
+            }
+
+            case HANDLER_BOARD_CHSTATUS:
+            {
+                IBoardParameterChStatus* p = static_cast<IBoardParameterChStatus*>(h.object);
+                ioWrite(function, [p, val]() { p->setVal(val); });
+                found = true;
+                break;
+            }
+
+            case HANDLER_BOARD_BDSTATUS:
+            {
+                IBoardParameterBdStatus* p = static_cast<IBoardParameterBdStatus*>(h.object);
+                ioWrite(function, [p, val]() { p->setVal(val); });
+                found = true;
+                break;
+            }
+
+            case HANDLER_CHANNEL_ONOFF:
+            {
+                IChannelParameterOnOff* p = static_cast<IChannelParameterOnOff*>(h.object);
+
+                // When the write queue is enabled, the write is sent together with other writes of the same value
+                if ( writeQueue && p->getMode().compare("RO") )
+                    writeQueue->push(p->getSlot(), p->getChannel(), p->getParam(), static_cast<uint32_t>(val));
+                else
+                    ioWrite(function, [p, val]() { p->setVal(val); });
+                found = true;
+                break;
+            }
+
+            case HANDLER_CHANNEL_CHSTATUS:
+            {
+                IChannelParameterChStatus* p = static_cast<IChannelParameterChStatus*>(h.object);
+
+                // When the write queue is enabled, the write is sent together with other writes of the same value
+                if ( writeQueue && p->getMode().compare("RO") )
+                    writeQueue->push(p->getSlot(), p->getChannel(), p->getParam(), static_cast<uint32_t>(val));
+                else
+                    ioWrite(function, [p, val]() { p->setVal(val); });
+                found = true;
+                break;
+            }
+
+            case HANDLER_SLOT_DISABLE:
+            {
+                // The slot is detached and attached without the port lock, as the poller lock
+                // must be taken first. The value is then stored by the base method.
+                int slot( h.slot );
+                unlock();
+                setSlotEnabled(slot, ! ( value & mask ));
+                lock();
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+    catch(std::runtime_error& e)
+    {
+        status = -1;
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), e.what());
+    }
+
+    // If the function was not found, fall back to the base method. The parameters
+    // of a board which was removed or replaced can not be written. A failed write
+    // is not found, but it must not fall back, as it would report it as successful.
+    if ( ( ! found ) && ( 0 == status ) )
+        status = ( h.kind == HANDLER_DETACHED ) ? -1 : asynPortDriver::writeUInt32Digital(pasynUser, value, mask);
+
+    // Log status and return
+    if (0 == status)
+    {
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%d', mask '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), value, mask);
+
+        return asynSuccess;
+    }
+    else
+    {
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%d', mask '%d', status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), value, mask, status);
+
+        return asynError;
+    }
+}
+
+asynStatus CAENHVAsyn::readOctet(asynUser *pasynUser, char *value, size_t maxChars, size_t *nActual, int *eomReason)
+{
+    static std::string method("readOctet");
+    int function( getParamIndex(pasynUser) );
+    int status(0);
+
+    // Handler associated to the function number
+    const ParamHandler& h = handlers.get(function);
+
+    // Check if the function is found in out lists
+    bool found = false;
+
+    // Parameters updated by the poller are read from the parameter cache
+    try
+    {
+        if ( ( h.kind == HANDLER_SYSTEM_STRING ) && ( ! h.polled ) )
+        {
+            ISystemPropertyString* p = static_cast<ISystemPropertyString*>(h.object);
+            std::string temp;
+            ioRun(getReadPriority(h), h.slot, [&]() { temp = p->getVal(); });
+            strcpy(value, temp.c_str());
+            *nActual = temp.length() + 1;
+            found = true;
+        }
+    }
+    catch(std::runtime_error& e)
+    {
+        status = -1;
+        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), e.what());
+    }
+
+    // If the function was not found, fall back to the base method. A failed read
+    // is not found either, but it must keep its error so the record gets an alarm.
+    if ( ( ! found ) && ( 0 == status ) )
+        status = asynPortDriver::readOctet(pasynUser, value, maxChars, nActual, eomReason);
+
+    // Log status and return
+    if (0 == status)
+    {
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%s', maxChars '%zu', nActual '%zu'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), value, maxChars, *nActual);
+
+        return asynSuccess;
+    }
+    else
     {
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%d', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, status);
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, maxChars '%zu', status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), maxChars, status);
 
         return asynError;
     }
 }
 
-asynStatus CAENHVAsyn::readFloat64(asynUser *pasynUser, epicsFloat64 *value)
+asynStatus CAENHVAsyn::writeOctet(asynUser *pasynUser, const char *value, size_t maxChars, size_t *nActual)
 {
-    static std::string method("readFloat64");
-    int function(pasynUser->reason);
+    static std::string method("writeOctet");
+    int function( getParamIndex(pasynUser) );
     int status(0);
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
-
-    const char *name;
-    getParamName(addr, function, &name);
-
-    // Iterators
-    std::map< int, ChannelParameterNumeric >::iterator cpIt;
-    std::map< int, BoardParameterNumeric   >::iterator bpIt;
-    std::map< int, SystemPropertyFloat     >::iterator spIt;
+    // Handler associated to the function number
+    const ParamHandler& h = handlers.get(function);
 
     // Check if the function is found in out lists
     bool found = false;
 
-    // Look for the function number in the parameter lists
     try
     {
-        if ( ( cpIt = channelParameterNumericList.find(function) ) != channelParameterNumericList.end() )
-        {
-            *value = cpIt->second->getVal();
-            found = true;
-        }
-        else if ( ( bpIt = boardParameterNumericList.find(function) ) != boardParameterNumericList.end() )
+        if ( h.kind == HANDLER_SYSTEM_STRING )
         {
-            *value = bpIt->second->getVal();
-            found = true;
-        }
-        else if ( ( spIt = systemPropertyFloatList.find(function) ) != systemPropertyFloatList.end() )
-        {
-            *value = spIt->second->getVal();
             found = true;
+            ISystemPropertyString* p = static_cast<ISystemPropertyString*>(h.object);
+            std::string temp(value);
+            ioWrite(function, [p, temp]() { p->setVal(temp); });
+            *nActual = temp.size();
         }
     }
     catch(std::runtime_error& e)
@@ -595,467 +3993,763 @@ asynStatus CAENHVAsyn::readFloat64(asynUser *pasynUser, epicsFloat64 *value)
         status = -1;
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
                     "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), e.what());
     }
 
-    // If the function was not found, fall back to the base method
-    if (!found)
-        status = asynPortDriver::readFloat64(pasynUser, value);
+    // If the function was not found, fall back to the base method. The parameters
+    // of a board which was removed or replaced can not be written. A failed write
+    // is not found, but it must not fall back, as it would report it as successful.
+    if ( ( ! found ) && ( 0 == status ) )
+        status = ( h.kind == HANDLER_DETACHED ) ? -1 : asynPortDriver::writeOctet(pasynUser, value, maxChars, nActual);
 
     // Log status and return
     if (0 == status)
     {
         asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%f'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, *value);
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%s', maxChars '%zu', nActual '%zu'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), value, maxChars, *nActual);
 
         return asynSuccess;
     }
     else
     {
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, status);
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%s', maxChars '%zu', status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), value, maxChars, status);
 
         return asynError;
     }
 }
 
-asynStatus CAENHVAsyn::writeFloat64(asynUser *pasynUser, epicsFloat64 value)
+asynStatus CAENHVAsyn::readFloat64Array(asynUser *pasynUser, epicsFloat64 *value, size_t nElements, size_t *nIn)
 {
-    static std::string method("writeFloat64");
-    int function(pasynUser->reason);
+    static std::string method("readFloat64Array");
+    int function( getParamIndex(pasynUser) );
     int status(0);
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
-
-    const char *name;
-    getParamName(addr, function, &name);
-
-    // Iterators
-    std::map< int, ChannelParameterNumeric >::iterator cpIt;
-    std::map< int, BoardParameterNumeric   >::iterator bpIt;
-    std::map< int, SystemPropertyFloat     >::iterator spIt;
+    // Handler associated to the function number
+    const ParamHandler& h = handlers.get(function);
 
     // Check if the function is found in out lists
     bool found = false;
 
-    // Look for the function number in the parameter lists
-    try
+    if ( h.kind == HANDLER_FLOAT64_ARRAY )
     {
-        if ( ( cpIt = channelParameterNumericList.find(function) ) != channelParameterNumericList.end() )
-        {
-            cpIt->second->setVal(value);
-            found = true;
-        }
-        else if ( ( bpIt = boardParameterNumericList.find(function) ) != boardParameterNumericList.end() )
-        {
-            bpIt->second->setVal(value);
-            found = true;
-        }
-        else if ( ( spIt = systemPropertyFloatList.find(function) ) != systemPropertyFloatList.end() )
-        {
-            spIt->second->setVal(value);
-            found = true;
-        }
+        // The values are read from the array cache, updated by the poller
+        const std::vector<double>& values = static_cast<ArrayParam*>(h.object)->values;
+        *nIn = std::min(nElements, values.size());
+        for (std::size_t i(0); i < *nIn; ++i)
+            value[i] = values.at(i);
+        found = true;
     }
-    catch(std::runtime_error& e)
+    else if ( h.kind == HANDLER_HISTORY_VALUES )
+    {
+        // The newest samples which fit in the record, oldest first
+        *nIn  = static_cast<IHistoryBuffer*>(h.object)->copyValues(value, nElements);
+        found = true;
+    }
+    else if ( h.kind == HANDLER_HISTORY_TIMES )
+    {
+        *nIn  = static_cast<IHistoryBuffer*>(h.object)->copyTimes(value, nElements);
+        found = true;
+    }
+
+    // If the function was not found, fall back to the base method. A failed read
+    // is not found either, but it must keep its error so the record gets an alarm.
+    if ( ( ! found ) && ( 0 == status ) )
+        status = asynPortDriver::readFloat64Array(pasynUser, value, nElements, nIn);
+
+    // Log status and return
+    if (0 == status)
+    {
+        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%zu' elements, nElements '%zu'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), *nIn, nElements);
+
+        return asynSuccess;
+    }
+    else
     {
-        status = -1;
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, nElements '%zu', status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), nElements, status);
+
+        return asynError;
+    }
+}
+
+asynStatus CAENHVAsyn::readInt32Array(asynUser *pasynUser, epicsInt32 *value, size_t nElements, size_t *nIn)
+{
+    static std::string method("readInt32Array");
+    int function( getParamIndex(pasynUser) );
+    int status(0);
+
+    // Handler associated to the function number
+    const ParamHandler& h = handlers.get(function);
+
+    // Check if the function is found in out lists
+    bool found = false;
+
+    if ( h.kind == HANDLER_INT32_ARRAY )
+    {
+        // The values are read from the array cache, updated by the poller
+        const std::vector<double>& values = static_cast<ArrayParam*>(h.object)->values;
+        *nIn = std::min(nElements, values.size());
+        for (std::size_t i(0); i < *nIn; ++i)
+            value[i] = static_cast<epicsInt32>( static_cast<int64_t>( values.at(i) ) );
+        found = true;
     }
 
-    // If the function was not found, fall back to the base method
-    if (!found)
-        status = asynPortDriver::writeFloat64(pasynUser, value);
+    // If the function was not found, fall back to the base method. A failed read
+    // is not found either, but it must keep its error so the record gets an alarm.
+    if ( ( ! found ) && ( 0 == status ) )
+        status = asynPortDriver::readInt32Array(pasynUser, value, nElements, nIn);
 
     // Log status and return
     if (0 == status)
     {
         asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%f'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value);
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%zu' elements, nElements '%zu'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), *nIn, nElements);
 
         return asynSuccess;
     }
     else
     {
         asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%f', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, status);
+                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, nElements '%zu', status '%d'\n", \
+                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, reasonName(function), nElements, status);
+
+        return asynError;
+    }
+}
+
+////////////////////////////////////
+// Driver configuration functions //
+////////////////////////////////////
+
+// + CAENHVAsynConfig //
+extern "C" int CAENHVAsynConfig(const char* portName, int systemType, char* ipAddr, const char* userName, const char* password)
+{
+    new CAENHVAsyn(portName, systemType, ipAddr, userName, password);
+
+    return asynSuccess;
+}
+
+static const iocshArg confArg0 = { "portName",   iocshArgString };
+static const iocshArg confArg1 = { "systemType", iocshArgInt    };
+static const iocshArg confArg2 = { "ipAddr",     iocshArgString };
+static const iocshArg confArg3 = { "userName",   iocshArgString };
+static const iocshArg confArg4 = { "password",   iocshArgString };
+
+static const iocshArg * const confArgs[] =
+{
+    &confArg0,
+    &confArg1,
+    &confArg2,
+    &confArg3,
+    &confArg4
+};
+
+static const iocshFuncDef configFuncDef = {"CAENHVAsynConfig", 5, confArgs};
+
+static void configCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynConfig(args[0].sval, args[1].ival, args[2].sval, args[3].sval, args[4].sval);
+}
+// - CAENHVAsynConfig //
+
+// + CAENHVAsynSetEpicsPrefix //
+extern "C" int CAENHVAsynSetEpicsPrefix(const char *prefix)
+{
+    if ( ( ! prefix ) || ( prefix[0] == '\0' ) )
+        return 0;
+
+    CAENHVAsyn::epicsPrefix = prefix;
+
+    return 0;
+}
+
+static const iocshArg epicsPrefixArg0 = { "Prefix", iocshArgString };
+
+static const iocshArg * const epicsPrefixArgs[] =
+{
+    &epicsPrefixArg0
+};
+
+static const iocshFuncDef epicsPrefixFuncDef = { "CAENHVAsynSetEpicsPrefix", 1, epicsPrefixArgs };
+
+static void epicsPrefixCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetEpicsPrefix(args[0].sval);
+}
+// - CAENHVAsynSetEpicsPrefix //
+
+// + CAENHVAsynSetPollPeriod //
+extern "C" int CAENHVAsynSetPollPeriod(double period)
+{
+    if ( period < 0 )
+    {
+        std::cerr << "CAENHVAsynSetPollPeriod: the period must be a positive number, or zero to disable the poller" << std::endl;
+        return -1;
+    }
+
+    CAENHVAsyn::pollPeriod = period;
+
+    return 0;
+}
+
+static const iocshArg pollPeriodArg0 = { "Period", iocshArgDouble };
+
+static const iocshArg * const pollPeriodArgs[] =
+{
+    &pollPeriodArg0
+};
+
+static const iocshFuncDef pollPeriodFuncDef = { "CAENHVAsynSetPollPeriod", 1, pollPeriodArgs };
+
+static void pollPeriodCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetPollPeriod(args[0].dval);
+}
+// - CAENHVAsynSetPollPeriod //
+
+// + CAENHVAsynLoadScanClasses //
+extern "C" int CAENHVAsynLoadScanClasses(const char *fileName)
+{
+    if ( ( ! fileName ) || ( fileName[0] == '\0' ) )
+    {
+        std::cerr << "CAENHVAsynLoadScanClasses: the file name must be defined" << std::endl;
+        return -1;
+    }
+
+    try
+    {
+        CAENHVAsyn::scanClasses = IScanClassList::create(fileName);
+    }
+    catch(std::runtime_error& e)
+    {
+        std::cerr << "CAENHVAsynLoadScanClasses: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+static const iocshArg scanClassesArg0 = { "FileName", iocshArgString };
+
+static const iocshArg * const scanClassesArgs[] =
+{
+    &scanClassesArg0
+};
+
+static const iocshFuncDef scanClassesFuncDef = { "CAENHVAsynLoadScanClasses", 1, scanClassesArgs };
+
+static void scanClassesCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynLoadScanClasses(args[0].sval);
+}
+// - CAENHVAsynLoadScanClasses //
+
+// + CAENHVAsynSetDeadband //
+extern "C" int CAENHVAsynSetDeadband(const char *pattern, double absolute, double relative)
+{
+    if ( ( ! pattern ) || ( pattern[0] == '\0' ) )
+    {
+        std::cerr << "CAENHVAsynSetDeadband: the parameter name pattern must be defined" << std::endl;
+        return -1;
+    }
+
+    if ( ( absolute < 0 ) || ( relative < 0 ) )
+    {
+        std::cerr << "CAENHVAsynSetDeadband: the deadbands must be positive numbers, or zero" << std::endl;
+        return -1;
+    }
+
+    DeadbandRule r;
+    r.pattern  = pattern;
+    r.absolute = absolute;
+    r.relative = relative;
+    CAENHVAsyn::deadbands.push_back(r);
+
+    return 0;
+}
+
+static const iocshArg deadbandArg0 = { "Pattern",  iocshArgString };
+static const iocshArg deadbandArg1 = { "Absolute", iocshArgDouble };
+static const iocshArg deadbandArg2 = { "Relative", iocshArgDouble };
+
+static const iocshArg * const deadbandArgs[] =
+{
+    &deadbandArg0,
+    &deadbandArg1,
+    &deadbandArg2
+};
+
+static const iocshFuncDef deadbandFuncDef = { "CAENHVAsynSetDeadband", 3, deadbandArgs };
+
+static void deadbandCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetDeadband(args[0].sval, args[1].dval, args[2].dval);
+}
+// - CAENHVAsynSetDeadband //
+
+// + CAENHVAsynSetHistory //
+extern "C" int CAENHVAsynSetHistory(const char *pattern, int capacity, int decimation)
+{
+    if ( ( ! pattern ) || ( pattern[0] == '\0' ) )
+    {
+        std::cerr << "CAENHVAsynSetHistory: the parameter name pattern must be defined" << std::endl;
+        return -1;
+    }
+
+    if ( capacity <= 0 )
+    {
+        std::cerr << "CAENHVAsynSetHistory: the number of samples must be a positive number" << std::endl;
+        return -1;
+    }
+
+    if ( decimation <= 0 )
+    {
+        std::cerr << "CAENHVAsynSetHistory: the decimation must be a positive number" << std::endl;
+        return -1;
+    }
+
+    HistoryRule r;
+    r.pattern    = pattern;
+    r.capacity   = capacity;
+    r.decimation = decimation;
+    CAENHVAsyn::histories.push_back(r);
+
+    return 0;
+}
+
+static const iocshArg historyArg0 = { "Pattern",    iocshArgString };
+static const iocshArg historyArg1 = { "Samples",    iocshArgInt    };
+static const iocshArg historyArg2 = { "Decimation", iocshArgInt    };
+
+static const iocshArg * const historyArgs[] =
+{
+    &historyArg0,
+    &historyArg1,
+    &historyArg2
+};
+
+static const iocshFuncDef historyFuncDef = { "CAENHVAsynSetHistory", 3, historyArgs };
+
+static void historyCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetHistory(args[0].sval, args[1].ival, args[2].ival);
+}
+// - CAENHVAsynSetHistory //
+
+// + CAENHVAsynSetPostMortem //
+extern "C" int CAENHVAsynSetPostMortem(const char *path, double pre, double post, int crateWide)
+{
+    if ( ( pre < 0 ) || ( post < 0 ) || ( pre + post <= 0 ) )
+    {
+        std::cerr << "CAENHVAsynSetPostMortem: the windows must be positive numbers, or zero, and at least one of them must be larger than zero" << std::endl;
+        return -1;
+    }
+
+    PostMortemConfig c;
+    c.enabled   = true;
+    c.path      = path ? path : "";
+    c.pre       = pre;
+    c.post      = post;
+    c.crateWide = ( crateWide != 0 );
+    CAENHVAsyn::postMortemConfig = c;
+
+    return 0;
+}
+
+static const iocshArg postMortemArg0 = { "Path",      iocshArgString };
+static const iocshArg postMortemArg1 = { "Pre",       iocshArgDouble };
+static const iocshArg postMortemArg2 = { "Post",      iocshArgDouble };
+static const iocshArg postMortemArg3 = { "CrateWide", iocshArgInt    };
+
+static const iocshArg * const postMortemArgs[] =
+{
+    &postMortemArg0,
+    &postMortemArg1,
+    &postMortemArg2,
+    &postMortemArg3
+};
+
+static const iocshFuncDef postMortemFuncDef = { "CAENHVAsynSetPostMortem", 4, postMortemArgs };
+
+static void postMortemCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetPostMortem(args[0].sval, args[1].dval, args[2].dval, args[3].ival);
+}
+// - CAENHVAsynSetPostMortem //
+
+// + CAENHVAsynSetWriteWindow //
+extern "C" int CAENHVAsynSetWriteWindow(double window)
+{
+    if ( window < 0 )
+    {
+        std::cerr << "CAENHVAsynSetWriteWindow: the window must be a positive number, or zero to disable the write queue" << std::endl;
+        return -1;
+    }
+
+    CAENHVAsyn::writeWindow = window;
+
+    return 0;
+}
+
+static const iocshArg writeWindowArg0 = { "Window", iocshArgDouble };
+
+static const iocshArg * const writeWindowArgs[] =
+{
+    &writeWindowArg0
+};
 
-        return asynError;
-    }
+static const iocshFuncDef writeWindowFuncDef = { "CAENHVAsynSetWriteWindow", 1, writeWindowArgs };
+
+static void writeWindowCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetWriteWindow(args[0].dval);
 }
+// - CAENHVAsynSetWriteWindow //
 
-asynStatus CAENHVAsyn::readUInt32Digital(asynUser *pasynUser, epicsUInt32 *value, epicsUInt32 mask)
+// + CAENHVAsynSetAsyncWrites //
+extern "C" int CAENHVAsynSetAsyncWrites(int enable)
 {
-    static std::string method("readUInt32Digital");
-    int function(pasynUser->reason);
-    int status(0);
+    CAENHVAsyn::asyncWrites = enable;
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
+    return 0;
+}
 
-    const char *name;
-    getParamName(addr, function, &name);
+static const iocshArg asyncWritesArg0 = { "Enable", iocshArgInt };
 
-    // Iterators
-    std::map< int, BoardParameterOnOff      >::iterator bpoIt;
-    std::map< int, BoardParameterChStatus   >::iterator bpcsIt;
-    std::map< int, BoardParameterBdStatus   >::iterator bpbsIt;
-    std::map< int, ChannelParameterOnOff    >::iterator cpoIt;
-    std::map< int, ChannelParameterChStatus >::iterator cpcsIt;
+static const iocshArg * const asyncWritesArgs[] =
+{
+    &asyncWritesArg0
+};
 
-    // Check if the function is found in out lists
-    bool found = false;
+static const iocshFuncDef asyncWritesFuncDef = { "CAENHVAsynSetAsyncWrites", 1, asyncWritesArgs };
 
-    // Look for the function number in the parameter lists
-    try
-    {
-        if ( ( bpoIt = boardParameterOnOffList.find(function) ) != boardParameterOnOffList.end() )
-        {
-           uint32_t temp = bpoIt->second->getVal();
-           temp &= mask;
-           *value = temp;
-           found = true;
-        }
-        else if ( ( bpcsIt = boardParameterChStatusList.find(function) ) != boardParameterChStatusList.end() )
-        {
-           uint32_t temp = bpcsIt->second->getVal();
-           temp &= mask;
-           *value = temp;
-           found = true;
-        }
-        else if ( ( bpbsIt = boardParameterBdStatusList.find(function) ) != boardParameterBdStatusList.end() )
-        {
-           uint32_t temp = bpbsIt->second->getVal();
-           temp &= mask;
-           *value = temp;
-           found = true;
-        }
-        else if ( ( cpoIt = channelParameterOnOffList.find(function) ) != channelParameterOnOffList.end() )
-        {
-           uint32_t temp = cpoIt->second->getVal();
-           temp &= mask;
-           *value = temp;
-           found = true;
-        }
-        else if ( ( cpcsIt = channelParameterChStatusList.find(function) ) != channelParameterChStatusList.end() )
-        {
-           uint32_t temp = cpcsIt->second->getVal();
-           temp &= mask;
-           *value = temp;
-           found = true;
-        }
-    }
-    catch(std::runtime_error& e)
+static void asyncWritesCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetAsyncWrites(args[0].ival);
+}
+// - CAENHVAsynSetAsyncWrites //
+
+// + CAENHVAsynSetEventMode //
+extern "C" int CAENHVAsynSetEventMode(int enable, int port)
+{
+    if ( enable && ( ( port <= 0 ) || ( port > 65535 ) ) )
     {
-        status = -1;
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+        std::cerr << "CAENHVAsynSetEventMode: invalid port number " << port << std::endl;
+        return -1;
     }
 
-    // If the function was not found, fall back to the base method
-    if (!found)
-        status = asynPortDriver::readUInt32Digital(pasynUser, value, mask);
+    CAENHVAsyn::eventMode = enable;
+    CAENHVAsyn::eventPort = port;
 
-    // Log status and return
-    if (0 == status)
-    {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%d', mask '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, *value, mask);
+    return 0;
+}
 
-        return asynSuccess;
-    }
-    else
-    {
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, mask '%d', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, mask, status);
+static const iocshArg eventModeArg0 = { "Enable", iocshArgInt };
+static const iocshArg eventModeArg1 = { "Port",   iocshArgInt };
 
-        return asynError;
-    }
-}
+static const iocshArg * const eventModeArgs[] =
+{
+    &eventModeArg0,
+    &eventModeArg1
+};
 
+static const iocshFuncDef eventModeFuncDef = { "CAENHVAsynSetEventMode", 2, eventModeArgs };
 
-asynStatus CAENHVAsyn::writeUInt32Digital(asynUser *pasynUser, epicsUInt32 value, epicsUInt32 mask)
+static void eventModeCallFunc(const iocshArgBuf *args)
 {
-    static std::string method("writeUInt32Digital");
-    int function(pasynUser->reason);
-    int status(0);
+    CAENHVAsynSetEventMode(args[0].ival, args[1].ival);
+}
+// - CAENHVAsynSetEventMode //
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
+// + CAENHVAsynSetReconnect //
+extern "C" int CAENHVAsynSetReconnect(int maxFailures, double retryMin, double retryMax)
+{
+    if ( ( maxFailures < 0 ) || ( retryMin <= 0 ) || ( retryMax < retryMin ) )
+    {
+        std::cerr << "CAENHVAsynSetReconnect: the number of failures can not be negative, and the retry delays must be positive, with MaxRetry >= MinRetry" << std::endl;
+        return -1;
+    }
 
-    const char *name;
-    getParamName(addr, function, &name);
+    CAENHVAsyn::linkConfig.maxFailures = maxFailures;
+    CAENHVAsyn::linkConfig.retryMin    = retryMin;
+    CAENHVAsyn::linkConfig.retryMax    = retryMax;
 
-    epicsUInt32 val(0);
-    val &= ~mask;
-    val |= value;
+    return 0;
+}
 
-    // Iterators
-    std::map< int, BoardParameterOnOff      >::iterator bpoIt;
-    std::map< int, BoardParameterChStatus   >::iterator bpcsIt;
-    std::map< int, BoardParameterBdStatus   >::iterator bpbsIt;
-    std::map< int, ChannelParameterOnOff    >::iterator cpoIt;
-    std::map< int, ChannelParameterChStatus >::iterator cpcsIt;
+static const iocshArg reconnectArg0 = { "MaxFailures", iocshArgInt    };
+static const iocshArg reconnectArg1 = { "MinRetry",    iocshArgDouble };
+static const iocshArg reconnectArg2 = { "MaxRetry",    iocshArgDouble };
 
-    // Check if the function is found in out lists
-    bool found = false;
+static const iocshArg * const reconnectArgs[] =
+{
+    &reconnectArg0,
+    &reconnectArg1,
+    &reconnectArg2
+};
 
-    // Look for the function number in the parameter lists
-    try
-    {
-        if ( ( bpoIt = boardParameterOnOffList.find(function) ) != boardParameterOnOffList.end() )
-        {
-            bpoIt->second->setVal(val);
-            found = true;
-        }
-        else if ( ( bpcsIt = boardParameterChStatusList.find(function) ) != boardParameterChStatusList.end() )
-        {
-            bpcsIt->second->setVal(val);
-            found = true;
-        }
-        else if ( ( bpbsIt = boardParameterBdStatusList.find(function) ) != boardParameterBdStatusList.end() )
-        {
-            bpbsIt->second->setVal(val);
-            found = true;
-        }
-        else if ( ( cpoIt = channelParameterOnOffList.find(function) ) != channelParameterOnOffList.end() )
-        {
-            cpoIt->second->setVal(val);
-            found = true;
-        }
-        else if ( ( cpcsIt = channelParameterChStatusList.find(function) ) != channelParameterChStatusList.end() )
-        {
-            cpcsIt->second->setVal(val);
-            found = true;
-        }
-    }
-    catch(std::runtime_error& e)
+static const iocshFuncDef reconnectFuncDef = { "CAENHVAsynSetReconnect", 3, reconnectArgs };
+
+static void reconnectCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetReconnect(args[0].ival, args[1].dval, args[2].dval);
+}
+// - CAENHVAsynSetReconnect //
+
+// + CAENHVAsynSetSlotBreaker //
+extern "C" int CAENHVAsynSetSlotBreaker(int maxSlowJobs, double slowJob, double holdOff)
+{
+    if ( ( maxSlowJobs < 0 ) || ( slowJob <= 0 ) || ( holdOff <= 0 ) )
     {
-        status = -1;
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+        std::cerr << "CAENHVAsynSetSlotBreaker: the number of slow jobs can not be negative, and the times must be positive" << std::endl;
+        return -1;
     }
 
-    // If the function was not found, fall back to the base method
-    if (!found)
-        status = asynPortDriver::writeUInt32Digital(pasynUser, value, mask);
+    CAENHVAsyn::slotBreakerConfig.maxSlowJobs = maxSlowJobs;
+    CAENHVAsyn::slotBreakerConfig.slowJob     = slowJob;
+    CAENHVAsyn::slotBreakerConfig.holdOff     = holdOff;
 
-    // Log status and return
-    if (0 == status)
-    {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%d', mask '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, mask);
+    return 0;
+}
 
-        return asynSuccess;
-    }
-    else
-    {
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%d', mask '%d', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, mask, status);
+static const iocshArg slotBreakerArg0 = { "MaxSlowJobs", iocshArgInt    };
+static const iocshArg slotBreakerArg1 = { "SlowJob",     iocshArgDouble };
+static const iocshArg slotBreakerArg2 = { "HoldOff",     iocshArgDouble };
 
-        return asynError;
-    }
+static const iocshArg * const slotBreakerArgs[] =
+{
+    &slotBreakerArg0,
+    &slotBreakerArg1,
+    &slotBreakerArg2
+};
+
+static const iocshFuncDef slotBreakerFuncDef = { "CAENHVAsynSetSlotBreaker", 3, slotBreakerArgs };
+
+static void slotBreakerCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetSlotBreaker(args[0].ival, args[1].dval, args[2].dval);
 }
+// - CAENHVAsynSetSlotBreaker //
 
-asynStatus CAENHVAsyn::readOctet(asynUser *pasynUser, char *value, size_t maxChars, size_t *nActual, int *eomReason)
+// + CAENHVAsynSetHotPlugPeriod //
+extern "C" int CAENHVAsynSetHotPlugPeriod(double period)
 {
-    static std::string method("readOctet");
-    int function(pasynUser->reason);
-    int status(0);
+    if ( period < 0 )
+    {
+        std::cerr << "CAENHVAsynSetHotPlugPeriod: the period must be a positive number, or zero to disable the hot-plug check" << std::endl;
+        return -1;
+    }
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
+    CAENHVAsyn::hotPlugPeriod = period;
 
-    const char *name;
-    getParamName(addr, function, &name);
+    return 0;
+}
 
-    // Iterators
-    std::map< int, SystemPropertyString >::iterator spIt;
+static const iocshArg hotPlugPeriodArg0 = { "Period", iocshArgDouble };
 
-    // Check if the function is found in out lists
-    bool found = false;
+static const iocshArg * const hotPlugPeriodArgs[] =
+{
+    &hotPlugPeriodArg0
+};
 
-    // Look for the function number in the parameter lists
-    try
-    {
-        if ( ( spIt = systemPropertyStringList.find(function) ) != systemPropertyStringList.end() )
-        {
-            std::string temp = spIt->second->getVal();
-            strcpy(value, temp.c_str());
-            *nActual = temp.length() + 1;
-            found = true;
-        }
-    }
-    catch(std::runtime_error& e)
+static const iocshFuncDef hotPlugPeriodFuncDef = { "CAENHVAsynSetHotPlugPeriod", 1, hotPlugPeriodArgs };
+
+static void hotPlugPeriodCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetHotPlugPeriod(args[0].dval);
+}
+// - CAENHVAsynSetHotPlugPeriod //
+
+// + CAENHVAsynSetDiscoveryWorkers //
+extern "C" int CAENHVAsynSetDiscoveryWorkers(int slotWorkers, int channelWorkers)
+{
+    if ( ( slotWorkers < 1 ) || ( channelWorkers < 1 ) )
     {
-        status = -1;
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+        std::cerr << "CAENHVAsynSetDiscoveryWorkers: the number of workers must be at least 1" << std::endl;
+        return -1;
     }
 
-    // If the function was not found, fall back to the base method
-    if (!found)
-        status = asynPortDriver::readOctet(pasynUser, value, maxChars, nActual, eomReason);
+    CAENHVAsyn::discoverySlotWorkers    = slotWorkers;
+    CAENHVAsyn::discoveryChannelWorkers = channelWorkers;
 
-    // Log status and return
-    if (0 == status)
-    {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : read '%s', maxChars '%zu', nActual '%zu'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, maxChars, *nActual);
+    return 0;
+}
 
-        return asynSuccess;
-    }
-    else
-    {
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while reading, maxChars '%zu', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, maxChars, status);
+static const iocshArg discoveryWorkersArg0 = { "SlotWorkers",    iocshArgInt };
+static const iocshArg discoveryWorkersArg1 = { "ChannelWorkers", iocshArgInt };
 
-        return asynError;
-    }
+static const iocshArg * const discoveryWorkersArgs[] =
+{
+    &discoveryWorkersArg0,
+    &discoveryWorkersArg1
+};
+
+static const iocshFuncDef discoveryWorkersFuncDef = { "CAENHVAsynSetDiscoveryWorkers", 2, discoveryWorkersArgs };
+
+static void discoveryWorkersCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetDiscoveryWorkers(args[0].ival, args[1].ival);
 }
+// - CAENHVAsynSetDiscoveryWorkers //
 
-asynStatus CAENHVAsyn::writeOctet(asynUser *pasynUser, const char *value, size_t maxChars, size_t *nActual)
+// + CAENHVAsynSetDiscoveryCache //
+extern "C" int CAENHVAsynSetDiscoveryCache(const char* path)
 {
-    static std::string method("writeOctet");
-    int function(pasynUser->reason);
-    int status(0);
+    if ( ( ! path ) || ( path[0] == '\0' ) )
+    {
+        CAENHVAsyn::discoveryCachePath.clear();
+        return 0;
+    }
 
-    int addr;
-    this->getAddress(pasynUser, &addr);
+    CAENHVAsyn::discoveryCachePath = path;
 
-    const char *name;
-    getParamName(addr, function, &name);
+    // The path is a directory
+    if ( *CAENHVAsyn::discoveryCachePath.rbegin() != '/' )
+        CAENHVAsyn::discoveryCachePath += "/";
 
-    // Iterators
-    std::map< int, SystemPropertyString >::iterator spIt;
+    return 0;
+}
 
-    // Check if the function is found in out lists
-    bool found = false;
+static const iocshArg discoveryCacheArg0 = { "Path", iocshArgString };
 
-    // Look for the function number in the parameter lists
-    try
+static const iocshArg * const discoveryCacheArgs[] =
+{
+    &discoveryCacheArg0
+};
+
+static const iocshFuncDef discoveryCacheFuncDef = { "CAENHVAsynSetDiscoveryCache", 1, discoveryCacheArgs };
+
+static void discoveryCacheCallFunc(const iocshArgBuf *args)
+{
+    CAENHVAsynSetDiscoveryCache(args[0].sval);
+}
+// - CAENHVAsynSetDiscoveryCache //
+
+// + CAENHVAsynPrintCrateInfo //
+extern "C" int CAENHVAsynPrintCrateInfo(const char* portName, const char* format, const char* fileName)
+{
+    if ( ( ! portName ) || ( portName[0] == '\0' ) )
     {
-        if ( ( spIt = systemPropertyStringList.find(function) ) != systemPropertyStringList.end() )
-        {
-            found = true;
-            std::string temp(value);
-            spIt->second->setVal(temp);
-            *nActual = temp.size();
-        }
+        std::cerr << "CAENHVAsynPrintCrateInfo: the port name must be defined" << std::endl;
+        return 1;
     }
-    catch(std::runtime_error& e)
+
+    CAENHVAsyn* driver( CAENHVAsyn::findDriver(portName) );
+
+    if ( ! driver )
     {
-        status = -1;
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : exception caught '%s'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, e.what());
+        std::cerr << "CAENHVAsynPrintCrateInfo: port '" << portName << "' not found" << std::endl;
+        return 1;
     }
 
-    // If the function was not found, fall back to the base method
-    if (!found)
-        status = asynPortDriver::writeOctet(pasynUser, value, maxChars, nActual);
-
-    // Log status and return
-    if (0 == status)
+    // The default format is text
+    bool json( false );
+    if ( ( format ) && ( format[0] != '\0' ) )
     {
-        asynPrint(pasynUser, ASYN_TRACEIO_DRIVER, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : set to '%s', maxChars '%zu', nActual '%zu'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, maxChars, *nActual);
+        std::string f(format);
 
-        return asynSuccess;
+        if ( ! f.compare("json") )
+            json = true;
+        else if ( f.compare("text") )
+        {
+            std::cerr << "CAENHVAsynPrintCrateInfo: invalid format '" << f << "'. Valid formats are 'text' and 'json'" << std::endl;
+            return 1;
+        }
     }
-    else
-    {
-        asynPrint(pasynUser, ASYN_TRACE_ERROR, \
-                    "Driver '%s', Port '%s', Method '%s', Function number '%d', parameter '%s' : Error while writting '%s', maxChars '%zu', status '%d'\n", \
-                    this->driverName_.c_str(), this->portName_.c_str(), method.c_str(), function, name, value, maxChars, status);
 
-        return asynError;
+    // Without a file name, the information is printed on the IOC shell
+    if ( ( ! fileName ) || ( fileName[0] == '\0' ) )
+    {
+        driver->writeCrateInfo(std::cout, json);
+        return 0;
     }
-}
 
-////////////////////////////////////
-// Driver configuration functions //
-////////////////////////////////////
+    std::ofstream file(fileName);
 
-// + CAENHVAsynConfig //
-extern "C" int CAENHVAsynConfig(const char* portName, int systemType, char* ipAddr, const char* userName, const char* password)
-{
-    new CAENHVAsyn(portName, systemType, ipAddr, userName, password);
+    if ( ! file.is_open() )
+    {
+        std::cerr << "CAENHVAsynPrintCrateInfo: could not open file '" << fileName << "'" << std::endl;
+        return 1;
+    }
 
-    return asynSuccess;
+    driver->writeCrateInfo(file, json);
+
+    return 0;
 }
 
-static const iocshArg confArg0 = { "portName",   iocshArgString };
-static const iocshArg confArg1 = { "systemType", iocshArgInt    };
-static const iocshArg confArg2 = { "ipAddr",     iocshArgString };
-static const iocshArg confArg3 = { "userName",   iocshArgString };
-static const iocshArg confArg4 = { "password",   iocshArgString };
+static const iocshArg crateInfoArg0 = { "PortName", iocshArgString };
+static const iocshArg crateInfoArg1 = { "Format",   iocshArgString };
+static const iocshArg crateInfoArg2 = { "FileName", iocshArgString };
 
-static const iocshArg * const confArgs[] =
+static const iocshArg * const crateInfoArgs[] =
 {
-    &confArg0,
-    &confArg1,
-    &confArg2,
-    &confArg3,
-    &confArg4
+    &crateInfoArg0,
+    &crateInfoArg1,
+    &crateInfoArg2
 };
 
-static const iocshFuncDef configFuncDef = {"CAENHVAsynConfig", 5, confArgs};
+static const iocshFuncDef crateInfoFuncDef = { "CAENHVAsynPrintCrateInfo", 3, crateInfoArgs };
 
-static void configCallFunc(const iocshArgBuf *args)
+static void crateInfoCallFunc(const iocshArgBuf *args)
 {
-    CAENHVAsynConfig(args[0].sval, args[1].ival, args[2].sval, args[3].sval, args[4].sval);
+    CAENHVAsynPrintCrateInfo(args[0].sval, args[1].sval, args[2].sval);
 }
-// - CAENHVAsynConfig //
+// - CAENHVAsynPrintCrateInfo //
 
-// + CAENHVAsynSetEpicsPrefix //
-extern "C" int CAENHVAsynSetEpicsPrefix(const char *prefix)
+// + CAENHVAsynPrintWireStats //
+extern "C" int CAENHVAsynPrintWireStats(int level, int reset)
 {
-    if ( ( ! prefix ) || ( prefix[0] == '\0' ) )
-        return 0;
-
-    CAENHVAsyn::epicsPrefix = prefix;
+    CAENHVAsyn::printWireStats(std::cout, level, reset);
 
     return 0;
 }
 
-static const iocshArg epicsPrefixArg0 = { "Prefix", iocshArgString };
+static const iocshArg wireStatsArg0 = { "Level", iocshArgInt };
+static const iocshArg wireStatsArg1 = { "Reset", iocshArgInt };
 
-static const iocshArg * const epicsPrefixArgs[] =
+static const iocshArg * const wireStatsArgs[] =
 {
-    &epicsPrefixArg0
+    &wireStatsArg0,
+    &wireStatsArg1
 };
 
-static const iocshFuncDef epicsPrefixFuncDef = { "CAENHVAsynSetEpicsPrefix", 1, epicsPrefixArgs };
+static const iocshFuncDef wireStatsFuncDef = { "CAENHVAsynPrintWireStats", 2, wireStatsArgs };
 
-static void epicsPrefixCallFunc(const iocshArgBuf *args)
+static void wireStatsCallFunc(const iocshArgBuf *args)
 {
-    CAENHVAsynSetEpicsPrefix(args[0].sval);
+    CAENHVAsynPrintWireStats(args[0].ival, args[1].ival);
 }
-// - CAENHVAsynSetEpicsPrefix //
+// - CAENHVAsynPrintWireStats //
 
 // iocshRegister
 void drvCAENHVAsynRegister(void)
 {
     iocshRegister( &configFuncDef,      configCallFunc      );
     iocshRegister( &epicsPrefixFuncDef, epicsPrefixCallFunc );
+    iocshRegister( &pollPeriodFuncDef,  pollPeriodCallFunc  );
+    iocshRegister( &scanClassesFuncDef, scanClassesCallFunc );
+    iocshRegister( &deadbandFuncDef,    deadbandCallFunc    );
+    iocshRegister( &historyFuncDef,     historyCallFunc     );
+    iocshRegister( &postMortemFuncDef,  postMortemCallFunc  );
+    iocshRegister( &writeWindowFuncDef, writeWindowCallFunc );
+    iocshRegister( &asyncWritesFuncDef, asyncWritesCallFunc );
+    iocshRegister( &eventModeFuncDef,   eventModeCallFunc   );
+    iocshRegister( &reconnectFuncDef,   reconnectCallFunc   );
+    iocshRegister( &slotBreakerFuncDef, slotBreakerCallFunc );
+    iocshRegister( &hotPlugPeriodFuncDef,    hotPlugPeriodCallFunc    );
+    iocshRegister( &discoveryWorkersFuncDef, discoveryWorkersCallFunc );
+    iocshRegister( &discoveryCacheFuncDef,   discoveryCacheCallFunc   );
+    iocshRegister( &crateInfoFuncDef,        crateInfoCallFunc        );
+    iocshRegister( &wireStatsFuncDef,        wireStatsCallFunc        );
+
+    initHookRegister( infoInitHook );
 }
 
 extern "C"
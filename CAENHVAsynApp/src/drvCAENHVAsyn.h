@@ -30,10 +30,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include <map>
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include <tuple>
 #include <utility>
 #include <iostream>
 #include <fstream>
+#include <chrono>
+#include <atomic>
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
 #include <arpa/inet.h>
@@ -44,6 +51,7 @@
 #include <epicsTimer.h>
 #include <epicsMutex.h>
 #include <epicsEvent.h>
+#include <initHooks.h>
 #include <iocsh.h>
 #include <dbAccess.h>
 #include <dbStaticLib.h>
@@ -53,9 +61,34 @@
 #include "CAENHVWrapper.h"
 #include "common.h"
 #include "crate.h"
+#include "parameter_group.h"
+#include "subscription.h"
+#include "scan_class.h"
+#include "write_queue.h"
+#include "io_worker.h"
+#include "param_handler.h"
+#include "record_file.h"
+#include "history_buffer.h"
+#include "post_mortem.h"
 
-#define MAX_SIGNALS (3)
-#define NUM_PARAMS (1500)
+// Number of diagnostic asyn parameters for each type of call to the CAEN HV Wrapper library
+#define NUM_WIRE_DIAG_PARAMS (6)
+
+// Number of diagnostic asyn parameters for each scan class, and for the poller
+#define NUM_SCAN_DIAG_PARAMS (5)
+#define NUM_POLL_DIAG_PARAMS (2)
+
+// Number of diagnostic asyn parameters for each priority of the I/O worker
+#define NUM_IO_DIAG_PARAMS (5)
+
+// Number of diagnostic asyn parameters of the port lock
+#define NUM_LOCK_DIAG_PARAMS (3)
+
+// Number of diagnostic asyn parameters of the crate link
+#define NUM_LINK_DIAG_PARAMS (5)
+
+// Number of asyn parameters of the post-mortem capture, besides the traces of each parameter with a history
+#define NUM_PM_PARAMS (6)
 
 // Map used to generated binary records for system parameters of type 'PARAM_TYPE_CHSTATUS'.
 // There will be a bi and or bo record for each bit status.
@@ -111,12 +144,181 @@ statusRecordMap_t recordFieldBdParamBdStatus =
     { 0x020, std::pair<std::string,std::string>( "_OT",   "Bd is in over-temperature status"   ) },
 };
 
+// Poller entry. It contains a parameter group, which is read from the crate with a
+// single call, the asyn parameter index associated to each member of the group, and
+// the scan class which defines how often the group is read.
+// Channel parameter groups also have an array parameter, containing the values
+// of all the channels in the group. Other groups have no array parameter (-1).
+// When the event mode is enabled, the groups whose members are all updated by
+// events pushed by the crate are marked as subscribed, and are not polled.
+// The priority is used to queue the reads of the group on the I/O worker.
+// Channel parameter groups matching a history rule also have a history parameter,
+// with the last samples of all the channels in the group. Other groups have none (-1).
+template <typename T>
+struct PollEntry
+{
+    T                group;
+    std::vector<int> indexes;
+    int              arrayIndex;
+    int              historyIndex;
+    std::size_t      scanClass;
+    bool             subscribed;
+    ioPriority_t     priority;
+};
+
+// Array parameter. It contains the last values read from all the channels
+// of a channel parameter group, which are published as a float64 or an int32 array.
+struct ArrayParam
+{
+    bool                isFloat;
+    std::vector<double> values;
+};
+
+// History parameter. It contains the history buffer of a channel parameter group, which
+// is published as a float64 array with the values, and another with the time of each sample.
+struct HistoryParam
+{
+    HistoryBuffer buffer;
+    int           timesIndex;
+};
+
+// History kept for a set of channel parameters, selected by their names:
+// the number of samples, and the decimation of the samples read by the poller.
+struct HistoryRule
+{
+    std::string pattern;
+    std::size_t capacity;
+    std::size_t decimation;
+};
+
+// Deadband applied to a set of parameters, selected by their names.
+// A new value is published only if its difference with the last published value
+// is larger than the absolute deadband, and larger than the relative deadband
+// times the last published value. A deadband of zero is not applied.
+struct DeadbandRule
+{
+    std::string pattern;
+    double      absolute;
+    double      relative;
+};
+
+// Last value published for an asyn parameter, and its deadband
+struct PublishedValue
+{
+    bool        valid;
+    double      value;
+    std::string text;
+    double      absolute;
+    double      relative;
+};
+
+// Type of value carried by a parameter change event
+enum eventValueType_t
+{
+    EVENT_VALUE_FLOAT,
+    EVENT_VALUE_UINT,
+    EVENT_VALUE_INT
+};
+
+// Asyn parameter updated by a parameter change event, and position of the
+// value in the associated array parameter (-1 if there is none)
+struct EventTarget
+{
+    int              index;
+    eventValueType_t type;
+    int              arrayIndex;
+    std::size_t      arrayPos;
+};
+
+// Diagnostic asyn parameters of a type of call to the CAEN HV Wrapper library
+struct WireDiagParams
+{
+    int count;
+    int errors;
+    int mean;
+    int p50;
+    int p99;
+    int max;
+};
+
+// Sweep statistics of a scan class, updated by the poller, and their diagnostic
+// asyn parameters. A sweep reads all the parameter groups of the scan class once.
+// An overrun is a sweep which takes longer than the scan class period.
+struct ScanClassDiag
+{
+    uint64_t sweeps;
+    uint64_t overruns;
+    double   total;
+    double   max;
+
+    int sweepsParam;
+    int overrunsParam;
+    int lastParam;
+    int maxParam;
+    int meanParam;
+};
+
+// Diagnostic asyn parameters of a priority of the I/O worker
+struct IoDiagParams
+{
+    int jobs;
+    int pending;
+    int meanWait;
+    int maxWait;
+    int rejected;
+};
+
+// Hold time statistics of the port lock, and their diagnostic asyn parameters.
+// Only the outermost lock of each thread is measured. The statistics are only
+// modified by the thread holding the lock.
+struct LockDiag
+{
+    int                                   depth;
+    std::chrono::steady_clock::time_point start;
+    uint64_t                              count;
+    double                                total;
+    double                                max;
+
+    int countParam;
+    int meanParam;
+    int maxParam;
+};
+
+// Diagnostic asyn parameters of the crate link
+struct LinkDiagParams
+{
+    int state;
+    int disconnections;
+    int reconnections;
+    int attempts;
+    int rejected;
+};
+
+// Asyn parameters of the post-mortem capture: number of captures and of trips, slot, channel,
+// status bits, and time of the trip which triggered the last capture, and the traces of the
+// tripped channel, values and times relative to the trip, of each parameter with a history
+struct PostMortemParams
+{
+    int count;
+    int trips;
+    int slot;
+    int channel;
+    int status;
+    int time;
+
+    std::map< std::string, std::pair<int, int> > traces;
+};
+
+// Key used to look up the target of an event: slot, channel (-1 for board parameters), and parameter name
+typedef std::tuple<int, int, std::string> eventKey_t;
+
 class CAENHVAsyn : public asynPortDriver
 {
     public:
         CAENHVAsyn(const std::string& portName, int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password);
 
         // Methods that we override from asynPortDriver
+        virtual asynStatus drvUserCreate      (asynUser *pasynUser, const char *drvInfo, const char **pptypeName, size_t *psize);
         virtual asynStatus readFloat64        (asynUser *pasynUser, epicsFloat64 *value);
         virtual asynStatus writeFloat64       (asynUser *pasynUser, epicsFloat64 value);
         virtual asynStatus readUInt32Digital  (asynUser *pasynUser, epicsUInt32 *value, epicsUInt32 mask);
@@ -125,14 +327,131 @@ class CAENHVAsyn : public asynPortDriver
         virtual asynStatus writeOctet         (asynUser *pasynUser, const char *value, size_t maxChars, size_t *nActual);
         virtual asynStatus readInt32          (asynUser *pasynUser, epicsInt32 *value);
         virtual asynStatus writeInt32         (asynUser *pasynUser, epicsInt32 value);
+        virtual asynStatus readFloat64Array   (asynUser *pasynUser, epicsFloat64 *value, size_t nElements, size_t *nIn);
+        virtual asynStatus readInt32Array     (asynUser *pasynUser, epicsInt32 *value, size_t nElements, size_t *nIn);
+
+        // The port lock is overridden to measure how long it is held
+        virtual asynStatus lock();
+        virtual asynStatus unlock();
 
         // EPICS record prefix. Use for autogeneration of PVs.
         static std::string epicsPrefix;
         // Crate information output file location
         static std::string crateInfoFilePath;
+        // Period of the parameter poller, in seconds. Zero disables the poller.
+        static double pollPeriod;
+        // Scan classes. Parameters not included in any scan class are read with the poller period.
+        static ScanClassList scanClasses;
+        // Deadbands applied to the values updated by the poller, or by events.
+        static std::vector<DeadbandRule> deadbands;
+
+        // Time window used to gather writes to channel parameters, in seconds. Zero disables the write queue.
+        static double writeWindow;
+
+        // Asynchronous writes. When enabled, write requests complete once they are queued on the I/O worker,
+        // and their result is published as the status of the parameter. Otherwise, they wait for the write.
+        static bool asyncWrites;
+
+        // Event mode. When enabled, the driver subscribes to parameter changes on the TCP port 'eventPort'.
+        static bool eventMode;
+        static int  eventPort;
+
+        // Number of worker threads used to discover the boards in the crate, and the channels of each board.
+        static std::size_t discoverySlotWorkers;
+        static std::size_t discoveryChannelWorkers;
+
+        // Directory of the discovery cache files. Empty disables the cache.
+        static std::string discoveryCachePath;
+
+        // Circuit breaker of the crate link, and reconnection delays.
+        static LinkConfig linkConfig;
+
+        // Breakers of the slots on the I/O worker.
+        static SlotBreakerConfig slotBreakerConfig;
+
+        // Period of the hot-plug check, in seconds. Zero disables the check.
+        static double hotPlugPeriod;
+
+        // History kept for the numeric channel parameters, by parameter name.
+        static std::vector<HistoryRule> histories;
+
+        // Post-mortem capture of the channel trips.
+        static PostMortemConfig postMortemConfig;
+
+        // Poller thread main loop
+        void pollerTask();
+
+        // Event thread main loop
+        void eventTask();
+
+        // Write queue thread main loop
+        void writerTask();
+
+        // Crate information thread main loop. It writes the crate information file once.
+        void infoTask();
+
+        // Diagnostic thread main loop. It updates the diagnostic parameters periodically.
+        void diagTask();
+
+        // Hot-plug thread main loop. It checks the crate map periodically, and rebuilds the slots whose board has changed.
+        void hotPlugTask();
+
+        // Post-mortem thread main loop. It freezes the history around each trip, publishes it, and writes it to disk.
+        void postMortemTask();
+
+        // Write the crate information: the metadata found during discovery, and the last
+        // values read by the poller. No parameter is read from the crate.
+        void writeCrateInfo(std::ostream& stream, bool json);
+
+        // Get the driver instance of a port. It returns NULL if the port is not found.
+        static CAENHVAsyn* findDriver(const std::string& portName);
+
+        // Start the crate information threads of all the driver instances
+        static void startInfoTasks();
+
+        // Print the statistics of the calls made to the crate of each driver instance, and optionally reset them
+        static void printWireStats(std::ostream& stream, int level, bool reset);
 
     private:
+        // Constructors used once the crate has been discovered, so that the parameter
+        // table can be sized from its content. The parameters are only counted once.
+        CAENHVAsyn(const std::string& portName, Crate c);
+        CAENHVAsyn(const std::string& portName, Crate c, std::size_t numParams);
+
+        // Validate the configuration parameters, connect to the crate, and discover it
+        static Crate createCrate(const std::string& portName, int systemType, const std::string& ipAddr, const std::string& userName, const std::string& password);
+
+        // Get the number of asyn parameters needed by a crate: its system, board, and channel parameters,
+        // and the array, history, slot, post-mortem, and diagnostic parameters created for them.
+        // Each address has its own parameter list, so this is the size of the largest one.
+        static std::size_t countParams(Crate c, bool polling);
+
+        // Get the number of asyn addresses of a crate: address 0 is used by the system properties
+        // and the driver parameters, and address 'slot + 1' by the parameters of each slot
+        static int countAddresses(Crate c) { return c->getNumSlots() + 1; };
+
+        // Create an asyn parameter in the list of an address, and add it to the name index.
+        // It returns the index of the parameter in the driver, which is unique across all the
+        // addresses, while asyn numbers the parameters of each address from 0.
+        int createIndexedParam(const std::string& name, asynParamType type, int addr);
+
+        // Get the asyn address, and the asyn reason in the list of that address, of a parameter
+        int getParamAddr(int index)   const { return paramAddresses.at(index); };
+        int getParamReason(int index) const { return paramReasons.at(index);   };
 
+        // Get the index of the parameter addressed by an asyn user. It returns -1 if
+        // the parameter was not created by the driver.
+        int getParamIndex(asynUser *pasynUser);
+
+        // Set the status of a parameter, on its address
+        void setIndexedParamStatus(int index, asynStatus status) { setParamStatus(getParamAddr(index), getParamReason(index), status); };
+
+        // Set the value of a diagnostic, or post-mortem, parameter
+        void setDiagParam(int index, double value) { setDoubleParam(getParamAddr(index), getParamReason(index), value); };
+
+        // Call the parameter callbacks of a set of addresses, or of all of them
+        void callAddrCallbacks(const std::set<int>& addrs);
+        void callAllParamCallbacks();
 
         // Methods to create EPICS asyn parameters and records for all system, board, and channel parameters
         template<typename T>
@@ -145,9 +464,192 @@ class CAENHVAsyn : public asynPortDriver
         void createParamInteger(T p, std::map<int, T>& list);
         template <typename T>
         void createParamString(T p, std::map<int, T>& list);
+        template <typename T>
+        void createParamArray(std::vector< PollEntry<T> >& list, bool isFloat);
+        void createParamHistory(std::vector< PollEntry<ChannelParameterGroupFloat> >& list);
+
+        // Get the history rule of a parameter, from its name. It returns NULL if no rule matches.
+        static const HistoryRule* getHistoryRule(const std::string& param);
+
+        // Methods to add parameters to the poller. They return true if the
+        // parameter is updated by the poller, or false otherwise.
+        template <typename T>
+        bool addToPoller(T p, int index) { return false; };
+        bool addToPoller(ChannelParameterNumeric  p, int index);
+        bool addToPoller(ChannelParameterOnOff    p, int index);
+        bool addToPoller(ChannelParameterChStatus p, int index);
+        bool addToPoller(ChannelParameterBinary   p, int index);
+        bool addToPoller(BoardParameterNumeric    p, int index);
+        bool addToPoller(BoardParameterOnOff      p, int index);
+        bool addToPoller(BoardParameterChStatus   p, int index);
+        bool addToPoller(BoardParameterBdStatus   p, int index);
+        bool addToPoller(SystemPropertyInteger    p, int index);
+        bool addToPoller(SystemPropertyFloat      p, int index);
+        bool addToPoller(SystemPropertyString     p, int index);
+
+        // Helper methods to add a channel or board parameter, or a system property, to a poller entry list
+        template <typename T, typename U>
+        void addToPollList(T p, int index, std::vector< PollEntry<U> >& pollList);
+        template <typename T, typename U>
+        void addToBoardPollList(T p, int index, std::vector< PollEntry<U> >& pollList, std::map< std::string, std::size_t >& listIndex);
+        template <typename T, typename U>
+        void addToSystemPollList(T p, int index, std::vector< PollEntry<U> >& pollList);
+
+        // Get the scan class of a parameter, from its name
+        std::size_t getScanClass(const std::string& param) const;
+
+        // Get the I/O worker priority used to poll a parameter group, from its scan class,
+        // and whether it contains status words
+        ioPriority_t getPollPriority(std::size_t scanClass, bool status) const;
+
+        // Get the I/O worker priority used to read a parameter which is not polled
+        ioPriority_t getReadPriority(const ParamHandler& h) const;
+
+        // Run a job from an asyn request on the I/O worker, as a job of a slot, and wait until
+        // it is done. It must be called with the port locked.
+        void ioRun(ioPriority_t priority, int slot, std::function<void()> job);
+
+        // Methods to run a write request on the I/O worker, and to publish its result
+        void ioWrite(int function, std::function<void()> write);
+        void writeDone(int function, const std::string& error);
+
+        // Publish the failure of the writes sent by the write queue, on the parameters written
+        void queuedWritesFailed(const std::vector<IWriteQueue::writeKey_t>& failed);
+
+        // Methods to read the parameter groups of a scan class, in all the poller
+        // entry lists, and update the associated asyn parameters
+        void pollScanClass(std::size_t scanClass, bool all);
+        template <typename T>
+        void pollList(std::vector< PollEntry<T> >& list, std::size_t scanClass, bool all);
+        template <typename T>
+        void pollEntry(PollEntry<T>& entry);
+
+        // Methods to read a parameter group on the I/O worker, as a job of its slot. The members of
+        // the slots held by their breaker are not read, and are flagged in 'held', which is left
+        // empty when all the members were read.
+        template <typename T>
+        void readGroup(const std::shared_ptr< IChannelParameterGroup<T> >& g, ioPriority_t p, std::vector<T>& vals, std::vector<bool>& held);
+        template <typename T>
+        void readGroup(const std::shared_ptr< IBoardParameterGroup<T> >& g, ioPriority_t p, std::vector<T>& vals, std::vector<bool>& held);
+        template <typename P, typename T>
+        void readGroup(const std::shared_ptr< ISystemPropertyGroup<P, T> >& g, ioPriority_t p, std::vector<T>& vals, std::vector<bool>& held);
+        template <typename T>
+        void countScanClass(const std::vector< PollEntry<T> >& list, std::vector<std::size_t>& count) const;
+        void setParamValue(int index, float              value) { setDoubleParam(getParamAddr(index), getParamReason(index), value);                  };
+        void setParamValue(int index, uint32_t           value) { setUIntDigitalParam(getParamAddr(index), getParamReason(index), value, 0xFFFFFFFF); };
+        void setParamValue(int index, int32_t            value) { setIntegerParam(getParamAddr(index), getParamReason(index), value);                 };
+        void setParamValue(int index, const std::string& value) { setStringParam(getParamAddr(index), getParamReason(index), value);                  };
+
+        // Methods to publish new values only when they have changed. Numeric values must change
+        // by more than their deadband, while status words, and on/off values, must change at all.
+        // They return true if the value was published.
+        void setDeadband(int index, const std::string& param);
+        template <typename T>
+        bool updateParamValue(int index, T value);
+        bool updateParamValue(int index, const std::string& value);
+        bool isChanged(const PublishedValue& p, float    value) const;
+        bool isChanged(const PublishedValue& p, uint32_t value) const { return ( value != p.value ); };
+        bool isChanged(const PublishedValue& p, int32_t  value) const { return ( value != p.value ); };
+
+        // Check if the values of all the parameters have been published since their last failed read or write
+        bool isPublished(const std::vector<int>& indexes);
+
+        // Methods to update the array parameter of a group, and to publish it
+        template <typename T>
+        void updateArrayValues(int index, const std::vector<T>& vals);
+        void updateArrayValues(int /* index */, const std::vector<std::string>& /* vals */) {}
+        void doArrayCallbacks(int index);
+
+        // Methods to record a sample of a group in its history parameter
+        template <typename T>
+        void recordHistory(int index, double time, const std::vector<T>& vals);
+        void recordHistory(int /* index */, double /* time */, const std::vector<std::string>& /* vals */) {}
+
+        // Methods to detect the channel trips, from the new value of a channel status word, before it is
+        // published. The trip bits set since the last published value start a post-mortem capture.
+        template <typename T>
+        void checkTrip(int /* index */, const T& /* value */, double /* time */) {}
+        void checkTrip(int index, uint32_t value, double time);
+
+        // Methods of the post-mortem capture: create its asyn parameters, freeze the history
+        // of the window around the trip, and publish the traces of the tripped channel
+        void createPostMortemParams();
+        void freezeCapture(Capture& c);
+        void publishCapture(const Capture& c);
+
+        // Methods to subscribe to changes of the parameters handled by the poller
+        typedef std::map< std::pair<int, int>, std::vector< std::pair<std::string, EventTarget> > > subscriptionRequests_t;
+        void subscribeParams();
+        void resubscribeParams();
+        template <typename T>
+        void addSubscriptionRequests(std::vector< PollEntry<T> >& list, subscriptionRequests_t& requests);
+        template <typename T>
+        void addBoardSubscriptionRequests(std::vector< PollEntry<T> >& list, subscriptionRequests_t& requests);
+        template <typename T>
+        std::size_t markSubscribed(std::vector< PollEntry<T> >& list);
+        template <typename T>
+        std::size_t markBoardSubscribed(std::vector< PollEntry<T> >& list);
+
+        // Methods to rebuild a slot whose board has changed. The parameters of the slot are detached, and
+        // removed from the poller and from the event targets, while the new board is discovered. Then, the
+        // asyn parameters whose name and type are found on the new board are rebound to its objects, and
+        // added back to the poller. The rest stay detached. The poller lists and the event targets are
+        // only changed with the poller lock held. The asyn parameter table can not grow, so the parameters
+        // of the new board without an asyn parameter are not available until the IOC is restarted.
+        void rebuildSlot(std::size_t slot);
+        void detachSlot(std::size_t slot, asynStatus status);
+        void attachSlot(std::size_t slot, Board b);
+        void attachBoard(Board b, std::size_t& rebound, std::size_t& missing);
+        template <typename T>
+        void rebindParams(const std::vector<T>& params, std::map<int, T>& list, std::size_t& rebound, std::size_t& missing);
+        template <typename T>
+        bool rebindParam(T p, std::map<int, T>& list);
+        template <typename T>
+        void clearSlotEntries(std::vector< PollEntry<T> >& list, std::size_t slot);
+        template <typename T>
+        void clearBoardSlotEntries(std::vector< PollEntry<T> >& list, std::size_t slot);
+        template <typename T>
+        void attachArrays(std::vector< PollEntry<T> >& list, std::size_t slot);
+        std::size_t subscribeSlot(std::size_t slot);
+        void pollSlot(std::size_t slot);
+        template <typename T>
+        void pollSlotList(std::vector< PollEntry<T> >& list, std::size_t slot);
+
+        // Methods to disable and enable a slot. The parameters of a disabled slot are detached, as while
+        // its board is rebuilt, but with a disabled status. They are attached again when it is enabled.
+        void createSlotParams();
+        void setSlotEnabled(std::size_t slot, bool enabled);
+
+        // Called on each change of the connection state of the crate. When the crate is disconnected, all
+        // the parameters of the crate are marked as disconnected. When it is connected again, the poller
+        // is requested to read all the parameters, and the parameters not read by the poller are cleared.
+        void linkStateChanged(linkState_t s);
+
+        // Get the name of an asyn parameter. Only used when printing messages.
+        const char* reasonName(int function);
+
+        // Methods to create and update the diagnostic parameters
+        int  createDriverParam(const std::string& paramName, const std::string& desc, const std::string& egu, int prec);
+        int  createDiagParam(const std::string& name, const std::string& desc, const std::string& egu, int prec);
+        void createDiagParams();
+        void updateDiagParams();
+        void updateSweepDiagParams(std::size_t scanClass, double sweepTime);
+        void updatePendingDiagParams(std::size_t pending, double oldest);
+
+        // Methods used to write the crate information. The values are taken from a copy of the last published values.
+        std::string getCachedValue(const std::string& paramName, const std::vector<PublishedValue>& values, bool isString, bool json) const;
+        void writeParamInfo(std::ostream& stream, bool json, const ParamInfo& info, const std::string& paramName, const std::vector<PublishedValue>& values) const;
+        template <typename T>
+        void writePropertyInfo(std::ostream& stream, bool json, bool& first, const std::vector<T>& props, bool isString, const std::vector<PublishedValue>& values) const;
+
+        // Driver instances, by port name
+        static std::map<std::string, CAENHVAsyn*> drivers;
 
         const std::string driverName_;
         std::string portName_;
+        const double pollPeriod_;
+        const double writeWindow_;
+        const double hotPlugPeriod_;
 
         // Crate object
         Crate crate;
@@ -168,6 +670,110 @@ class CAENHVAsyn : public asynPortDriver
        std::map<int, ChannelParameterOnOff>    channelParameterOnOffList;
        std::map<int, ChannelParameterChStatus> channelParameterChStatusList;
        std::map<int, ChannelParameterBinary>   channelParameterBinaryList;
+
+       // Handler records, indexed by asyn parameter index. They point to the objects
+       // held in the lists above, and are used by the read and write methods.
+       ParamHandlerTable handlers;
+
+       // Index of the asyn parameters by name, used to resolve the drvInfo of the records
+       std::unordered_map<std::string, int> paramIndex;
+
+       // Asyn address, and asyn reason, of each parameter, indexed by parameter index. And the
+       // parameter index of each asyn reason, for each address.
+       std::vector<int>                paramAddresses;
+       std::vector<int>                paramReasons;
+       std::vector< std::vector<int> > addrParams;
+
+       // Auto-generated records. Only used when the autogeneration of PVs is enabled.
+       RecordFile records;
+
+       // Poller
+       bool polling;
+
+       // Scan classes used by the poller. The first one is the default class,
+       // with the poller period, followed by the scan classes loaded from file.
+       std::vector<ScanClass> scanSchedule;
+
+       // Index of the parameter groups in the poller lists, by slot and parameter name
+       // for channel parameters, and by parameter name for board parameters
+       std::map< std::pair<std::size_t, std::string>, std::size_t > pollIndex;
+       std::map< std::string, std::size_t >                          pollBoardFloatIndex;
+       std::map< std::string, std::size_t >                          pollBoardUIntIndex;
+
+       // Poller lists of channel parameter groups
+       std::vector< PollEntry<ChannelParameterGroupFloat> > pollChannelFloatList;
+       std::vector< PollEntry<ChannelParameterGroupUInt>  > pollChannelUIntList;
+       std::vector< PollEntry<ChannelParameterGroupInt>   > pollChannelIntList;
+
+       // Poller lists of board parameter groups. The status words are read once
+       // per cycle, and all their bit records are updated from the stored value.
+       std::vector< PollEntry<BoardParameterGroupFloat> >   pollBoardFloatList;
+       std::vector< PollEntry<BoardParameterGroupUInt> >    pollBoardUIntList;
+
+       // Poller lists of system properties
+       std::vector< PollEntry<SystemPropertyGroupInt> >     pollSystemIntList;
+       std::vector< PollEntry<SystemPropertyGroupFloat> >   pollSystemFloatList;
+       std::vector< PollEntry<SystemPropertyGroupString> >  pollSystemStringList;
+
+       // Array parameter list
+       std::map<int, ArrayParam> arrayParamList;
+
+       // History parameter list, indexed by the asyn parameter index of the values
+       std::map<int, HistoryParam> historyParamList;
+
+       // Last published values, indexed by asyn parameter index
+       std::vector<PublishedValue> publishedValues;
+
+       // Signaled by the poller when its first cycle is done
+       epicsEvent firstPollDone;
+
+       // Held by the poller while it reads a scan class, and by the hot-plug thread while it changes the poller lists
+       epicsMutex pollMutex;
+
+       // Boards replaced by the hot-plug check. Their objects may still be used by requests in progress, so they are kept.
+       std::vector<Board> retiredBoards;
+
+       // Whether each slot is enabled. Held while a slot is enabled, disabled, or rebuilt.
+       std::vector<bool> slotEnabled;
+       epicsMutex        slotMutex;
+
+       // Diagnostic parameters of each type of call to the CAEN HV Wrapper library
+       std::vector<WireDiagParams> wireDiagParams;
+
+       // Diagnostic parameters of the poller: sweep statistics of each scan class, number of
+       // scan classes due at the start of each poller cycle, and how late the oldest one is
+       std::vector<ScanClassDiag> scanClassDiag;
+       int                        pollPendingParam;
+       int                        pollOldestParam;
+
+       // Diagnostic parameters of each priority of the I/O worker
+       std::vector<IoDiagParams> ioDiagParams;
+
+       // Hold time statistics of the port lock
+       LockDiag lockDiag;
+
+       // Diagnostic parameters of the crate link
+       LinkDiagParams linkDiagParams;
+
+       // Connection state of the crate, as last published, and whether the poller must read
+       // all the parameters, and subscribe again to their changes, after a reconnection
+       bool              linkUp;
+       std::atomic<bool> restorePending;
+
+       // I/O worker. All the calls to the crate done once the driver is running,
+       // by the poller, the event and writer threads, and the asyn requests, are run by it.
+       IoWorker ioWorker;
+
+       // Write queue
+       WriteQueue writeQueue;
+
+       // Event mode
+       Subscription                        subscription;
+       std::map< eventKey_t, EventTarget > eventTargets;
+
+       // Post-mortem capture. It is only created when enabled, and when there are history buffers.
+       PostMortem       postMortem;
+       PostMortemParams postMortemParams;
 };
 
 #endif
@@ -0,0 +1,111 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : history_buffer.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies History Buffer Class.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "history_buffer.h"
+
+IHistoryBuffer::IHistoryBuffer(std::size_t width, std::size_t capacity, std::size_t decimation)
+:
+    width(width),
+    capacity(capacity),
+    decimation(decimation),
+    head(0),
+    size(0),
+    offered(0)
+{
+    if ( ( width == 0 ) || ( capacity == 0 ) || ( decimation == 0 ) )
+        throw std::runtime_error("The width, capacity, and decimation of a history buffer must be larger than zero");
+
+    // All the memory is allocated here, and never again
+    values.assign(width * capacity, std::numeric_limits<double>::quiet_NaN());
+    times.assign(capacity, 0);
+}
+
+HistoryBuffer IHistoryBuffer::create(std::size_t width, std::size_t capacity, std::size_t decimation)
+{
+    return std::make_shared<IHistoryBuffer>(width, capacity, decimation);
+}
+
+void IHistoryBuffer::clear()
+{
+    head    = 0;
+    size    = 0;
+    offered = 0;
+}
+
+std::size_t IHistoryBuffer::copyRows(const std::vector<double>& ring, std::size_t stride, double* dst, std::size_t rows) const
+{
+    // The oldest of the requested samples, and the number of them before the end of the ring
+    std::size_t first( ( head + capacity - rows ) % capacity );
+    std::size_t tail( std::min(rows, capacity - first) );
+
+    memcpy(dst, &ring.at(first * stride), tail * stride * sizeof(double));
+    if ( rows > tail )
+        memcpy(dst + tail * stride, &ring.at(0), ( rows - tail ) * stride * sizeof(double));
+
+    return rows * stride;
+}
+
+std::size_t IHistoryBuffer::copyValues(double* dst, std::size_t n) const
+{
+    std::size_t rows( std::min(size, n / width) );
+    if ( rows == 0 )
+        return 0;
+
+    return copyRows(values, width, dst, rows);
+}
+
+std::size_t IHistoryBuffer::copyTimes(double* dst, std::size_t n) const
+{
+    std::size_t rows( std::min(size, n) );
+    if ( rows == 0 )
+        return 0;
+
+    return copyRows(times, 1, dst, rows);
+}
+
+std::size_t IHistoryBuffer::copyWindow(double from, double to, std::vector<double>& t, std::vector<double>& v) const
+{
+    // The samples are in time order, so the ones in the window are consecutive
+    std::size_t oldest( ( head + capacity - size ) % capacity );
+    std::size_t first(size);
+    std::size_t rows(0);
+    for (std::size_t i(0); i < size; ++i)
+    {
+        double time( times.at( ( oldest + i ) % capacity ) );
+        if ( ( time < from ) || ( time > to ) )
+            continue;
+
+        if ( rows == 0 )
+            first = i;
+        ++rows;
+    }
+
+    t.resize(rows);
+    v.resize(rows * width);
+    for (std::size_t i(0); i < rows; ++i)
+    {
+        std::size_t pos( ( oldest + first + i ) % capacity );
+        t.at(i) = times.at(pos);
+        memcpy(&v.at(i * width), &values.at(pos * width), width * sizeof(double));
+    }
+
+    return rows;
+}
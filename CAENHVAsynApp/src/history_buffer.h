@@ -0,0 +1,120 @@
+#ifndef HISTORY_BUFFER_H
+#define HISTORY_BUFFER_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : history_buffer.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies History Buffer Class.
+ * It keeps the last samples of a channel parameter on all the channels of a
+ * board, in a ring buffer allocated when it is created. The values are stored
+ * as a contiguous matrix, with one row per sample and one column per channel,
+ * and the time of each sample in a separate vector, so that the history can be
+ * copied out with at most two block copies. Recording a sample does not
+ * allocate memory.
+ * The buffer is not thread safe: the driver records and reads it with the
+ * port lock held.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <string.h>
+
+class IHistoryBuffer;
+
+typedef std::shared_ptr<IHistoryBuffer> HistoryBuffer;
+
+class IHistoryBuffer
+{
+public:
+    // The buffer keeps 'capacity' samples of 'width' channels. Only one of every 'decimation' samples is stored.
+    IHistoryBuffer(std::size_t width, std::size_t capacity, std::size_t decimation);
+    ~IHistoryBuffer() {};
+
+    // Factory method
+    static HistoryBuffer create(std::size_t width, std::size_t capacity, std::size_t decimation);
+
+    // Offer a sample, taken at 'time' (in seconds since the POSIX epoch). It returns true if it was
+    // stored. The values of the channels beyond the size of 'vals' are stored as NaN, and the values
+    // beyond the width of the buffer are ignored.
+    template <typename T>
+    bool record(double time, const std::vector<T>& vals)
+    {
+        if ( ( ++offered % decimation ) != 0 )
+            return false;
+
+        double* row( &values.at(head * width) );
+        std::size_t n( std::min(width, vals.size()) );
+        for (std::size_t i(0); i < n; ++i)
+            row[i] = static_cast<double>( vals[i] );
+        for (std::size_t i(n); i < width; ++i)
+            row[i] = std::numeric_limits<double>::quiet_NaN();
+
+        times.at(head) = time;
+        head = ( head + 1 ) % capacity;
+        if ( size < capacity )
+            ++size;
+
+        return true;
+    }
+
+    // Remove all the stored samples
+    void clear();
+
+    // Copy the values of the newest samples which fit in 'n' elements, oldest first, one row of
+    // 'width' values per sample. It returns the number of elements copied.
+    std::size_t copyValues(double* dst, std::size_t n) const;
+
+    // Copy the times of the newest samples which fit in 'n' elements, oldest first.
+    // It returns the number of elements copied.
+    std::size_t copyTimes(double* dst, std::size_t n) const;
+
+    // Copy the samples taken between 'from' and 'to', both included, oldest first: their times, and
+    // their values, one row of 'width' values per sample. It returns the number of samples copied.
+    std::size_t copyWindow(double from, double to, std::vector<double>& t, std::vector<double>& v) const;
+
+    std::size_t getWidth()      const { return width;      };
+    std::size_t getCapacity()   const { return capacity;   };
+    std::size_t getDecimation() const { return decimation; };
+    std::size_t getSize()       const { return size;       };
+
+    // Memory used by the stored values and times, in bytes
+    std::size_t getMemory()     const { return ( values.size() + times.size() ) * sizeof(double); };
+
+private:
+    // Copy the last 'rows' samples of a ring of 'stride' elements per sample, oldest first
+    std::size_t copyRows(const std::vector<double>& ring, std::size_t stride, double* dst, std::size_t rows) const;
+
+    std::size_t         width;
+    std::size_t         capacity;
+    std::size_t         decimation;
+
+    // Position of the next sample, number of stored samples, and number of offered samples
+    std::size_t         head;
+    std::size_t         size;
+    std::size_t         offered;
+
+    std::vector<double> values;
+    std::vector<double> times;
+};
+
+#endif
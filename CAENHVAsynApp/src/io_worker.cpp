@@ -0,0 +1,282 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : io_worker.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies I/O Worker Class.
+ * It runs all the calls to a crate in a single thread, taking them from a
+ * priority queue. Jobs of the same priority are run in the order they were
+ * queued, and a job is only started when no job of a higher priority is
+ * pending, so urgent requests wait at most for the call in progress.
+ * Jobs can be bound to a slot of the crate. A slot whose jobs keep being
+ * slow is held by its breaker, and its jobs are rejected for a while, so a
+ * board which is timing out does not stall the jobs of the other slots.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "io_worker.h"
+#include "common.h"
+
+const char* getIoPriorityName(ioPriority_t p)
+{
+    switch (p)
+    {
+        case IO_PRIORITY_HIGH:   return "High";
+        case IO_PRIORITY_NORMAL: return "Normal";
+        case IO_PRIORITY_LOW:    return "Low";
+        default:                 return "Unknown";
+    }
+}
+
+// C wrapper for the worker thread
+static void workerTaskC(void *pvt)
+{
+    IIoWorker *pPvt = (IIoWorker *)pvt;
+    pPvt->workerTask();
+}
+
+IIoWorker::IIoWorker(const std::string& n, const SlotBreakerConfig& c)
+:
+    name(n),
+    config(c),
+    threadId(NULL)
+{
+    for (std::size_t i(0); i < NUM_IO_PRIORITIES; ++i)
+    {
+        stats[i].jobs      = 0;
+        stats[i].totalWait = 0;
+        stats[i].maxWait   = 0;
+        stats[i].rejected  = 0;
+    }
+}
+
+IoWorker IIoWorker::create(const std::string& n, const SlotBreakerConfig& c)
+{
+    IoWorker w( std::make_shared<IIoWorker>(n, c) );
+
+    // The thread ID is set before the thread can run any job
+    w->mutex.lock();
+    w->threadId = epicsThreadCreate(n.c_str(),
+                                    epicsThreadPriorityMedium,
+                                    epicsThreadGetStackSize(epicsThreadStackMedium),
+                                    (EPICSTHREADFUNC)workerTaskC,
+                                    w.get());
+    w->mutex.unlock();
+
+    if ( ! w->threadId )
+        throw std::runtime_error("Could not create the I/O worker thread '" + n + "'");
+
+    return w;
+}
+
+void IIoWorker::submit(ioPriority_t p, int slot, std::function<void()> job, std::function<void(const std::string&)> done)
+{
+    Job j;
+    j.slot   = slot;
+    j.job    = job;
+    j.done   = done;
+    j.queued = epicsTime::getCurrent();
+
+    mutex.lock();
+    queues[p].push_back(j);
+    mutex.unlock();
+
+    event.signal();
+}
+
+void IIoWorker::run(ioPriority_t p, int slot, std::function<void()> job)
+{
+    // Jobs run from other jobs would wait for themselves. They are part of the
+    // job which runs them, so they are not checked by the slot breakers.
+    if ( epicsThreadGetIdSelf() == threadId )
+    {
+        job();
+        return;
+    }
+
+    epicsEvent  done;
+    std::string error;
+
+    submit(p, slot, job, [&](const std::string& e) { error = e; done.signal(); });
+    done.wait();
+
+    if ( ! error.empty() )
+        throw std::runtime_error(error);
+}
+
+IoQueueStats IIoWorker::getStats(ioPriority_t p)
+{
+    IoQueueStats s;
+
+    mutex.lock();
+    s.jobs     = stats[p].jobs;
+    s.pending  = queues[p].size();
+    s.meanWait = stats[p].jobs ? ( 1e3 * stats[p].totalWait / stats[p].jobs ) : 0;
+    s.maxWait  = 1e3 * stats[p].maxWait;
+    s.rejected = stats[p].rejected;
+    mutex.unlock();
+
+    return s;
+}
+
+bool IIoWorker::reject(ioPriority_t p, int slot)
+{
+    mutex.lock();
+    bool held( isRejected(slot, epicsTime::getCurrent()) );
+    if ( held )
+        ++stats[p].rejected;
+    mutex.unlock();
+
+    return held;
+}
+
+bool IIoWorker::isRejected(int slot, const epicsTime& now)
+{
+    if ( ( ! config.maxSlowJobs ) || ( slot == IO_NO_SLOT ) )
+        return false;
+
+    std::map<int, SlotBreaker>::const_iterator it = breakers.find(slot);
+    if ( it == breakers.end() )
+        return false;
+
+    // Once the hold-off time has passed, the next job is run as a trial
+    return ( it->second.held && ( now < it->second.until ) );
+}
+
+void IIoWorker::updateBreaker(int slot, double elapsed)
+{
+    if ( ( ! config.maxSlowJobs ) || ( slot == IO_NO_SLOT ) )
+        return;
+
+    bool slow( elapsed > config.slowJob );
+    bool changed(false);
+    std::size_t slowJobs;
+
+    mutex.lock();
+    std::map<int, SlotBreaker>::iterator it = breakers.find(slot);
+    if ( it == breakers.end() )
+    {
+        SlotBreaker b;
+        b.slowJobs = 0;
+        b.held     = false;
+        it = breakers.insert( std::make_pair(slot, b) ).first;
+    }
+
+    SlotBreaker& b( it->second );
+    if ( slow )
+    {
+        // A slow trial holds the slot again
+        ++b.slowJobs;
+        if ( b.held || ( b.slowJobs >= config.maxSlowJobs ) )
+        {
+            changed = ( ! b.held );
+            b.held  = true;
+            b.until = epicsTime::getCurrent() + config.holdOff;
+        }
+    }
+    else
+    {
+        changed    = b.held;
+        b.slowJobs = 0;
+        b.held     = false;
+    }
+    slowJobs = b.slowJobs;
+    mutex.unlock();
+
+    if ( ! changed )
+        return;
+
+    std::stringstream msg;
+    if ( slow )
+        msg << "Slot " << slot << " is held, after " << slowJobs << " consecutive jobs slower than " << config.slowJob << " s. " \
+            << "Its jobs will be rejected, and retried every " << config.holdOff << " s.";
+    else
+        msg << "Slot " << slot << " is released, its jobs are no longer slow.";
+    printMessage(name, msg.str());
+}
+
+void IIoWorker::workerTask()
+{
+    for (;;)
+    {
+        // Take the oldest job of the highest priority
+        Job j;
+        bool found(false);
+        bool rejected(false);
+
+        mutex.lock();
+        epicsTime start( epicsTime::getCurrent() );
+        for (std::size_t i(0); i < NUM_IO_PRIORITIES; ++i)
+        {
+            if ( queues[i].empty() )
+                continue;
+
+            j = queues[i].front();
+            queues[i].pop_front();
+
+            // The jobs of a held slot are rejected without calling the crate
+            rejected = isRejected(j.slot, start);
+            if ( rejected )
+            {
+                ++stats[i].rejected;
+            }
+            else
+            {
+                double wait( start - j.queued );
+                ++stats[i].jobs;
+                stats[i].totalWait += wait;
+                stats[i].maxWait    = std::max(stats[i].maxWait, wait);
+            }
+
+            found = true;
+            break;
+        }
+        mutex.unlock();
+
+        if ( ! found )
+        {
+            event.wait();
+            continue;
+        }
+
+        if ( rejected )
+        {
+            std::stringstream error;
+            error << "Slot " << j.slot << " is held, as its previous jobs were too slow";
+            if ( j.done )
+                j.done(error.str());
+            continue;
+        }
+
+        std::string error;
+        try
+        {
+            j.job();
+        }
+        catch(std::exception& e)
+        {
+            error = e.what();
+
+            // The callback must always be called, so that waiting callers are released
+            if ( error.empty() )
+                error = "Unknown error";
+        }
+
+        updateBreaker(j.slot, epicsTime::getCurrent() - start);
+
+        if ( j.done )
+            j.done(error);
+    }
+}
@@ -0,0 +1,170 @@
+#ifndef IO_WORKER_H
+#define IO_WORKER_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : io_worker.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies I/O Worker Class.
+ * It runs all the calls to a crate in a single thread, taking them from a
+ * priority queue. Jobs of the same priority are run in the order they were
+ * queued, and a job is only started when no job of a higher priority is
+ * pending, so urgent requests wait at most for the call in progress.
+ * Jobs can be bound to a slot of the crate. A slot whose jobs keep being
+ * slow is held by its breaker, and its jobs are rejected for a while, so a
+ * board which is timing out does not stall the jobs of the other slots.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <stdint.h>
+#include <epicsThread.h>
+#include <epicsMutex.h>
+#include <epicsEvent.h>
+#include <epicsTime.h>
+
+// Priority of the jobs run by the I/O worker:
+// - High   : operator writes, and status word reads,
+// - Normal : monitor reads,
+// - Low    : slow reads, done by scan classes with a period longer than the poller period.
+enum ioPriority_t
+{
+    IO_PRIORITY_HIGH,
+    IO_PRIORITY_NORMAL,
+    IO_PRIORITY_LOW,
+    NUM_IO_PRIORITIES
+};
+
+// Get the name of a priority
+const char* getIoPriorityName(ioPriority_t p);
+
+// Slot of the jobs which are not bound to a slot of the crate
+static const int IO_NO_SLOT = -1;
+
+// Configuration of the slot breakers:
+// - maxSlowJobs : number of consecutive slow jobs of a slot after which the slot is held.
+//                 Zero disables the slot breakers, and the jobs are always run,
+// - slowJob     : time after which a job is considered slow, in seconds,
+// - holdOff     : time the jobs of a held slot are rejected, in seconds. The next job of
+//                 the slot is then run as a trial: the slot is released if it is not slow,
+//                 or held again otherwise.
+struct SlotBreakerConfig
+{
+    std::size_t maxSlowJobs;
+    double      slowJob;
+    double      holdOff;
+};
+
+// Default configuration: a slot is held for 10 s after 3 consecutive jobs slower than 1 s
+static const SlotBreakerConfig defaultSlotBreakerConfig = { 3, 1.0, 10.0 };
+
+// Statistics of the jobs of a priority:
+// - jobs     : number of jobs run,
+// - pending  : number of jobs waiting in the queue,
+// - meanWait : mean time the jobs waited in the queue, in ms,
+// - maxWait  : maximum time a job waited in the queue, in ms,
+// - rejected : number of jobs rejected because their slot was held.
+struct IoQueueStats
+{
+    uint64_t    jobs;
+    std::size_t pending;
+    double      meanWait;
+    double      maxWait;
+    uint64_t    rejected;
+};
+
+class IIoWorker;
+
+typedef std::shared_ptr<IIoWorker> IoWorker;
+
+class IIoWorker
+{
+public:
+    IIoWorker(const std::string& n, const SlotBreakerConfig& c);
+    ~IIoWorker() {};
+
+    // Factory method. It starts the worker thread.
+    static IoWorker create(const std::string& n, const SlotBreakerConfig& c = defaultSlotBreakerConfig);
+
+    // Queue a job of a slot, or of IO_NO_SLOT. Once it is run, or rejected because its slot is held,
+    // the callback is called from the worker thread with an empty string if it succeeded, or with
+    // the error message otherwise.
+    void submit(ioPriority_t p, int slot, std::function<void()> job, std::function<void(const std::string&)> done);
+
+    // Queue a job, and wait until it is run. If the job failed, an exception is thrown
+    // with its error. When called from the worker thread, the job is run immediately.
+    void run(ioPriority_t p, int slot, std::function<void()> job);
+
+    // Check if the jobs of a slot are being rejected by its breaker. If so, the job the
+    // caller was about to submit is counted as rejected, and must not be submitted.
+    bool reject(ioPriority_t p, int slot);
+
+    // Get the statistics of the jobs of a priority
+    IoQueueStats getStats(ioPriority_t p);
+
+    // Worker thread main loop
+    void workerTask();
+
+private:
+    struct Job
+    {
+        int                                     slot;
+        std::function<void()>                   job;
+        std::function<void(const std::string&)> done;
+        epicsTime                               queued;
+    };
+
+    struct QueueStats
+    {
+        uint64_t jobs;
+        double   totalWait;
+        double   maxWait;
+        uint64_t rejected;
+    };
+
+    // State of the breaker of a slot. A held slot rejects its jobs until 'until'.
+    struct SlotBreaker
+    {
+        std::size_t slowJobs;
+        bool        held;
+        epicsTime   until;
+    };
+
+    // Check if the jobs of a slot must be rejected now. It must be called with the mutex locked.
+    bool isRejected(int slot, const epicsTime& now);
+
+    // Update the breaker of a slot with the time taken by one of its jobs
+    void updateBreaker(int slot, double elapsed);
+
+    std::string                name;
+    SlotBreakerConfig          config;
+    epicsThreadId              threadId;
+    std::deque<Job>            queues[NUM_IO_PRIORITIES];
+    QueueStats                 stats[NUM_IO_PRIORITIES];
+    std::map<int, SlotBreaker> breakers;
+    epicsMutex                 mutex;
+    epicsEvent                 event;
+};
+
+#endif
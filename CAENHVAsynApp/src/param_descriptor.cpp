@@ -0,0 +1,117 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : param_descriptor.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Parameter Descriptor Registry Class.
+ * All the channels of boards of the same model and firmware release have the
+ * same parameters. The registry holds one immutable table of parameter
+ * descriptors for each model and firmware release, which is shared by all
+ * those channels.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "param_descriptor.h"
+
+bool operator==(const ParamInfo& lhs, const ParamInfo& rhs)
+{
+    return ( lhs.name     == rhs.name     ) &&
+           ( lhs.type     == rhs.type     ) &&
+           ( lhs.mode     == rhs.mode     ) &&
+           ( lhs.minVal   == rhs.minVal   ) &&
+           ( lhs.maxVal   == rhs.maxVal   ) &&
+           ( lhs.units    == rhs.units    ) &&
+           ( lhs.onState  == rhs.onState  ) &&
+           ( lhs.offState == rhs.offState );
+}
+
+bool operator!=(const ParamInfo& lhs, const ParamInfo& rhs)
+{
+    return !( lhs == rhs );
+}
+
+ParamDescriptor createParamDescriptor(const ParamInfo& info)
+{
+    return std::make_shared<const ParamInfo>(info);
+}
+
+ParamDescriptor createParamDescriptor(const ParamDescriptorTable& table, std::size_t i)
+{
+    // Aliasing constructor: shares the ownership of the table
+    return ParamDescriptor( table, &table->at(i) );
+}
+
+ParamDescriptorRegistry IParamDescriptorRegistry::create()
+{
+    return std::make_shared<IParamDescriptorRegistry>();
+}
+
+ParamDescriptorTable IParamDescriptorRegistry::find(const std::string& model, const std::string& fw, const std::vector<std::string>& names)
+{
+    ParamDescriptorTable table;
+
+    mutex.lock();
+    std::map<key_t, Entry>::const_iterator it = entries.find( key_t(model, fw) );
+    if ( ( it != entries.end() ) && ( it->second.names == names ) )
+        table = it->second.table;
+    mutex.unlock();
+
+    return table;
+}
+
+ParamDescriptorTable IParamDescriptorRegistry::add(const std::string& model, const std::string& fw, const std::vector<std::string>& names, const std::vector<ParamInfo>& info)
+{
+    ParamDescriptorTable table;
+
+    mutex.lock();
+    std::map<key_t, Entry>::iterator it = entries.find( key_t(model, fw) );
+    if ( it == entries.end() )
+    {
+        // First table of this model and firmware release
+        Entry e;
+        e.names = names;
+        e.table = std::make_shared< const std::vector<ParamInfo> >(info);
+        table   = entries.insert( std::make_pair( key_t(model, fw), e ) ).first->second.table;
+    }
+    else if ( *(it->second.table) == info )
+    {
+        // Same content. The list of names is recorded if it was not known.
+        if ( it->second.names.empty() )
+            it->second.names = names;
+        table = it->second.table;
+    }
+    else
+    {
+        // Different content. This channel gets its own table.
+        table = std::make_shared< const std::vector<ParamInfo> >(info);
+    }
+    mutex.unlock();
+
+    return table;
+}
+
+ParamDescriptorTable IParamDescriptorRegistry::add(const std::string& model, const std::string& fw, const std::vector<ParamInfo>& info)
+{
+    return add(model, fw, std::vector<std::string>(), info);
+}
+
+std::size_t IParamDescriptorRegistry::getSize()
+{
+    mutex.lock();
+    std::size_t n( entries.size() );
+    mutex.unlock();
+
+    return n;
+}
@@ -0,0 +1,93 @@
+#ifndef PARAM_DESCRIPTOR_H
+#define PARAM_DESCRIPTOR_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : param_descriptor.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Parameter Descriptor Registry Class.
+ * All the channels of boards of the same model and firmware release have the
+ * same parameters. The registry holds one immutable table of parameter
+ * descriptors for each model and firmware release, which is shared by all
+ * those channels.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <utility>
+#include <epicsMutex.h>
+
+#include "common.h"
+
+class IParamDescriptorRegistry;
+
+// Immutable parameter descriptor, and table of descriptors of all the parameters of a channel
+typedef std::shared_ptr<const ParamInfo>                ParamDescriptor;
+typedef std::shared_ptr< const std::vector<ParamInfo> > ParamDescriptorTable;
+
+typedef std::shared_ptr<IParamDescriptorRegistry> ParamDescriptorRegistry;
+
+bool operator==(const ParamInfo& lhs, const ParamInfo& rhs);
+bool operator!=(const ParamInfo& lhs, const ParamInfo& rhs);
+
+// Create a standalone descriptor
+ParamDescriptor createParamDescriptor(const ParamInfo& info);
+
+// Create a descriptor pointing to an element of a table. It keeps the table alive.
+ParamDescriptor createParamDescriptor(const ParamDescriptorTable& table, std::size_t i);
+
+class IParamDescriptorRegistry
+{
+public:
+    IParamDescriptorRegistry() {};
+    ~IParamDescriptorRegistry() {};
+
+    // Factory method
+    static ParamDescriptorRegistry create();
+
+    // Find the table of a board model and firmware release. The list of parameter names
+    // reported by the channel must match the list of the channel the table was created from.
+    // It returns an empty pointer if there is no matching table.
+    ParamDescriptorTable find(const std::string& model, const std::string& fw, const std::vector<std::string>& names);
+
+    // Add the table of a board model and firmware release, created from a channel with the
+    // given list of parameter names. If there is already a table with the same content, the
+    // existing table is returned. Otherwise, the new table is returned.
+    ParamDescriptorTable add(const std::string& model, const std::string& fw, const std::vector<std::string>& names, const std::vector<ParamInfo>& info);
+
+    // Same as above, for a table whose list of parameter names is not known
+    ParamDescriptorTable add(const std::string& model, const std::string& fw, const std::vector<ParamInfo>& info);
+
+    // Number of tables in the registry
+    std::size_t getSize();
+
+private:
+    struct Entry
+    {
+        std::vector<std::string> names;
+        ParamDescriptorTable     table;
+    };
+
+    typedef std::pair<std::string, std::string> key_t;
+
+    std::map<key_t, Entry> entries;
+    epicsMutex             mutex;
+};
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : param_handler.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Parameter Handler Table.
+ * It contains a handler record for each asyn parameter, indexed by the asyn
+ * reason, so that the asyn read and write methods can find the object
+ * associated to a parameter with a single vector access.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "param_handler.h"
+
+ParamHandlerTable::ParamHandlerTable()
+{
+    none.kind    = HANDLER_NONE;
+    none.slot    = -1;
+    none.channel = -1;
+    none.polled  = false;
+    none.object  = NULL;
+}
+
+void ParamHandlerTable::set(int index, const ParamHandler& h)
+{
+    if ( index < 0 )
+        return;
+
+    // The asyn parameters are created with consecutive indexes, so the
+    // table grows by one record at a time in normal use
+    if ( table.size() <= static_cast<std::size_t>(index) )
+        table.resize(index + 1, none);
+
+    table[index] = h;
+}
@@ -0,0 +1,101 @@
+#ifndef PARAM_HANDLER_H
+#define PARAM_HANDLER_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : param_handler.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Parameter Handler Table.
+ * It contains a handler record for each asyn parameter, indexed by the asyn
+ * reason, so that the asyn read and write methods can find the object
+ * associated to a parameter with a single vector access.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <vector>
+#include <cstddef>
+
+// Kind of object associated to an asyn parameter
+enum paramHandlerKind_t
+{
+    HANDLER_NONE,
+    HANDLER_SYSTEM_INTEGER,
+    HANDLER_SYSTEM_FLOAT,
+    HANDLER_SYSTEM_STRING,
+    HANDLER_BOARD_NUMERIC,
+    HANDLER_BOARD_ONOFF,
+    HANDLER_BOARD_CHSTATUS,
+    HANDLER_BOARD_BDSTATUS,
+    HANDLER_CHANNEL_NUMERIC,
+    HANDLER_CHANNEL_ONOFF,
+    HANDLER_CHANNEL_CHSTATUS,
+    HANDLER_CHANNEL_BINARY,
+    HANDLER_FLOAT64_ARRAY,
+    HANDLER_INT32_ARRAY,
+    HANDLER_HISTORY_VALUES,
+    HANDLER_HISTORY_TIMES,
+    HANDLER_SLOT_DISABLE,
+    HANDLER_DETACHED
+};
+
+// Handler record of an asyn parameter:
+// - kind    : kind of object associated to the parameter,
+// - slot    : slot number, or -1 for system properties,
+// - channel : channel number, or -1 for system properties and board parameters,
+// - polled  : true if the value is updated by the poller, and must be read from the parameter cache,
+// - object  : pointer to the system property, board parameter, or channel parameter object,
+//             to the cached values for array parameters, or to the history buffer for history
+//             parameters. The objects are owned by the driver.
+// Parameters of kind HANDLER_DETACHED belonged to a board which was removed or replaced, or
+// to a disabled slot. They keep their slot and channel, their reads return the last value with
+// a disconnected or disabled status, and their writes fail. The parameter of kind
+// HANDLER_SLOT_DISABLE of each slot disables it, and has no object.
+struct ParamHandler
+{
+    paramHandlerKind_t kind;
+    int                slot;
+    int                channel;
+    bool               polled;
+    void*              object;
+};
+
+class ParamHandlerTable
+{
+public:
+    ParamHandlerTable();
+    ~ParamHandlerTable() {};
+
+    // Set the handler of an asyn parameter
+    void set(int index, const ParamHandler& h);
+
+    // Get the handler of an asyn parameter. Parameters without a handler
+    // return a record of kind HANDLER_NONE.
+    const ParamHandler& get(int index) const
+    {
+        if ( ( index < 0 ) || ( static_cast<std::size_t>(index) >= table.size() ) )
+            return none;
+
+        return table[index];
+    };
+
+    std::size_t size() const { return table.size(); };
+
+private:
+    std::vector<ParamHandler> table;
+    ParamHandler              none;
+};
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : parameter_group.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Parameter Group Classes.
+ * A parameter group contains the same parameter on several channels of a
+ * board, or on several boards, so that all of them can be read with a single
+ * call to the crate.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "parameter_group.h"
+
+// Class for a channel parameter on a list of channels of the same board
+template<typename T>
+IChannelParameterGroup<T>::IChannelParameterGroup(int h, std::size_t s, const std::string& p)
+:
+    handle(h),
+    slot(s),
+    param(p)
+{
+    std::stringstream temp;
+    temp << "Slot " << slot << ", " << param;
+    desc = temp.str();
+}
+
+template<typename T>
+std::shared_ptr< IChannelParameterGroup<T> > IChannelParameterGroup<T>::create(int h, std::size_t s, const std::string& p)
+{
+    return std::make_shared< IChannelParameterGroup<T> >(h, s, p);
+}
+
+template<typename T>
+void IChannelParameterGroup<T>::addChannel(std::size_t c)
+{
+    channels.push_back(c);
+    values.resize(channels.size());
+}
+
+template<typename T>
+const std::vector<T>& IChannelParameterGroup<T>::getVals()
+{
+    if ( channels.empty() )
+        return values;
+
+    if ( linkCall(WIRE_GET_CH_PARAM, handle, [&](int libHandle) { return CAENHV_GetChParam(libHandle, slot, param.c_str(), channels.size(), &channels.at(0), &values.at(0)); }) != CAENHV_OK )
+           throw std::runtime_error("CAENHV_GetChParam failed: " + std::string(linkError(handle)));
+
+    return values;
+}
+
+// Class for a board parameter on a list of boards
+template<typename T>
+IBoardParameterGroup<T>::IBoardParameterGroup(int h, const std::string& p)
+:
+    handle(h),
+    param(p)
+{
+    std::stringstream temp;
+    temp << "Boards, " << param;
+    desc = temp.str();
+}
+
+template<typename T>
+std::shared_ptr< IBoardParameterGroup<T> > IBoardParameterGroup<T>::create(int h, const std::string& p)
+{
+    return std::make_shared< IBoardParameterGroup<T> >(h, p);
+}
+
+template<typename T>
+void IBoardParameterGroup<T>::addBoard(std::size_t s)
+{
+    slots.push_back(s);
+    values.resize(slots.size());
+}
+
+template<typename T>
+const std::vector<T>& IBoardParameterGroup<T>::getVals()
+{
+    if ( slots.empty() )
+        return values;
+
+    if ( linkCall(WIRE_GET_BD_PARAM, handle, [&](int libHandle) { return CAENHV_GetBdParam(libHandle, slots.size(), &slots.at(0), param.c_str(), &values.at(0)); }) != CAENHV_OK )
+           throw std::runtime_error("CAENHV_GetBdParam failed: " + std::string(linkError(handle)));
+
+    return values;
+}
+
+// Class for a system property
+template<typename P, typename T>
+ISystemPropertyGroup<P, T>::ISystemPropertyGroup(P p)
+:
+    prop(p),
+    param(p->getProp()),
+    values(1)
+{
+    std::stringstream temp;
+    temp << "System, " << param;
+    desc = temp.str();
+}
+
+template<typename P, typename T>
+std::shared_ptr< ISystemPropertyGroup<P, T> > ISystemPropertyGroup<P, T>::create(P p)
+{
+    return std::make_shared< ISystemPropertyGroup<P, T> >(p);
+}
+
+template<typename P, typename T>
+const std::vector<T>& ISystemPropertyGroup<P, T>::getVals()
+{
+    values.at(0) = prop->getVal();
+
+    return values;
+}
+
+template class IChannelParameterGroup<float>;
+template class IChannelParameterGroup<uint32_t>;
+template class IChannelParameterGroup<int32_t>;
+template class IBoardParameterGroup<float>;
+template class IBoardParameterGroup<uint32_t>;
+template class ISystemPropertyGroup<SystemPropertyInteger, int32_t>;
+template class ISystemPropertyGroup<SystemPropertyFloat,   float>;
+template class ISystemPropertyGroup<SystemPropertyString,  std::string>;
@@ -0,0 +1,161 @@
+#ifndef PARAMETER_GROUP_H
+#define PARAMETER_GROUP_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : parameter_group.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Parameter Group Classes.
+ * A parameter group contains the same parameter on several channels of a
+ * board, or on several boards, so that all of them can be read with a single
+ * call to the crate.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <memory>
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+#include <iostream>
+
+#include "CAENHVWrapper.h"
+#include "common.h"
+#include "crate_link.h"
+#include "system_property.h"
+
+template<typename T>
+class IChannelParameterGroup;
+template<typename T>
+class IBoardParameterGroup;
+template<typename P, typename T>
+class ISystemPropertyGroup;
+
+// Shared pointer types
+typedef std::shared_ptr< IChannelParameterGroup<float>    > ChannelParameterGroupFloat;
+typedef std::shared_ptr< IChannelParameterGroup<uint32_t> > ChannelParameterGroupUInt;
+typedef std::shared_ptr< IChannelParameterGroup<int32_t>  > ChannelParameterGroupInt;
+typedef std::shared_ptr< IBoardParameterGroup<float>      > BoardParameterGroupFloat;
+typedef std::shared_ptr< IBoardParameterGroup<uint32_t>   > BoardParameterGroupUInt;
+typedef std::shared_ptr< ISystemPropertyGroup<SystemPropertyInteger, int32_t>     > SystemPropertyGroupInt;
+typedef std::shared_ptr< ISystemPropertyGroup<SystemPropertyFloat,   float>       > SystemPropertyGroupFloat;
+typedef std::shared_ptr< ISystemPropertyGroup<SystemPropertyString,  std::string> > SystemPropertyGroupString;
+
+// Class for a channel parameter on a list of channels of the same board
+template<typename T>
+class IChannelParameterGroup
+{
+public:
+    typedef T value_type;
+
+    IChannelParameterGroup(int h, std::size_t s, const std::string& p);
+    ~IChannelParameterGroup() {};
+
+    // Factory method
+    static std::shared_ptr< IChannelParameterGroup > create(int h, std::size_t s, const std::string& p);
+
+    // Add a channel to the group
+    void addChannel(std::size_t c);
+
+    std::size_t        getSlot()  const { return slot;            };
+    const std::string& getParam() const { return param;           };
+    const std::string& getDesc()  const { return desc;            };
+    std::size_t        getSize()  const { return channels.size(); };
+
+    const std::vector<uint16_t>& getChannels() const { return channels; };
+
+    // Read the parameter from all the channels in the group, using a single call.
+    // The values are returned in the same order the channels were added.
+    const std::vector<T>& getVals();
+
+private:
+    int                   handle;
+    std::size_t           slot;
+    std::string           param;
+    std::string           desc;
+    std::vector<uint16_t> channels;
+    std::vector<T>        values;
+};
+
+// Class for a board parameter on a list of boards
+template<typename T>
+class IBoardParameterGroup
+{
+public:
+    typedef T value_type;
+
+    IBoardParameterGroup(int h, const std::string& p);
+    ~IBoardParameterGroup() {};
+
+    // Factory method
+    static std::shared_ptr< IBoardParameterGroup > create(int h, const std::string& p);
+
+    // Add a board to the group
+    void addBoard(std::size_t s);
+
+    const std::string& getParam() const { return param;        };
+    const std::string& getDesc()  const { return desc;         };
+    std::size_t        getSize()  const { return slots.size(); };
+
+    const std::vector<uint16_t>& getSlots() const { return slots; };
+
+    // Read the parameter from all the boards in the group, using a single call.
+    // The values are returned in the same order the boards were added.
+    const std::vector<T>& getVals();
+
+private:
+    int                   handle;
+    std::string           param;
+    std::string           desc;
+    std::vector<uint16_t> slots;
+    std::vector<T>        values;
+};
+
+// Class for a system property. System properties can not be read in bulk,
+// so a group contains a single property. It allows system properties to be
+// handled by the poller in the same way as board and channel parameters.
+template<typename P, typename T>
+class ISystemPropertyGroup
+{
+public:
+    typedef T value_type;
+
+    ISystemPropertyGroup(P p);
+    ~ISystemPropertyGroup() {};
+
+    // Factory method
+    static std::shared_ptr< ISystemPropertyGroup > create(P p);
+
+    const std::string& getParam() const { return param; };
+    const std::string& getDesc()  const { return desc;  };
+    std::size_t        getSize()  const { return 1;     };
+
+    // Read the property. The value is returned as a single element vector.
+    const std::vector<T>& getVals();
+
+private:
+    P                     prop;
+    std::string           param;
+    std::string           desc;
+    std::vector<T>        values;
+};
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : post_mortem.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Post-Mortem Class.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "post_mortem.h"
+
+// Identifier at the start of the post-mortem files, followed by a marker used to find the byte order of the file
+static const char     fileMagic[8] = { 'C', 'A', 'E', 'N', 'H', 'V', 'P', 'M' };
+static const uint32_t byteOrderMark = 0x01020304;
+
+// Current time, in seconds since the POSIX epoch
+static double getCurrentTime()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_REALTIME, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Write a value, or an array of values, to a file, in the byte order of the host
+template <typename T>
+static void writeValue(std::ofstream& f, T v)
+{
+    f.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T>
+static void writeArray(std::ofstream& f, const std::vector<T>& v)
+{
+    if ( ! v.empty() )
+        f.write(reinterpret_cast<const char*>(&v.at(0)), v.size() * sizeof(T));
+}
+
+IPostMortem::IPostMortem(const PostMortemConfig& config, const std::string& portName)
+:
+    config(config),
+    portName(portName),
+    numTrips(0),
+    numCaptures(0)
+{
+}
+
+PostMortem IPostMortem::create(const PostMortemConfig& config, const std::string& portName)
+{
+    return std::make_shared<IPostMortem>(config, portName);
+}
+
+bool IPostMortem::trigger(const TripEvent& t)
+{
+    ++numTrips;
+
+    mutex.lock();
+    bool first( pending.empty() );
+    pending.push_back(t);
+    mutex.unlock();
+
+    if ( first )
+        event.signal();
+
+    return first;
+}
+
+void IPostMortem::waitCapture(std::vector<TripEvent>& trips)
+{
+    for (;;)
+    {
+        mutex.lock();
+        bool   found( ! pending.empty() );
+        double due( found ? pending.front().time + config.post : 0 );
+        mutex.unlock();
+
+        if ( found )
+        {
+            // The history after the trip is recorded while waiting
+            double wait( due - getCurrentTime() );
+            if ( wait > 0 )
+                epicsThreadSleep(wait);
+
+            break;
+        }
+
+        event.wait();
+    }
+
+    // The trips found while waiting are part of the same capture
+    mutex.lock();
+    trips.swap(pending);
+    pending.clear();
+    mutex.unlock();
+
+    ++numCaptures;
+}
+
+std::string IPostMortem::getFileName(const TripEvent& t) const
+{
+    time_t    seconds( static_cast<time_t>(t.time) );
+    struct tm local;
+    char      stamp[32];
+
+    localtime_r(&seconds, &local);
+    strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &local);
+
+    std::stringstream name;
+    name << config.path << "/CAENHVAsyn_" << portName << "_postMortem_" << stamp \
+         << "_S" << std::setfill('0') << std::setw(2) << t.slot \
+         << "_C" << std::setfill('0') << std::setw(3) << t.channel << ".bin";
+
+    return name.str();
+}
+
+std::string IPostMortem::write(const Capture& c) const
+{
+    if ( c.trips.empty() )
+        throw std::runtime_error("The capture has no trips");
+
+    std::string fileName( getFileName( c.trips.front() ) );
+
+    // The file is written under a temporary name, so that a partial file is never found with the final name
+    std::string tempName( fileName + ".tmp" );
+
+    std::ofstream f( tempName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( ! f.is_open() )
+        throw std::runtime_error("Could not open the file '" + tempName + "'");
+
+    f.write(fileMagic, sizeof(fileMagic));
+    writeValue<uint32_t>(f, byteOrderMark);
+    writeValue<uint32_t>(f, POST_MORTEM_FILE_VERSION);
+    writeValue<double>(f, c.start);
+    writeValue<double>(f, c.end);
+
+    writeValue<uint32_t>(f, c.trips.size());
+    for (std::vector<TripEvent>::const_iterator it = c.trips.begin(); it != c.trips.end(); ++it)
+    {
+        writeValue<uint32_t>(f, it->slot);
+        writeValue<uint32_t>(f, it->channel);
+        writeValue<uint32_t>(f, it->status);
+        writeValue<double>(f, it->time);
+    }
+
+    writeValue<uint32_t>(f, c.sections.size());
+    for (std::vector<CaptureSection>::const_iterator it = c.sections.begin(); it != c.sections.end(); ++it)
+    {
+        writeValue<uint32_t>(f, it->slot);
+        writeValue<uint32_t>(f, it->param.size());
+        f.write(it->param.data(), it->param.size());
+        writeValue<uint32_t>(f, it->channels.size());
+        writeArray(f, it->channels);
+        writeValue<uint32_t>(f, it->times.size());
+        writeArray(f, it->times);
+        writeArray(f, it->values);
+    }
+
+    f.close();
+    if ( f.fail() )
+    {
+        remove( tempName.c_str() );
+        throw std::runtime_error("Could not write the file '" + tempName + "'");
+    }
+
+    if ( rename( tempName.c_str(), fileName.c_str() ) )
+    {
+        remove( tempName.c_str() );
+        throw std::runtime_error("Could not rename the file '" + tempName + "' to '" + fileName + "'");
+    }
+
+    return fileName;
+}
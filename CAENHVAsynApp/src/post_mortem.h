@@ -0,0 +1,148 @@
+#ifndef POST_MORTEM_H
+#define POST_MORTEM_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : post_mortem.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Post-Mortem Class.
+ * It collects the channel trips detected by the driver, and hands them to the
+ * post-mortem thread once the post-trigger window of the first one has elapsed,
+ * so that the history around the trip can be frozen. Recording a trip never
+ * waits for a capture in progress. It also writes the frozen history to a
+ * binary file.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <epicsThread.h>
+#include <epicsMutex.h>
+#include <epicsEvent.h>
+
+// Channel status bits which mean that a channel has tripped:
+// overcurrent (_OC), overvoltage (_OV), external trip (_ET), and internal trip (_IT)
+#define TRIP_STATUS_MASK (0x0008 | 0x0010 | 0x0040 | 0x0200)
+
+// Version of the post-mortem file format
+#define POST_MORTEM_FILE_VERSION (1)
+
+// Configuration of the post-mortem capture:
+// - enabled   : whether the trips are captured,
+// - path      : directory of the post-mortem files. Empty disables the files,
+// - pre       : length of the window frozen before the trip, in seconds,
+// - post      : length of the window frozen after the trip, in seconds,
+// - crateWide : whether the history of all the boards is frozen, or only the one of the tripped boards.
+struct PostMortemConfig
+{
+    bool        enabled;
+    std::string path;
+    double      pre;
+    double      post;
+    bool        crateWide;
+};
+
+// Default configuration: the post-mortem capture is disabled
+static const PostMortemConfig defaultPostMortemConfig = { false, "", 5.0, 1.0, false };
+
+// Trip of a channel: the status bits that were set, and the time at which they were
+// read, in seconds since the POSIX epoch
+struct TripEvent
+{
+    std::size_t slot;
+    std::size_t channel;
+    uint32_t    status;
+    double      time;
+};
+
+// History of a channel parameter on a board, frozen by a capture. The values contain
+// one row per sample, with one column per channel, in the order of 'channels'.
+struct CaptureSection
+{
+    std::size_t           slot;
+    std::string           param;
+    std::vector<uint16_t> channels;
+    std::vector<double>   times;
+    std::vector<double>   values;
+};
+
+// Post-mortem capture: the trips, the first of which triggered the capture,
+// the frozen window, and the history of each board and parameter in it
+struct Capture
+{
+    double                      start;
+    double                      end;
+    std::vector<TripEvent>      trips;
+    std::vector<CaptureSection> sections;
+};
+
+class IPostMortem;
+
+typedef std::shared_ptr<IPostMortem> PostMortem;
+
+class IPostMortem
+{
+public:
+    IPostMortem(const PostMortemConfig& config, const std::string& portName);
+    ~IPostMortem() {};
+
+    // Factory method
+    static PostMortem create(const PostMortemConfig& config, const std::string& portName);
+
+    // Record a trip. The trips found while a capture is pending are added to it. It returns
+    // true if the trip starts a new capture. It can be called with the port lock held.
+    bool trigger(const TripEvent& t);
+
+    // Wait until a capture is due, that is, until the post-trigger window of its first
+    // trip has elapsed, and take its trips. Called by the post-mortem thread.
+    void waitCapture(std::vector<TripEvent>& trips);
+
+    // Write a capture to a new file in the configured directory. It returns the
+    // name of the file, and throws if it could not be written.
+    std::string write(const Capture& c) const;
+
+    const PostMortemConfig& getConfig() const { return config; };
+
+    // Number of trips recorded, and of captures taken, since the driver started
+    uint64_t getNumTrips()    const { return numTrips.load();    };
+    uint64_t getNumCaptures() const { return numCaptures.load(); };
+
+private:
+    // Name of the file of a capture, from the port name, and the time and channel of its first trip
+    std::string getFileName(const TripEvent& t) const;
+
+    PostMortemConfig       config;
+    std::string            portName;
+
+    std::vector<TripEvent> pending;
+    std::atomic<uint64_t>  numTrips;
+    std::atomic<uint64_t>  numCaptures;
+    epicsMutex             mutex;
+
+    // Signaled when a capture is started
+    epicsEvent             event;
+};
+
+#endif
@@ -0,0 +1,200 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : record_file.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Record File Class.
+ * It collects the records auto-generated for all the parameters of a port,
+ * as a template file and its macros, and writes them expanded to a single
+ * database file, which is then loaded at once. The file is reused on the
+ * next start if the records have not changed.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "record_file.h"
+
+// Header written on the first line of the database file, followed by the fingerprint
+static const std::string fingerprintHeader("# CAENHVAsyn generated records. Fingerprint: ");
+
+// FNV-1a hash, used to compute the fingerprint of the records
+static const uint64_t fnvOffset = 14695981039346656037ULL;
+static const uint64_t fnvPrime  = 1099511628211ULL;
+
+static void hashString(uint64_t& hash, const std::string& s)
+{
+    for (std::string::const_iterator it = s.begin(); it != s.end(); ++it)
+    {
+        hash ^= static_cast<unsigned char>(*it);
+        hash *= fnvPrime;
+    }
+
+    // Separator, so that consecutive strings can not be confused
+    hash ^= 0xFF;
+    hash *= fnvPrime;
+}
+
+IRecordFile::IRecordFile(const std::string& f)
+:
+    fileName(f)
+{
+}
+
+RecordFile IRecordFile::create(const std::string& f)
+{
+    return std::make_shared<IRecordFile>(f);
+}
+
+void IRecordFile::add(const std::string& templateFile, const std::string& macros)
+{
+    records.push_back( std::make_pair(templateFile, macros) );
+}
+
+const std::string& IRecordFile::getTemplate(const std::string& templateFile)
+{
+    std::map<std::string, std::string>::const_iterator it = templates.find(templateFile);
+    if ( it != templates.end() )
+        return it->second;
+
+    std::ifstream file(templateFile.c_str());
+
+    if ( ! file.is_open() )
+        throw std::runtime_error("Could not open the template file '" + templateFile + "'");
+
+    std::stringstream text;
+    text << file.rdbuf();
+
+    return templates.insert( std::make_pair(templateFile, text.str()) ).first->second;
+}
+
+uint64_t IRecordFile::getFingerprint()
+{
+    uint64_t hash(fnvOffset);
+
+    for (std::vector< std::pair<std::string, std::string> >::const_iterator it = records.begin(); it != records.end(); ++it)
+    {
+        hashString(hash, it->first);
+        hashString(hash, it->second);
+    }
+
+    // Changes in the templates must also invalidate the file
+    for (std::vector< std::pair<std::string, std::string> >::const_iterator it = records.begin(); it != records.end(); ++it)
+        getTemplate(it->first);
+
+    for (std::map<std::string, std::string>::const_iterator it = templates.begin(); it != templates.end(); ++it)
+    {
+        hashString(hash, it->first);
+        hashString(hash, it->second);
+    }
+
+    return hash;
+}
+
+bool IRecordFile::readFingerprint(uint64_t& fingerprint) const
+{
+    std::ifstream file(fileName.c_str());
+
+    if ( ! file.is_open() )
+        return false;
+
+    std::string line;
+    if ( ( ! std::getline(file, line) ) || ( line.compare(0, fingerprintHeader.size(), fingerprintHeader) ) )
+        return false;
+
+    char *end;
+    std::string value( line.substr(fingerprintHeader.size()) );
+    fingerprint = strtoull(value.c_str(), &end, 16);
+
+    return ( ( ! value.empty() ) && ( *end == '\0' ) );
+}
+
+std::string IRecordFile::expand(MAC_HANDLE* handle, const std::string& text, const std::string& macros)
+{
+    // Define the macros of this record on a new scope, as dbLoadRecords does
+    char **pairs;
+    macPushScope(handle);
+    if ( macParseDefns(handle, macros.c_str(), &pairs) >= 0 )
+    {
+        macInstallMacros(handle, pairs);
+        free(pairs);
+    }
+
+    // The expanded string can be larger than the template
+    std::vector<char> dest(2 * text.size() + 1);
+    for (;;)
+    {
+        long n( labs( macExpandString(handle, text.c_str(), &dest.at(0), dest.size()) ) );
+
+        if ( n < static_cast<long>(dest.size()) - 1 )
+            break;
+
+        dest.resize(2 * dest.size());
+    }
+
+    macPopScope(handle);
+
+    return std::string(&dest.at(0));
+}
+
+void IRecordFile::write(uint64_t fingerprint)
+{
+    MAC_HANDLE* handle;
+    if ( macCreateHandle(&handle, NULL) )
+        throw std::runtime_error("Could not create the macro handle to expand the records");
+
+    // Write to a temporary file first, so that an interrupted write doesn't leave a truncated file
+    std::string   tempFileName(fileName + ".tmp");
+    std::ofstream file(tempFileName.c_str());
+
+    if ( ! file.is_open() )
+    {
+        macDeleteHandle(handle);
+        throw std::runtime_error("Could not open the record file '" + tempFileName + "'");
+    }
+
+    file << fingerprintHeader << std::hex << fingerprint << std::dec << std::endl;
+    file << "# Delete this file to force the generation of the records." << std::endl;
+
+    for (std::vector< std::pair<std::string, std::string> >::const_iterator it = records.begin(); it != records.end(); ++it)
+        file << expand(handle, getTemplate(it->first), it->second);
+
+    macDeleteHandle(handle);
+
+    file.close();
+
+    if ( file.fail() )
+        throw std::runtime_error("Error while writing the record file '" + tempFileName + "'");
+
+    if ( rename(tempFileName.c_str(), fileName.c_str()) )
+        throw std::runtime_error("Could not rename the record file '" + tempFileName + "' to '" + fileName + "'");
+}
+
+bool IRecordFile::load()
+{
+    if ( records.empty() )
+        return false;
+
+    uint64_t fingerprint( getFingerprint() );
+    uint64_t fileFingerprint;
+
+    bool reused( readFingerprint(fileFingerprint) && ( fileFingerprint == fingerprint ) );
+
+    if ( ! reused )
+        write(fingerprint);
+
+    if ( dbLoadRecords(fileName.c_str(), NULL) )
+        throw std::runtime_error("Error while loading the record file '" + fileName + "'");
+
+    return reused;
+}
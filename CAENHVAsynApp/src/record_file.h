@@ -0,0 +1,91 @@
+#ifndef RECORD_FILE_H
+#define RECORD_FILE_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : record_file.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Record File Class.
+ * It collects the records auto-generated for all the parameters of a port,
+ * as a template file and its macros, and writes them expanded to a single
+ * database file, which is then loaded at once. The file is reused on the
+ * next start if the records have not changed.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <map>
+#include <memory>
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+#include <iostream>
+#include <fstream>
+#include <macLib.h>
+#include <dbAccess.h>
+
+class IRecordFile;
+
+typedef std::shared_ptr<IRecordFile> RecordFile;
+
+class IRecordFile
+{
+public:
+    IRecordFile(const std::string& f);
+    ~IRecordFile() {};
+
+    // Factory method
+    static RecordFile create(const std::string& f);
+
+    // Add a record, defined by a template file and the macros used to expand it,
+    // with the same format used by dbLoadRecords
+    void add(const std::string& templateFile, const std::string& macros);
+
+    // Load all the records. The database file is written first, unless it exists
+    // and was generated from the same templates and macros. It returns true if
+    // an existing file was reused.
+    bool load();
+
+    std::size_t        getSize()     const { return records.size(); };
+    const std::string& getFileName() const { return fileName;       };
+
+private:
+    // Read a template file. Each template is read only once.
+    const std::string& getTemplate(const std::string& templateFile);
+
+    // Get the fingerprint of the records, including the content of the templates
+    uint64_t getFingerprint();
+
+    // Read the fingerprint written on an existing database file
+    bool readFingerprint(uint64_t& fingerprint) const;
+
+    // Write the database file, with all the records expanded
+    void write(uint64_t fingerprint);
+
+    // Expand the macros of a template
+    static std::string expand(MAC_HANDLE* handle, const std::string& text, const std::string& macros);
+
+    std::string                                       fileName;
+    std::vector< std::pair<std::string, std::string> > records;
+    std::map<std::string, std::string>                templates;
+};
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : scan_class.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Scan Class List.
+ * A scan class defines the period at which a set of parameters, selected by
+ * their names, is read by the parameter poller.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "scan_class.h"
+
+IScanClassList::IScanClassList(const std::string& fileName)
+{
+    std::ifstream file(fileName.c_str());
+
+    if ( ! file.is_open() )
+        throw std::runtime_error("Could not open file '" + fileName + "'");
+
+    // Each line contains the scan class name, its period in seconds, and
+    // a list of parameter name patterns. Empty lines and comments are skipped.
+    std::string line;
+    std::size_t lineNumber(0);
+    while ( std::getline(file, line) )
+    {
+        ++lineNumber;
+
+        std::size_t comment( line.find('#') );
+        if ( comment != std::string::npos )
+            line.erase(comment);
+
+        std::istringstream iss(line);
+        ScanClass c;
+
+        if ( ! ( iss >> c.name ) )
+            continue;
+
+        std::stringstream error;
+        error << "File '" << fileName << "', line " << lineNumber << ": ";
+
+        if ( ( ! ( iss >> c.period ) ) || ( c.period < 0 ) )
+        {
+            error << "invalid period for scan class '" << c.name << "'";
+            throw std::runtime_error(error.str());
+        }
+
+        std::string pattern;
+        while ( iss >> pattern )
+            c.patterns.push_back(pattern);
+
+        if ( c.patterns.empty() )
+        {
+            error << "no parameters defined for scan class '" << c.name << "'";
+            throw std::runtime_error(error.str());
+        }
+
+        classes.push_back(c);
+    }
+}
+
+ScanClassList IScanClassList::create(const std::string& fileName)
+{
+    return std::make_shared<IScanClassList>(fileName);
+}
+
+int IScanClassList::find(const std::string& param) const
+{
+    for (std::size_t i(0); i < classes.size(); ++i)
+        for (std::vector<std::string>::const_iterator it = classes.at(i).patterns.begin(); it != classes.at(i).patterns.end(); ++it)
+            if ( epicsStrGlobMatch(param.c_str(), it->c_str()) )
+                return i;
+
+    return -1;
+}
+
+void IScanClassList::printInfo(std::ostream& stream) const
+{
+    for (std::vector<ScanClass>::const_iterator it = classes.begin(); it != classes.end(); ++it)
+    {
+        stream << "    " << it->name << ": ";
+
+        if ( it->period > 0 )
+            stream << it->period << " s";
+        else
+            stream << "once";
+
+        stream << " (";
+        for (std::vector<std::string>::const_iterator pIt = it->patterns.begin(); pIt != it->patterns.end(); ++pIt)
+        {
+            if ( pIt != it->patterns.begin() )
+                stream << " ";
+            stream << *pIt;
+        }
+        stream << ")" << std::endl;
+    }
+}
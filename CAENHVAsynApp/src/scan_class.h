@@ -0,0 +1,70 @@
+#ifndef SCAN_CLASS_H
+#define SCAN_CLASS_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : scan_class.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Scan Class List.
+ * A scan class defines the period at which a set of parameters, selected by
+ * their names, is read by the parameter poller.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <iostream>
+#include <epicsString.h>
+
+class IScanClassList;
+
+typedef std::shared_ptr<IScanClassList> ScanClassList;
+
+// Scan class. A period of zero means that the parameters are read only once.
+struct ScanClass
+{
+    std::string              name;
+    double                   period;
+    std::vector<std::string> patterns;
+};
+
+class IScanClassList
+{
+public:
+    IScanClassList(const std::string& fileName);
+    ~IScanClassList() {};
+
+    // Factory method
+    static ScanClassList create(const std::string& fileName);
+
+    // Find the first scan class with a pattern matching the parameter name.
+    // It returns the index of the scan class, or -1 if none was found.
+    int find(const std::string& param) const;
+
+    std::size_t      size()            const { return classes.size(); };
+    const ScanClass& at(std::size_t i) const { return classes.at(i);  };
+
+    void printInfo(std::ostream& stream) const;
+
+private:
+    std::vector<ScanClass> classes;
+};
+
+#endif
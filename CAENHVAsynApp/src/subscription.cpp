@@ -0,0 +1,119 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : subscription.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Event Subscription Class.
+ * It subscribes to changes of board and channel parameters, and retrieves
+ * the events pushed by the crate.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "subscription.h"
+
+ISubscription::ISubscription(int h, unsigned short p)
+:
+    handle(h),
+    port(p)
+{
+}
+
+Subscription ISubscription::create(int h, unsigned short p)
+{
+    return std::make_shared<ISubscription>(h, p);
+}
+
+std::string ISubscription::makeParamList(const std::vector<std::string>& params)
+{
+    // The parameter names are separated by colons
+    std::string list;
+    for (std::vector<std::string>::const_iterator it = params.begin(); it != params.end(); ++it)
+    {
+        if ( it != params.begin() )
+            list += ":";
+        list += *it;
+    }
+
+    return list;
+}
+
+std::vector<bool> ISubscription::subscribeChannelParams(std::size_t s, std::size_t c, const std::vector<std::string>& params) const
+{
+    std::vector<bool> ret(params.size(), false);
+
+    if ( params.empty() )
+        return ret;
+
+    std::string       list( makeParamList(params) );
+    std::vector<char> codes(params.size(), 0);
+
+    if ( linkCall(WIRE_SUBSCRIBE_CH_PARAMS, handle, [&](int libHandle) { return CAENHV_SubscribeChannelParams(libHandle, port, s, c, list.c_str(), params.size(), &codes.at(0)); }) != CAENHV_OK )
+        return ret;
+
+    for (std::size_t i(0); i < params.size(); ++i)
+        ret.at(i) = ( codes.at(i) == CAENHV_OK );
+
+    return ret;
+}
+
+std::vector<bool> ISubscription::subscribeBoardParams(std::size_t s, const std::vector<std::string>& params) const
+{
+    std::vector<bool> ret(params.size(), false);
+
+    if ( params.empty() )
+        return ret;
+
+    std::string       list( makeParamList(params) );
+    std::vector<char> codes(params.size(), 0);
+
+    if ( linkCall(WIRE_SUBSCRIBE_BD_PARAMS, handle, [&](int libHandle) { return CAENHV_SubscribeBoardParams(libHandle, port, s, list.c_str(), params.size(), &codes.at(0)); }) != CAENHV_OK )
+        return ret;
+
+    for (std::size_t i(0); i < params.size(); ++i)
+        ret.at(i) = ( codes.at(i) == CAENHV_OK );
+
+    return ret;
+}
+
+void ISubscription::getEvents(std::vector<ParameterEvent>& events) const
+{
+    events.clear();
+
+    CAENHV_SYSTEMSTATUS_t status;
+    CAENHVEVENT_TYPE_t    *data = NULL;
+    unsigned int          num(0);
+
+    if ( linkCall(WIRE_GET_EVENT_DATA, handle, [&](int libHandle) { return CAENHV_GetEventData(libHandle, &status, &data, &num); }) != CAENHV_OK )
+        throw std::runtime_error("CAENHV_GetEventData failed: " + std::string(linkError(handle)));
+
+    events.reserve(num);
+    for (std::size_t i(0); i < num; ++i)
+    {
+        // Only parameter change events are of interest. Keep-alive and alarm events are discarded.
+        if ( data[i].Type != PARAMETER )
+            continue;
+
+        ParameterEvent e;
+        e.slot       = data[i].BoardIndex;
+        e.channel    = data[i].ChannelIndex;
+        e.param      = data[i].ItemID;
+        e.floatValue = data[i].Value.FloatValue;
+        e.intValue   = data[i].Value.IntValue;
+        events.push_back(e);
+    }
+
+    if ( data )
+        CAENHV_FreeEventData(&data);
+}
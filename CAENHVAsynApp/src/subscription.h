@@ -0,0 +1,83 @@
+#ifndef SUBSCRIPTION_H
+#define SUBSCRIPTION_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : subscription.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Event Subscription Class.
+ * It subscribes to changes of board and channel parameters, and retrieves
+ * the events pushed by the crate.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <memory>
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+#include <iostream>
+
+#include "CAENHVWrapper.h"
+#include "common.h"
+#include "crate_link.h"
+
+class ISubscription;
+
+typedef std::shared_ptr<ISubscription> Subscription;
+
+// Parameter change event received from the crate.
+// For board parameters, the channel number is -1.
+struct ParameterEvent
+{
+    int         slot;
+    int         channel;
+    std::string param;
+    float       floatValue;
+    int32_t     intValue;
+};
+
+class ISubscription
+{
+public:
+    ISubscription(int h, unsigned short p);
+    ~ISubscription() {};
+
+    // Factory method
+    static Subscription create(int h, unsigned short p);
+
+    // Subscribe to a list of parameters of a channel, or of a board. They return,
+    // for each parameter, whether the subscription was accepted by the crate.
+    std::vector<bool> subscribeChannelParams(std::size_t s, std::size_t c, const std::vector<std::string>& params) const;
+    std::vector<bool> subscribeBoardParams(std::size_t s, const std::vector<std::string>& params) const;
+
+    // Get the parameter change events received since the last call
+    void getEvents(std::vector<ParameterEvent>& events) const;
+
+private:
+    // Build the list of parameter names, in the format expected by the subscription functions
+    static std::string makeParamList(const std::vector<std::string>& params);
+
+    int            handle;
+    unsigned short port;
+};
+
+#endif
@@ -79,10 +79,10 @@ std::string ISystemPropertyString::getVal() const
 
     char temp[4096];
 
-    CAENHVRESULT r = CAENHV_GetSysProp(handle, prop.c_str(), temp);
+    CAENHVRESULT r = linkCall(WIRE_GET_SYS_PROP, handle, [&](int libHandle) { return CAENHV_GetSysProp(libHandle, prop.c_str(), temp); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
-        throw std::runtime_error("CAENHV_GetSysProp failed: " + std::string(CAENHV_GetError(handle)));
+        throw std::runtime_error("CAENHV_GetSysProp failed: " + std::string(linkError(handle)));
 
     return temp;
 }
@@ -96,10 +96,10 @@ void ISystemPropertyString::setVal(const std::string& v) const
     char temp[v.size() + 1];
     strcpy(temp, v.c_str());
 
-    CAENHVRESULT r = CAENHV_SetSysProp(handle, prop.c_str(), temp);
+    CAENHVRESULT r = linkCall(WIRE_SET_SYS_PROP, handle, [&](int libHandle) { return CAENHV_SetSysProp(libHandle, prop.c_str(), temp); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
-        throw std::runtime_error("CAENHV_SetSysProp failed: " + std::string(CAENHV_GetError(handle)));
+        throw std::runtime_error("CAENHV_SetSysProp failed: " + std::string(linkError(handle)));
 }
 
 // Float class
@@ -121,10 +121,10 @@ float ISystemPropertyFloat::getVal() const
 
     float temp;
 
-    CAENHVRESULT r = CAENHV_GetSysProp(handle, prop.c_str(), &temp);
+    CAENHVRESULT r = linkCall(WIRE_GET_SYS_PROP, handle, [&](int libHandle) { return CAENHV_GetSysProp(libHandle, prop.c_str(), &temp); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
-        throw std::runtime_error("CAENHV_GetSysProp failed: " + std::string(CAENHV_GetError(handle)));
+        throw std::runtime_error("CAENHV_GetSysProp failed: " + std::string(linkError(handle)));
 
     return temp;
 }
@@ -134,10 +134,10 @@ void ISystemPropertyFloat::setVal(float v) const
     if (mode == SYSPROP_MODE_RDONLY)
         return;
 
-    CAENHVRESULT r = CAENHV_SetSysProp(handle, prop.c_str(), &v);
+    CAENHVRESULT r = linkCall(WIRE_SET_SYS_PROP, handle, [&](int libHandle) { return CAENHV_SetSysProp(libHandle, prop.c_str(), &v); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
-        throw std::runtime_error("CAENHV_SetSysProp failed: " + std::string(CAENHV_GetError(handle)));
+        throw std::runtime_error("CAENHV_SetSysProp failed: " + std::string(linkError(handle)));
 }
 
 // Integer class template
@@ -155,10 +155,10 @@ int32_t ISystemPropertyIntegerTemplate<T>::getVal() const
 
     T temp;
 
-    CAENHVRESULT r = CAENHV_GetSysProp(handle, prop.c_str(), &temp);
+    CAENHVRESULT r = linkCall(WIRE_GET_SYS_PROP, handle, [&](int libHandle) { return CAENHV_GetSysProp(libHandle, prop.c_str(), &temp); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
-        throw std::runtime_error("CAENHV_GetSysProp failed: " + std::string(CAENHV_GetError(handle)));
+        throw std::runtime_error("CAENHV_GetSysProp failed: " + std::string(linkError(handle)));
 
     return static_cast<int32_t>(temp);
 }
@@ -170,10 +170,10 @@ void ISystemPropertyIntegerTemplate<T>::setVal(int32_t value) const
         return;
 
     T temp = static_cast<T>(value);
-    CAENHVRESULT r = CAENHV_SetSysProp(handle, prop.c_str(), &temp);
+    CAENHVRESULT r = linkCall(WIRE_SET_SYS_PROP, handle, [&](int libHandle) { return CAENHV_SetSysProp(libHandle, prop.c_str(), &temp); });
 
     if ( r != CAENHV_OK && r != CAENHV_GETPROPNOTIMPL && r != CAENHV_NOTGETPROP )
-        throw std::runtime_error("CAENHV_SetSysProp failed: " + std::string(CAENHV_GetError(handle)));
+        throw std::runtime_error("CAENHV_SetSysProp failed: " + std::string(linkError(handle)));
 }
 
 template class ISystemPropertyIntegerTemplate<uint32_t>;
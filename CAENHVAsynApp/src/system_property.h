@@ -39,6 +39,7 @@
 
 #include "CAENHVWrapper.h"
 #include "common.h"
+#include "crate_link.h"
 
 class ISystemPropertyInteger;
 class ISystemPropertyFloat;
@@ -55,6 +56,7 @@ public:
     virtual ~SystemPropertyBase() {};
 
     std::string getMode()            { return modeStr;    };
+    std::string getProp()            { return prop;       };
     std::string getEpicsParamName()  { return epicsParamName;  };
     std::string getEpicsRecordName() { return epicsRecordName; };
     std::string getEpicsDesc()       { return epicsDesc;       };
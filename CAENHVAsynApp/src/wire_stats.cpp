@@ -0,0 +1,209 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : wire_stats.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Statistics of the calls made to the CAEN HV Wrapper library.
+ * All the calls are made through 'wireCall', which measures their latency and
+ * records it, together with the returned code, on the statistics of the type
+ * of call. The statistics are updated without locks. Each crate link keeps its
+ * own statistics.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <math.h>
+#include "wire_stats.h"
+
+static const char* wireCallNames[NUM_WIRE_CALLS] =
+{
+    "InitSystem",
+    "GetSysPropList",
+    "GetSysPropInfo",
+    "GetCrateMap",
+    "GetBdParamInfo",
+    "GetBdParamProp",
+    "GetChParamInfo",
+    "GetChParamProp",
+    "GetSysProp",
+    "SetSysProp",
+    "GetBdParam",
+    "SetBdParam",
+    "GetChParam",
+    "SetChParam",
+    "SubscribeChannelParams",
+    "SubscribeBoardParams",
+    "GetEventData"
+};
+
+void WireCallStats::record(uint64_t ns, CAENHVRESULT r)
+{
+    totalNs.fetch_add(ns, std::memory_order_relaxed);
+    buckets[getBucket(ns)].fetch_add(1, std::memory_order_relaxed);
+    codes[getCodeSlot(r)].fetch_add(1, std::memory_order_relaxed);
+
+    if ( r != CAENHV_OK )
+        errors.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t m( maxNs.load(std::memory_order_relaxed) );
+    while ( ( ns > m ) && ( ! maxNs.compare_exchange_weak(m, ns, std::memory_order_relaxed) ) );
+}
+
+WireCallSummary WireCallStats::getSummary() const
+{
+    WireCallSummary s;
+
+    std::vector<uint64_t> b(numBuckets);
+    uint64_t              n(0);
+    for (std::size_t i(0); i < numBuckets; ++i)
+    {
+        b.at(i) = buckets[i].load(std::memory_order_relaxed);
+        n += b.at(i);
+    }
+
+    // The counters are not updated together, so the histogram is used as the call count
+    s.count  = n;
+    s.errors = errors.load(std::memory_order_relaxed);
+    s.mean   = n ? ( 1e-6 * totalNs.load(std::memory_order_relaxed) / n ) : 0;
+    s.max    = 1e-6 * maxNs.load(std::memory_order_relaxed);
+    s.p50    = getPercentile(b, n, 0.50);
+    s.p99    = getPercentile(b, n, 0.99);
+
+    // The estimated percentiles can not be larger than the maximum
+    s.p50 = std::min(s.p50, s.max);
+    s.p99 = std::min(s.p99, s.max);
+
+    for (std::size_t i(0); i < numCodes; ++i)
+    {
+        uint64_t c( codes[i].load(std::memory_order_relaxed) );
+        if ( ( i != CAENHV_OK ) && ( c > 0 ) )
+            s.errorCodes.push_back( std::make_pair(getCodeName(i), c) );
+    }
+
+    return s;
+}
+
+void WireCallStats::reset()
+{
+    errors.store(0, std::memory_order_relaxed);
+    totalNs.store(0, std::memory_order_relaxed);
+    maxNs.store(0, std::memory_order_relaxed);
+
+    for (std::size_t i(0); i < numBuckets; ++i)
+        buckets[i].store(0, std::memory_order_relaxed);
+
+    for (std::size_t i(0); i < numCodes; ++i)
+        codes[i].store(0, std::memory_order_relaxed);
+}
+
+std::size_t WireCallStats::getBucket(uint64_t ns)
+{
+    if ( ns < 1000 )
+        return 0;
+
+    std::size_t b( 1 + static_cast<std::size_t>( bucketsPerOctave * log2(ns / 1000.0) ) );
+
+    return std::min(b, numBuckets - 1);
+}
+
+double WireCallStats::getBucketLimit(std::size_t bucket)
+{
+    // Upper limit of the bucket, in milliseconds
+    return 1e-3 * pow(2.0, static_cast<double>(bucket) / bucketsPerOctave);
+}
+
+std::size_t WireCallStats::getCodeSlot(CAENHVRESULT r)
+{
+    if ( ( r >= 0 ) && ( r < 64 ) )
+        return r;
+
+    if ( ( r >= 0x1000 ) && ( r < 0x1010 ) )
+        return 64 + ( r - 0x1000 );
+
+    return numCodes - 1;
+}
+
+std::string WireCallStats::getCodeName(std::size_t slot)
+{
+    std::stringstream temp;
+
+    if ( slot < 64 )
+        temp << slot;
+    else if ( slot < numCodes - 1 )
+        temp << "0x" << std::hex << ( 0x1000 + slot - 64 );
+    else
+        temp << "other";
+
+    return temp.str();
+}
+
+double WireCallStats::getPercentile(const std::vector<uint64_t>& b, uint64_t n, double q) const
+{
+    if ( n == 0 )
+        return 0;
+
+    // Number of calls at or below the percentile
+    uint64_t target( static_cast<uint64_t>( ceil(q * n) ) );
+    uint64_t acc(0);
+
+    for (std::size_t i(0); i < b.size(); ++i)
+    {
+        acc += b.at(i);
+        if ( acc >= target )
+            return getBucketLimit(i);
+    }
+
+    return getBucketLimit(b.size() - 1);
+}
+
+std::string getWireCallName(wireCall_t type)
+{
+    return wireCallNames[type];
+}
+
+void WireStats::print(std::ostream& stream, const std::string& title, int level) const
+{
+    stream << "==============================================================================================" << std::endl;
+    stream << title << ": CAEN HV Wrapper library calls (times in ms):" << std::endl;
+    stream << "==============================================================================================" << std::endl;
+    stream << std::left  << std::setw(24) << "Call" << std::right \
+           << std::setw(12) << "Count" << std::setw(10) << "Errors" \
+           << std::setw(12) << "Mean" << std::setw(12) << "p50" << std::setw(12) << "p99" << std::setw(12) << "Max" << std::endl;
+    stream << "----------------------------------------------------------------------------------------------" << std::endl;
+
+    stream << std::fixed << std::setprecision(3);
+    for (std::size_t i(0); i < NUM_WIRE_CALLS; ++i)
+    {
+        wireCall_t      type( static_cast<wireCall_t>(i) );
+        WireCallSummary s( get(type).getSummary() );
+
+        stream << std::left  << std::setw(24) << getWireCallName(type) << std::right \
+               << std::setw(12) << s.count << std::setw(10) << s.errors \
+               << std::setw(12) << s.mean  << std::setw(12) << s.p50 << std::setw(12) << s.p99 << std::setw(12) << s.max << std::endl;
+
+        if ( level > 0 )
+            for (std::vector< std::pair<std::string, uint64_t> >::const_iterator it = s.errorCodes.begin(); it != s.errorCodes.end(); ++it)
+                stream << "    Error code " << it->first << " : " << it->second << " calls" << std::endl;
+    }
+    stream.unsetf(std::ios_base::floatfield);
+    stream << std::setprecision(6);
+
+    stream << "==============================================================================================" << std::endl;
+}
+
+void WireStats::reset()
+{
+    for (std::size_t i(0); i < NUM_WIRE_CALLS; ++i)
+        calls[i].reset();
+}
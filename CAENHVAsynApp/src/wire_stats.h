@@ -0,0 +1,149 @@
+#ifndef WIRE_STATS_H
+#define WIRE_STATS_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : wire_stats.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Statistics of the calls made to the CAEN HV Wrapper library.
+ * All the calls are made through 'wireCall', which measures their latency and
+ * records it, together with the returned code, on the statistics of the type
+ * of call. The statistics are updated without locks. Each crate link keeps its
+ * own statistics.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+#include "CAENHVWrapper.h"
+
+// Types of calls to the CAEN HV Wrapper library
+enum wireCall_t
+{
+    WIRE_INIT_SYSTEM,
+    WIRE_GET_SYS_PROP_LIST,
+    WIRE_GET_SYS_PROP_INFO,
+    WIRE_GET_CRATE_MAP,
+    WIRE_GET_BD_PARAM_INFO,
+    WIRE_GET_BD_PARAM_PROP,
+    WIRE_GET_CH_PARAM_INFO,
+    WIRE_GET_CH_PARAM_PROP,
+    WIRE_GET_SYS_PROP,
+    WIRE_SET_SYS_PROP,
+    WIRE_GET_BD_PARAM,
+    WIRE_SET_BD_PARAM,
+    WIRE_GET_CH_PARAM,
+    WIRE_SET_CH_PARAM,
+    WIRE_SUBSCRIBE_CH_PARAMS,
+    WIRE_SUBSCRIBE_BD_PARAMS,
+    WIRE_GET_EVENT_DATA,
+    NUM_WIRE_CALLS
+};
+
+// Summary of the statistics of a type of call. Times are in milliseconds.
+// The percentiles are estimated from the histogram, with a resolution of about 20%.
+struct WireCallSummary
+{
+    uint64_t count;
+    uint64_t errors;
+    double   mean;
+    double   p50;
+    double   p99;
+    double   max;
+
+    // Number of calls which returned each error code
+    std::vector< std::pair<std::string, uint64_t> > errorCodes;
+};
+
+// Statistics of a type of call
+class WireCallStats
+{
+public:
+    WireCallStats() { reset(); };
+
+    // Record a call, with its duration in nanoseconds, and its returned code
+    void record(uint64_t ns, CAENHVRESULT r);
+
+    WireCallSummary getSummary() const;
+
+    void reset();
+
+    // Latency histogram: bucket 0 holds the calls shorter than 1 us, and
+    // each following bucket covers a quarter of an octave, up to ~134 s.
+    static const std::size_t bucketsPerOctave = 4;
+    static const std::size_t numBuckets       = 1 + bucketsPerOctave * 27;
+
+    // Returned codes: 0 to 63, 0x1000 to 0x100F, and all other codes in the last slot
+    static const std::size_t numCodes = 64 + 16 + 1;
+
+private:
+    static std::size_t getBucket(uint64_t ns);
+    static double      getBucketLimit(std::size_t bucket);
+    static std::size_t getCodeSlot(CAENHVRESULT r);
+    static std::string getCodeName(std::size_t slot);
+
+    double getPercentile(const std::vector<uint64_t>& buckets, uint64_t count, double q) const;
+
+    std::atomic<uint64_t> errors;
+    std::atomic<uint64_t> totalNs;
+    std::atomic<uint64_t> maxNs;
+    std::atomic<uint64_t> buckets[numBuckets];
+    std::atomic<uint64_t> codes[numCodes];
+};
+
+// Statistics of all the types of calls made on a crate
+class WireStats
+{
+public:
+    // Get the statistics of a type of call
+    WireCallStats&       get(wireCall_t type)       { return calls[type]; };
+    const WireCallStats& get(wireCall_t type) const { return calls[type]; };
+
+    // Print the statistics of all the types of calls, under a title.
+    // With level > 0, the error codes are also printed.
+    void print(std::ostream& stream, const std::string& title, int level) const;
+
+    // Reset the statistics of all the types of calls
+    void reset();
+
+private:
+    WireCallStats calls[NUM_WIRE_CALLS];
+};
+
+// Get the name of a type of call. It is the name of the wrapper library function.
+std::string getWireCallName(wireCall_t type);
+
+// Make a call to the CAEN HV Wrapper library, and record it in the statistics of its type
+template <typename F>
+CAENHVRESULT wireCall(WireStats& stats, wireCall_t type, F f)
+{
+    std::chrono::steady_clock::time_point start( std::chrono::steady_clock::now() );
+    CAENHVRESULT r( f() );
+    std::chrono::steady_clock::duration d( std::chrono::steady_clock::now() - start );
+
+    stats.get(type).record(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count(), r);
+
+    return r;
+}
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : work_pool.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Bounded worker pool, used to run independent jobs in parallel.
+ * Each job is identified by its index, so the callers can store the results
+ * in a pre-allocated vector and keep a deterministic ordering.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "work_pool.h"
+
+// C wrapper for the worker threads
+static void workerTaskC(void *pvt)
+{
+    IWorkPool *pPvt = (IWorkPool *)pvt;
+    pPvt->workerTask();
+}
+
+IWorkPool::IWorkPool(const std::string& n, std::size_t w)
+:
+    name(n),
+    numWorkers( w ? w : 1 ),
+    numJobs(0),
+    nextJob(0),
+    numRunning(0)
+{
+}
+
+WorkPool IWorkPool::create(const std::string& n, std::size_t w)
+{
+    return std::make_shared<IWorkPool>(n, w);
+}
+
+void IWorkPool::run(std::size_t n, std::function<void(std::size_t)> j)
+{
+    job     = j;
+    numJobs = n;
+    nextJob = 0;
+    errors.assign(n, std::string());
+
+    std::size_t numThreads( std::min(numWorkers, numJobs) );
+
+    if ( numThreads <= 1 )
+    {
+        // Run the jobs in the calling thread
+        workerTask();
+    }
+    else
+    {
+        numRunning = numThreads;
+
+        for (std::size_t i(0); i < numThreads; ++i)
+        {
+            std::stringstream threadName;
+            threadName << name << i;
+
+            epicsThreadId id = epicsThreadCreate(threadName.str().c_str(),
+                                                 epicsThreadPriorityMedium,
+                                                 epicsThreadGetStackSize(epicsThreadStackMedium),
+                                                 (EPICSTHREADFUNC)workerTaskC,
+                                                 this);
+
+            // If the thread could not be created, its share of the jobs is done by the other workers
+            if ( ! id )
+            {
+                mutex.lock();
+                --numRunning;
+                mutex.unlock();
+            }
+        }
+
+        // Wait for all the workers. If no thread could be created, run the jobs here.
+        mutex.lock();
+        bool wait( numRunning > 0 );
+        mutex.unlock();
+
+        if ( wait )
+            done.wait();
+        else
+            workerTask();
+    }
+
+    job = std::function<void(std::size_t)>();
+
+    for (std::vector<std::string>::const_iterator it = errors.begin(); it != errors.end(); ++it)
+    {
+        if ( ! it->empty() )
+            throw std::runtime_error(*it);
+    }
+}
+
+void IWorkPool::workerTask()
+{
+    for (;;)
+    {
+        mutex.lock();
+        if ( nextJob >= numJobs )
+        {
+            mutex.unlock();
+            break;
+        }
+        std::size_t i( nextJob++ );
+        mutex.unlock();
+
+        try
+        {
+            job(i);
+        }
+        catch(std::exception& e)
+        {
+            // Each job has its own error slot
+            errors.at(i) = e.what();
+        }
+    }
+
+    // The last worker to finish wakes up the caller
+    mutex.lock();
+    if ( ( numRunning > 0 ) && ( --numRunning == 0 ) )
+        done.signal();
+    mutex.unlock();
+}
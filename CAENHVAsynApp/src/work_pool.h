@@ -0,0 +1,76 @@
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : work_pool.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Bounded worker pool, used to run independent jobs in parallel.
+ * Each job is identified by its index, so the callers can store the results
+ * in a pre-allocated vector and keep a deterministic ordering.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <epicsThread.h>
+#include <epicsMutex.h>
+#include <epicsEvent.h>
+
+class IWorkPool;
+
+typedef std::shared_ptr<IWorkPool> WorkPool;
+
+class IWorkPool
+{
+public:
+    IWorkPool(const std::string& n, std::size_t w);
+    ~IWorkPool() {};
+
+    // Factory method
+    static WorkPool create(const std::string& n, std::size_t w);
+
+    // Run the jobs 0 to 'numJobs - 1', and wait until all of them are done.
+    // With a single worker, the jobs are run in sequence in the calling thread.
+    // All the jobs are run, and if any of them failed, an exception is thrown
+    // at the end with the error of the job with the lowest index.
+    void run(std::size_t numJobs, std::function<void(std::size_t)> job);
+
+    std::size_t getNumWorkers() const { return numWorkers; };
+
+    // Worker thread main loop
+    void workerTask();
+
+private:
+    std::string                       name;
+    std::size_t                       numWorkers;
+
+    // State of the current run
+    std::function<void(std::size_t)>  job;
+    std::size_t                       numJobs;
+    std::size_t                       nextJob;
+    std::size_t                       numRunning;
+    std::vector<std::string>          errors;
+    epicsMutex                        mutex;
+    epicsEvent                        done;
+};
+
+#endif
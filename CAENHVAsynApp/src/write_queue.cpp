@@ -0,0 +1,155 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : write_queue.cpp
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Write Queue Class.
+ * It gathers pending writes to channel parameters, and sends the writes of
+ * the same value to the same parameter on several channels of a board with
+ * a single call to the crate.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include "write_queue.h"
+
+IWriteQueue::IWriteQueue(int h)
+:
+    handle(h),
+    numWrites(0),
+    numCalls(0)
+{
+}
+
+WriteQueue IWriteQueue::create(int h)
+{
+    return std::make_shared<IWriteQueue>(h);
+}
+
+void IWriteQueue::push(std::size_t s, std::size_t c, const std::string& p, float v)
+{
+    PendingValue value;
+    value.isFloat    = true;
+    value.floatValue = v;
+    value.uintValue  = 0;
+
+    push( writeKey_t(s, p, c), value );
+}
+
+void IWriteQueue::push(std::size_t s, std::size_t c, const std::string& p, uint32_t v)
+{
+    PendingValue value;
+    value.isFloat    = false;
+    value.floatValue = 0;
+    value.uintValue  = v;
+
+    push( writeKey_t(s, p, c), value );
+}
+
+void IWriteQueue::push(const writeKey_t& key, const PendingValue& value)
+{
+    mutex.lock();
+    // The last write to a channel replaces any previous pending write
+    pending[key] = value;
+    ++numWrites;
+    mutex.unlock();
+
+    event.signal();
+}
+
+std::size_t IWriteQueue::drop(std::size_t s)
+{
+    std::size_t dropped(0);
+
+    mutex.lock();
+    for (std::map<writeKey_t, PendingValue>::iterator it = pending.begin(); it != pending.end(); )
+    {
+        if ( std::get<0>(it->first) == s )
+        {
+            pending.erase(it++);
+            ++dropped;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    mutex.unlock();
+
+    return dropped;
+}
+
+void IWriteQueue::wait()
+{
+    event.wait();
+}
+
+void IWriteQueue::flush(std::vector<writeKey_t>& failed)
+{
+    // Take all the pending writes, so that new writes can be queued while these are sent
+    std::map<writeKey_t, PendingValue> writes;
+    mutex.lock();
+    writes.swap(pending);
+    mutex.unlock();
+
+    // Group the channels by board, parameter, and value. Float values are compared by
+    // their bit pattern, so that only identical values are sent together.
+    std::map< groupKey_t, std::vector<uint16_t> > groups;
+    for (std::map<writeKey_t, PendingValue>::const_iterator it = writes.begin(); it != writes.end(); ++it)
+    {
+        uint32_t bits(it->second.uintValue);
+        if ( it->second.isFloat )
+            memcpy(&bits, &it->second.floatValue, sizeof(bits));
+
+        groupKey_t key( std::get<0>(it->first), std::get<1>(it->first), it->second.isFloat, bits );
+        groups[key].push_back( std::get<2>(it->first) );
+    }
+
+    std::string errors;
+    for (std::map< groupKey_t, std::vector<uint16_t> >::iterator it = groups.begin(); it != groups.end(); ++it)
+    {
+        std::size_t        slot( std::get<0>(it->first) );
+        const std::string& param( std::get<1>(it->first) );
+        bool               isFloat( std::get<2>(it->first) );
+        uint32_t           bits( std::get<3>(it->first) );
+        CAENHVRESULT       ret;
+
+        if ( isFloat )
+        {
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            ret = linkCall(WIRE_SET_CH_PARAM, handle, [&](int libHandle) { return CAENHV_SetChParam(libHandle, slot, param.c_str(), it->second.size(), &it->second.at(0), &value); });
+        }
+        else
+        {
+            ret = linkCall(WIRE_SET_CH_PARAM, handle, [&](int libHandle) { return CAENHV_SetChParam(libHandle, slot, param.c_str(), it->second.size(), &it->second.at(0), &bits); });
+        }
+
+        ++numCalls;
+
+        if ( ret != CAENHV_OK )
+        {
+            std::stringstream temp;
+            temp << "CAENHV_SetChParam failed on slot " << slot << ", " << param << ", " << it->second.size() \
+                 << " channels: " << linkError(handle) << ". ";
+            errors += temp.str();
+
+            for (std::vector<uint16_t>::const_iterator chIt = it->second.begin(); chIt != it->second.end(); ++chIt)
+                failed.push_back( writeKey_t(slot, param, *chIt) );
+        }
+    }
+
+    if ( ! errors.empty() )
+        throw std::runtime_error(errors);
+}
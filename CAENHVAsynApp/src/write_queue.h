@@ -0,0 +1,108 @@
+#ifndef WRITE_QUEUE_H
+#define WRITE_QUEUE_H
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : CAEN HV Asyn module
+ * ----------------------------------------------------------------------------
+ * File       : write_queue.h
+ * Author     : Jesus Vasquez, jvasquez@slac.stanford.edu
+ * Created    : 2026-10-17
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CAEN HV Power supplies Write Queue Class.
+ * It gathers pending writes to channel parameters, and sends the writes of
+ * the same value to the same parameter on several channels of a board with
+ * a single call to the crate.
+ * ----------------------------------------------------------------------------
+ * This file is part of l2MpsAsyn. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of l2MpsAsyn, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <memory>
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+#include <iostream>
+#include <epicsMutex.h>
+#include <epicsEvent.h>
+
+#include "CAENHVWrapper.h"
+#include "common.h"
+#include "crate_link.h"
+
+class IWriteQueue;
+
+typedef std::shared_ptr<IWriteQueue> WriteQueue;
+
+class IWriteQueue
+{
+public:
+    // Key used to merge the writes to the same channel (slot, parameter, channel)
+    typedef std::tuple<std::size_t, std::string, std::size_t> writeKey_t;
+
+    IWriteQueue(int h);
+    ~IWriteQueue() {};
+
+    // Factory method
+    static WriteQueue create(int h);
+
+    // Add a write to the queue. If there is already a pending write to the
+    // same parameter on the same channel, it is replaced by the new one.
+    void push(std::size_t s, std::size_t c, const std::string& p, float    v);
+    void push(std::size_t s, std::size_t c, const std::string& p, uint32_t v);
+
+    // Remove the pending writes to the channels of a slot, for example when its board is removed.
+    // It returns the number of writes removed.
+    std::size_t drop(std::size_t s);
+
+    // Wait until there are pending writes in the queue
+    void wait();
+
+    // Send all the pending writes. Writes of the same value to the same parameter
+    // on the same board are sent with a single call. All the writes are attempted,
+    // and an exception is thrown at the end if any of them failed, after adding
+    // the keys of the failed writes to 'failed'.
+    void flush(std::vector<writeKey_t>& failed);
+
+    // Number of writes received, and of calls made to the crate, since the queue was created
+    std::size_t getNumWrites() const { return numWrites; };
+    std::size_t getNumCalls()  const { return numCalls;  };
+
+private:
+    // Pending write value
+    struct PendingValue
+    {
+        bool     isFloat;
+        float    floatValue;
+        uint32_t uintValue;
+    };
+
+    // Key used to group the writes of the same value on a board (slot, parameter, type, value)
+    typedef std::tuple<std::size_t, std::string, bool, uint32_t>  groupKey_t;
+
+    void push(const writeKey_t& key, const PendingValue& value);
+
+    int                                  handle;
+    std::map<writeKey_t, PendingValue>   pending;
+    epicsMutex                           mutex;
+    epicsEvent                           event;
+    std::size_t                          numWrites;
+    std::size_t                          numCalls;
+};
+
+#endif